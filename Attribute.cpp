@@ -1,6 +1,7 @@
 // Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
 #include "Attribute.h"
 #include "XMLTools.h"
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -746,6 +747,7 @@ class XMLUnserializer : private XMLParser
     virtual      ~XMLUnserializer();
 
     void         Initialize(istream &input);
+    void         InitializeFromFile(const string &filename);
   protected:
     friend class Attribute;
     friend class GenericAttribute;
@@ -769,7 +771,6 @@ class XMLUnserializer : private XMLParser
 
  protected:
     vector<XMLParseStackElement*> stack;
-    istream *tmp_istream;
 };
 
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -1041,26 +1042,26 @@ XMLUnserializer::XMLUnserializer()
 
 XMLUnserializer::XMLUnserializer(const std::string &s)
 {
-    tmp_istream = new istringstream(s);
-    Initialize(*tmp_istream);
+    XMLParser::InitializeFromString(s);
 }
 
 XMLUnserializer::XMLUnserializer(istream &is)
 {
-    tmp_istream = NULL;
     Initialize(is);
 }
 
 void XMLUnserializer::Initialize(istream &input)
 {
-    tmp_istream = NULL;
     XMLParser::Initialize(input);
 }
 
+void XMLUnserializer::InitializeFromFile(const string &filename)
+{
+    XMLParser::InitializeFromFile(filename);
+}
+
 XMLUnserializer::~XMLUnserializer()
 {
-    if (tmp_istream)
-        delete tmp_istream;
 }
 
 void XMLUnserializer::ParseErroringIfWrongType(Attribute *att)
@@ -1674,6 +1675,709 @@ void XMLUnserializer::endElement(const string &)
     // Actually, nothing to do here
 }
 
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// BinarySerializer.h
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+//
+// The binary format is a header (the magic bytes, then an int32 version),
+// followed by the top-level attribute.  An attribute is its type name and
+// number of fields, then for each field its name, type name, length, and
+// the int64 size of its data so unknown fields can be skipped.  Numbers
+// are little-endian; numeric arrays and vectors are written as one block.
+// Strings are an int32 length and the characters.  User primitives are
+// written as one string per primitive field, using their XML methods.
+// Unserializing into a GenericAttribute isn't supported.
+//
+static const char   binaryMagic[8] = {'E','L','A','T','T','R','\0','\0'};
+static const int32  binaryVersion  = 1;
+
+class BinarySerializer
+{
+  public:
+    BinarySerializer();
+    ~BinarySerializer();
+
+    void WriteHeader();
+    void Write(Attribute *att);
+    const string &GetBuffer() { return buf; }
+
+  private:
+    void WriteContents(Attribute *att);
+    void WriteNULLObject();
+    void AddBytes(const void *p, size_t n);
+    template <class T> void AddValues(const T *p, int n);
+    template <class T> void AddVector(const vector<T> *v);
+    void AddBools(const bool *p, int n);
+    void AddBoolVector(const vector<bool> *v);
+    void AddStrings(const string *p, int n);
+    void AddStringVector(const vector<string> *v);
+    void AddPrimitive(Primitive *p);
+
+    string buf;
+};
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// BinarySerializer.cpp
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+static bool HostIsLittleEndian()
+{
+    int32 one = 1;
+    return *((byte*)&one) == 1;
+}
+
+static void SwapBytes(char *p, size_t size, int n)
+{
+    for (int j=0; j<n; j++, p+=size)
+        std::reverse(p, p+size);
+}
+
+BinarySerializer::BinarySerializer()
+{
+}
+
+BinarySerializer::~BinarySerializer()
+{
+}
+
+void BinarySerializer::AddBytes(const void *p, size_t n)
+{
+    buf.append((const char*)p, n);
+}
+
+template <class T>
+void BinarySerializer::AddValues(const T *p, int n)
+{
+    if (n <= 0)
+        return;
+    size_t start = buf.size();
+    AddBytes(p, n*sizeof(T));
+    if (!HostIsLittleEndian())
+        SwapBytes(&buf[start], sizeof(T), n);
+}
+
+template <class T>
+void BinarySerializer::AddVector(const vector<T> *v)
+{
+    if (!v->empty())
+        AddValues(&((*v)[0]), v->size());
+}
+
+void BinarySerializer::AddBools(const bool *p, int n)
+{
+    for (int j=0; j<n; j++)
+    {
+        byte b = p[j] ? 1 : 0;
+        AddBytes(&b, 1);
+    }
+}
+
+void BinarySerializer::AddBoolVector(const vector<bool> *v)
+{
+    for (size_t j=0; j<v->size(); j++)
+    {
+        byte b = (*v)[j] ? 1 : 0;
+        AddBytes(&b, 1);
+    }
+}
+
+void BinarySerializer::AddStrings(const string *p, int n)
+{
+    for (int j=0; j<n; j++)
+    {
+        int32 len = p[j].length();
+        AddValues(&len, 1);
+        AddBytes(p[j].data(), len);
+    }
+}
+
+void BinarySerializer::AddStringVector(const vector<string> *v)
+{
+    if (!v->empty())
+        AddStrings(&((*v)[0]), v->size());
+}
+
+void BinarySerializer::AddPrimitive(Primitive *p)
+{
+    int nf = p->NumFields();
+    for (int k=0; k<nf; k++)
+    {
+        ostringstream ostr;
+        p->XMLSerialize(ostr, k);
+        string s = ostr.str();
+        AddStrings(&s, 1);
+    }
+}
+
+void BinarySerializer::WriteHeader()
+{
+    AddBytes(binaryMagic, sizeof(binaryMagic));
+    AddValues(&binaryVersion, 1);
+}
+
+void BinarySerializer::WriteNULLObject()
+{
+    string type = "NULL";
+    int32 nfields = 0;
+    AddStrings(&type, 1);
+    AddValues(&nfields, 1);
+}
+
+void BinarySerializer::Write(Attribute *att)
+{
+    if (!att)
+    {
+        WriteNULLObject();
+        return;
+    }
+    att->EnsureIndexCreated();
+    string type = att->GetType();
+    int32 nfields = att->classIndex->nfields;
+    AddStrings(&type, 1);
+    AddValues(&nfields, 1);
+    WriteContents(att);
+}
+
+void BinarySerializer::WriteContents(Attribute *att)
+{
+    const vector<void*> &pointers = att->pointers;
+    AttributeIndex *ci = att->classIndex;
+    unsigned int nfields = ci->nfields;
+    const vector<BasicType> &types   = ci->types;
+    const vector<SpecificType> &subtypes   = ci->subtypes;
+    const vector<string>    &names   = ci->names;
+
+    for (unsigned int i=0; i<nfields; i++)
+    {
+        int32 length = att->GetFieldLength(i);
+        if (length == -1)
+        {
+            throw Exception("BinarySerialize: found length "
+                            "of -1 for item '%s::%s'; probably a "
+                            "vector that didn't get caught.",
+                            att->GetType(), names[i].c_str());
+        }
+
+        string type = TypeToString(types[i],subtypes[i]);
+        AddStrings(&names[i], 1);
+        AddStrings(&type, 1);
+        AddValues(&length, 1);
+
+        // the size isn't known until the data is written
+        int64 size = 0;
+        size_t sizepos = buf.size();
+        AddValues(&size, 1);
+        size_t start = buf.size();
+
+        void *p = pointers[i];
+        switch (types[i])
+        {
+          case TypeBool:         AddBools((bool*)p, 1);                      break;
+          case TypeBoolArray:    AddBools((bool*)p, length);                 break;
+          case TypeBoolVector:   AddBoolVector((vector<bool>*)p);            break;
+          case TypeByte:         AddValues((byte*)p, 1);                     break;
+          case TypeByteArray:    AddValues((byte*)p, length);                break;
+          case TypeByteVector:   AddVector((vector<byte>*)p);                break;
+          case TypeInt32:        AddValues((int32*)p, 1);                    break;
+          case TypeInt32Array:   AddValues((int32*)p, length);               break;
+          case TypeInt32Vector:  AddVector((vector<int32>*)p);               break;
+          case TypeInt64:        AddValues((int64*)p, 1);                    break;
+          case TypeInt64Array:   AddValues((int64*)p, length);               break;
+          case TypeInt64Vector:  AddVector((vector<int64>*)p);               break;
+          case TypeFloat:        AddValues((float*)p, 1);                    break;
+          case TypeFloatArray:   AddValues((float*)p, length);               break;
+          case TypeFloatVector:  AddVector((vector<float>*)p);               break;
+          case TypeDouble:       AddValues((double*)p, 1);                   break;
+          case TypeDoubleArray:  AddValues((double*)p, length);              break;
+          case TypeDoubleVector: AddVector((vector<double>*)p);              break;
+          case TypeString:       AddStrings((string*)p, 1);                  break;
+          case TypeStringArray:  AddStrings((string*)p, length);             break;
+          case TypeStringVector: AddStringVector((vector<string>*)p);        break;
+
+          case TypeAttributeObj:
+            Write((Attribute*)p);
+            break;
+
+          case TypeAttributePtr:
+          case TypeDynamicPtr:
+            Write(*((Attribute**)p));
+            break;
+
+          case TypeAttributeObjArray:
+          case TypeAttributePtrArray:
+          case TypeDynamicPtrArray:
+            {
+                AttributeArrayBase *a = (AttributeArrayBase*)p;
+                for (int j=0; j<length; j++)
+                    Write(a->GetAttributeAtIndex(j));
+            }
+            break;
+
+          case TypeAttributeObjVector:
+          case TypeAttributePtrVector:
+          case TypeDynamicPtrVector:
+            {
+                AttributeVectorBase *v = (AttributeVectorBase*)p;
+                for (int j=0; j<length; j++)
+                    Write(v->GetAttributeAtIndex(j));
+            }
+            break;
+
+          case TypePrimitive:
+            AddPrimitive((Primitive*)p);
+            break;
+
+          case TypePrimitiveArray:
+            {
+                PrimitiveArrayBase *a = (PrimitiveArrayBase*)p;
+                for (int j=0; j<length; j++)
+                    AddPrimitive(a->GetPrimitiveAtIndex(j));
+            }
+            break;
+
+          case TypePrimitiveVector:
+            {
+                PrimitiveVectorBase *v = (PrimitiveVectorBase*)p;
+                for (int j=0; j<length; j++)
+                    AddPrimitive(v->GetPrimitiveAtIndex(j));
+            }
+            break;
+
+          case TypeUnknown:
+            throw Exception("unknown field type case in BinarySerializer::WriteContents()");
+
+          case TypeUnset:
+            throw Exception("unset field type in BinarySerializer::WriteContents()");
+        }
+
+        size = buf.size() - start;
+        memcpy(&buf[sizepos], &size, sizeof(size));
+        if (!HostIsLittleEndian())
+            SwapBytes(&buf[sizepos], sizeof(size), 1);
+    }
+}
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// BinaryUnserializer.h
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+class BinaryUnserializer
+{
+  public:
+    BinaryUnserializer(const char *data, size_t size);
+    ~BinaryUnserializer();
+
+    void        ReadHeader();
+    void        ReadErroringIfWrongType(Attribute *att);
+
+  private:
+    string      ReadSkippingIfWrongType(Attribute *att);
+    Attribute  *ReadCreatingNeededType();
+    void        ReadContents(Attribute *att);
+    void        SkipContents();
+    void        ReadField(Attribute *att, int index, int length);
+    void        ReadPrimitive(Primitive *p);
+
+    void        Need(size_t n);
+    void        GetBytes(void *p, size_t n);
+    template <class T> void GetValues(T *p, int n);
+    template <class T> void GetVector(vector<T> *v, int n);
+    void        GetBools(bool *p, int n);
+    void        GetBoolVector(vector<bool> *v, int n);
+    void        GetStrings(string *p, int n);
+    void        GetStringVector(vector<string> *v, int n);
+    int32       GetInt32();
+    int64       GetInt64();
+    string      GetString();
+
+    const char *pos;
+    const char *end;
+};
+
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+// BinaryUnserializer.cpp
+// ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
+BinaryUnserializer::BinaryUnserializer(const char *data, size_t size)
+    : pos(data), end(data+size)
+{
+}
+
+BinaryUnserializer::~BinaryUnserializer()
+{
+}
+
+void BinaryUnserializer::Need(size_t n)
+{
+    if (size_t(end - pos) < n)
+        throw Exception("BinaryUnserialize: unexpected end of data");
+}
+
+void BinaryUnserializer::GetBytes(void *p, size_t n)
+{
+    Need(n);
+    memcpy(p, pos, n);
+    pos += n;
+}
+
+template <class T>
+void BinaryUnserializer::GetValues(T *p, int n)
+{
+    if (n <= 0)
+        return;
+    GetBytes(p, n*sizeof(T));
+    if (!HostIsLittleEndian())
+        SwapBytes((char*)p, sizeof(T), n);
+}
+
+template <class T>
+void BinaryUnserializer::GetVector(vector<T> *v, int n)
+{
+    Need(n*sizeof(T));
+    v->resize(n);
+    if (n > 0)
+        GetValues(&((*v)[0]), n);
+}
+
+void BinaryUnserializer::GetBools(bool *p, int n)
+{
+    Need(n);
+    for (int j=0; j<n; j++)
+        p[j] = (*pos++ != 0);
+}
+
+void BinaryUnserializer::GetBoolVector(vector<bool> *v, int n)
+{
+    Need(n);
+    v->resize(n);
+    for (int j=0; j<n; j++)
+        (*v)[j] = (*pos++ != 0);
+}
+
+void BinaryUnserializer::GetStrings(string *p, int n)
+{
+    for (int j=0; j<n; j++)
+    {
+        int32 len = GetInt32();
+        if (len < 0)
+            throw Exception("BinaryUnserialize: bad string length");
+        Need(len);
+        p[j].assign(pos, len);
+        pos += len;
+    }
+}
+
+void BinaryUnserializer::GetStringVector(vector<string> *v, int n)
+{
+    Need(n*sizeof(int32));
+    v->resize(n);
+    if (n > 0)
+        GetStrings(&((*v)[0]), n);
+}
+
+int32 BinaryUnserializer::GetInt32()
+{
+    int32 v;
+    GetValues(&v, 1);
+    return v;
+}
+
+int64 BinaryUnserializer::GetInt64()
+{
+    int64 v;
+    GetValues(&v, 1);
+    return v;
+}
+
+string BinaryUnserializer::GetString()
+{
+    string s;
+    GetStrings(&s, 1);
+    return s;
+}
+
+void BinaryUnserializer::ReadHeader()
+{
+    char magic[sizeof(binaryMagic)];
+    GetBytes(magic, sizeof(magic));
+    if (memcmp(magic, binaryMagic, sizeof(magic)) != 0)
+        throw Exception("BinaryUnserialize: not a binary attribute");
+    int32 version = GetInt32();
+    if (version > binaryVersion)
+        throw Exception("BinaryUnserialize: version %d is newer than "
+                        "the supported version %d", version, binaryVersion);
+}
+
+void BinaryUnserializer::ReadErroringIfWrongType(Attribute *att)
+{
+    string type = GetString();
+    if (type != att->GetType())
+    {
+        throw Exception("BinaryUnserialize: given type '%s' "
+                        "incompatible with current type '%s'",
+                        type.c_str(), att->GetType());
+    }
+    ReadContents(att);
+}
+
+string BinaryUnserializer::ReadSkippingIfWrongType(Attribute *att)
+{
+    string type = GetString();
+    att->EnsureIndexCreated();
+    if (type == att->GetType())
+        ReadContents(att);
+    else
+        SkipContents();
+    return type;
+}
+
+Attribute *BinaryUnserializer::ReadCreatingNeededType()
+{
+    string type = GetString();
+    if (type == "NULL")
+    {
+        SkipContents();
+        return NULL;
+    }
+    Attribute *att = Attribute::CreateAttribute(type);
+    att->EnsureIndexCreated();
+    try
+    {
+        ReadContents(att);
+    }
+    catch (...)
+    {
+        delete att;
+        throw;
+    }
+    return att;
+}
+
+void BinaryUnserializer::SkipContents()
+{
+    int32 nfields = GetInt32();
+    for (int i=0; i<nfields; i++)
+    {
+        GetString(); // name
+        GetString(); // type
+        GetInt32();  // length
+        int64 size = GetInt64();
+        if (size < 0)
+            throw Exception("BinaryUnserialize: bad field size");
+        Need(size);
+        pos += size;
+    }
+}
+
+void BinaryUnserializer::ReadContents(Attribute *att)
+{
+    AttributeIndex *ci = att->classIndex;
+    int32 nfields = GetInt32();
+    for (int i=0; i<nfields; i++)
+    {
+        string name   = GetString();
+        BasicType type = StringToBasicType(GetString());
+        int32 length  = GetInt32();
+        int64 size    = GetInt64();
+        if (size < 0 || length < 0)
+            throw Exception("BinaryUnserialize: bad size for field %s",
+                            name.c_str());
+        Need(size);
+        const char *fieldEnd = pos + size;
+
+        // like the XML version, skip fields which don't exist
+        // or don't match in type or (fixed) length
+        bool skip = true;
+        int index = -1;
+        if (ci->fieldmap.count(name))
+        {
+            index = ci->fieldmap[name];
+            skip = (ci->types[index] != type ||
+                    (ci->lengths[index] != -1 &&
+                     ci->lengths[index] != length));
+        }
+
+        if (skip)
+        {
+            pos = fieldEnd;
+            continue;
+        }
+
+        ReadField(att, index, length);
+        if (pos != fieldEnd)
+            throw Exception("BinaryUnserialize: field %s had the wrong size",
+                            name.c_str());
+    }
+}
+
+void BinaryUnserializer::ReadPrimitive(Primitive *p)
+{
+    int nf = p->NumFields();
+    for (int k=0; k<nf; k++)
+        p->XMLUnserialize(GetString(), k);
+}
+
+void BinaryUnserializer::ReadField(Attribute *att, int index, int length)
+{
+    AttributeIndex *ci = att->classIndex;
+    void *p = att->pointers[index];
+    switch (ci->types[index])
+    {
+      case TypeBool:         GetBools((bool*)p, 1);                             break;
+      case TypeBoolArray:    GetBools((bool*)p, length);                        break;
+      case TypeBoolVector:   GetBoolVector((vector<bool>*)p, length);           break;
+      case TypeByte:         GetValues((byte*)p, 1);                            break;
+      case TypeByteArray:    GetValues((byte*)p, length);                       break;
+      case TypeByteVector:   GetVector((vector<byte>*)p, length);               break;
+      case TypeInt32:        GetValues((int32*)p, 1);                           break;
+      case TypeInt32Array:   GetValues((int32*)p, length);                      break;
+      case TypeInt32Vector:  GetVector((vector<int32>*)p, length);              break;
+      case TypeInt64:        GetValues((int64*)p, 1);                           break;
+      case TypeInt64Array:   GetValues((int64*)p, length);                      break;
+      case TypeInt64Vector:  GetVector((vector<int64>*)p, length);              break;
+      case TypeFloat:        GetValues((float*)p, 1);                           break;
+      case TypeFloatArray:   GetValues((float*)p, length);                      break;
+      case TypeFloatVector:  GetVector((vector<float>*)p, length);              break;
+      case TypeDouble:       GetValues((double*)p, 1);                          break;
+      case TypeDoubleArray:  GetValues((double*)p, length);                     break;
+      case TypeDoubleVector: GetVector((vector<double>*)p, length);             break;
+      case TypeString:       GetStrings((string*)p, 1);                         break;
+      case TypeStringArray:  GetStrings((string*)p, length);                    break;
+      case TypeStringVector: GetStringVector((vector<string>*)p, length);       break;
+
+      case TypeAttributeObj:
+        ReadSkippingIfWrongType((Attribute*)p);
+        break;
+
+      case TypeAttributeObjArray:
+        {
+            AttributeArrayBase *a = (AttributeArrayBase*)p;
+            for (int j=0; j<length; j++)
+                ReadSkippingIfWrongType(a->GetAttributeAtIndex(j));
+        }
+        break;
+
+      case TypeAttributeObjVector:
+        {
+            AttributeVectorBase *v = (AttributeVectorBase*)p;
+            v->SetLength(length);
+            bool hadError = false;
+            for (int j=0; j<length; j++)
+            {
+                Attribute *a = v->GetAttributeAtIndex(j);
+                if (ReadSkippingIfWrongType(a) != a->GetType())
+                    hadError = true;
+            }
+            if (hadError)
+                v->SetLength(0);
+        }
+        break;
+
+      case TypeAttributePtr:
+        {
+            Attribute **ptr = (Attribute**)p;
+            delete *ptr;
+            *ptr = NULL;
+            Attribute *a = Attribute::CreateAttribute(ci->subtypes[index]);
+            if (ReadSkippingIfWrongType(a) == "NULL")
+            {
+                delete a;
+                a = NULL;
+            }
+            *ptr = a;
+        }
+        break;
+
+      case TypeAttributePtrArray:
+        {
+            AttributeArrayBase *arr = (AttributeArrayBase*)p;
+            arr->EraseAll(length);
+            for (int j=0; j<length; j++)
+                arr->SetAttributeAtIndex(j, NULL);
+            for (int j=0; j<length; j++)
+            {
+                Attribute *a = Attribute::CreateAttribute(ci->subtypes[index]);
+                if (ReadSkippingIfWrongType(a) == "NULL")
+                {
+                    delete a;
+                    a = NULL;
+                }
+                arr->SetAttributeAtIndex(j, a);
+            }
+        }
+        break;
+
+      case TypeAttributePtrVector:
+        {
+            AttributeVectorBase *v = (AttributeVectorBase*)p;
+            v->EraseAll();
+            v->SetLength(length);
+            for (int j=0; j<length; j++)
+            {
+                Attribute *a = Attribute::CreateAttribute(ci->subtypes[index]);
+                if (ReadSkippingIfWrongType(a) == "NULL")
+                {
+                    delete a;
+                    a = NULL;
+                }
+                v->SetAttributeAtIndex(j, a);
+            }
+        }
+        break;
+
+      case TypeDynamicPtr:
+        {
+            Attribute **ptr = (Attribute**)p;
+            delete *ptr;
+            *ptr = NULL;
+            *ptr = ReadCreatingNeededType();
+        }
+        break;
+
+      case TypeDynamicPtrArray:
+        {
+            AttributeArrayBase *arr = (AttributeArrayBase*)p;
+            arr->EraseAll(length);
+            for (int j=0; j<length; j++)
+                arr->SetAttributeAtIndex(j, NULL);
+            for (int j=0; j<length; j++)
+                arr->SetAttributeAtIndex(j, ReadCreatingNeededType());
+        }
+        break;
+
+      case TypeDynamicPtrVector:
+        {
+            AttributeVectorBase *v = (AttributeVectorBase*)p;
+            v->EraseAll();
+            v->SetLength(length);
+            for (int j=0; j<length; j++)
+                v->SetAttributeAtIndex(j, ReadCreatingNeededType());
+        }
+        break;
+
+      case TypePrimitive:
+        ReadPrimitive((Primitive*)p);
+        break;
+
+      case TypePrimitiveArray:
+        {
+            PrimitiveArrayBase *a = (PrimitiveArrayBase*)p;
+            for (int j=0; j<length; j++)
+                ReadPrimitive(a->GetPrimitiveAtIndex(j));
+        }
+        break;
+
+      case TypePrimitiveVector:
+        {
+            PrimitiveVectorBase *v = (PrimitiveVectorBase*)p;
+            v->SetLength(length);
+            for (int j=0; j<length; j++)
+                ReadPrimitive(v->GetPrimitiveAtIndex(j));
+        }
+        break;
+
+      default:
+        throw Exception("Logic Error");
+    }
+}
+
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
 // Attribute
 // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
@@ -1761,9 +2465,46 @@ void Attribute::XMLUnserialize(istream &in)
 
 void Attribute::XMLUnserialize(const string &s)
 {
-    istringstream istr;
-    istr.str(s);
-    XMLUnserialize(istr);
+    XMLUnserializer reader(s);
+    XMLUnserialize(&reader);
+}
+
+void Attribute::XMLUnserializeFromFile(const string &filename)
+{
+    XMLUnserializer reader;
+    reader.InitializeFromFile(filename);
+    XMLUnserialize(&reader);
+}
+
+void Attribute::BinarySerialize(ostream &out)
+{
+    BinarySerializer writer;
+    writer.WriteHeader();
+    writer.Write(this);
+    out.write(writer.GetBuffer().data(), writer.GetBuffer().size());
+}
+
+string Attribute::BinarySerialize()
+{
+    BinarySerializer writer;
+    writer.WriteHeader();
+    writer.Write(this);
+    return writer.GetBuffer();
+}
+
+void Attribute::BinaryUnserialize(istream &in)
+{
+    ostringstream ostr;
+    ostr << in.rdbuf();
+    BinaryUnserialize(ostr.str());
+}
+
+void Attribute::BinaryUnserialize(const string &s)
+{
+    EnsureIndexCreated();
+    BinaryUnserializer reader(s.data(), s.size());
+    reader.ReadHeader();
+    reader.ReadErroringIfWrongType(this);
 }
 
 XMLUnserializer *Attribute::CreateXMLUnserializer(const string &s)
@@ -2678,6 +3419,90 @@ Primitive *Attribute::GetFieldAsPrimitive(int i, int si)
 
 // ----------------------------------------------------------------------------
 
+// 64-bit FNV-1a
+static const uint64 hashSeed = 14695981039346656037ULL;
+
+static uint64 HashBytes(uint64 h, const void *p, size_t n)
+{
+    const unsigned char *b = (const unsigned char*)p;
+    for (size_t i=0; i<n; i++)
+    {
+        h ^= b[i];
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+static uint64 HashString(uint64 h, const string &s)
+{
+    // include the length so "ab","c" differs from "a","bc"
+    int64 n = s.length();
+    h = HashBytes(h, &n, sizeof(n));
+    return HashBytes(h, s.c_str(), s.length());
+}
+
+uint64 Attribute::ComputeHash()
+{
+    EnsureIndexCreated();
+    uint64 h = HashString(hashSeed, GetType());
+    int n = GetNumFields();
+    for (int i=0; i<n; i++)
+    {
+        int len = GetFieldLength(i);
+        int64 len64 = len;
+        h = HashBytes(h, &len64, sizeof(len64));
+        for (int si=0; si<len; si++)
+        {
+            switch (GetFieldTypeCategory(i))
+            {
+              case CategoryBoolean:
+              case CategoryIntegral:
+                {
+                    int64 v = GetFieldAsLong(i,si);
+                    h = HashBytes(h, &v, sizeof(v));
+                }
+                break;
+              case CategoryReal:
+                {
+                    // hash the bits; a float field goes through double
+                    // unchanged so this is still exact
+                    double v = GetFieldAsDouble(i,si);
+                    if (v == 0.)
+                        v = 0.; // -0 == +0
+                    h = HashBytes(h, &v, sizeof(v));
+                }
+                break;
+              case CategoryString:
+                h = HashString(h, GetFieldAsString(i,si));
+                break;
+              case CategoryAttribute:
+                {
+                    Attribute *a = GetFieldAsAttribute(i,si);
+                    uint64 sub = a ? a->ComputeHash() : 0;
+                    h = HashBytes(h, &sub, sizeof(sub));
+                }
+                break;
+              case CategoryPrimitive:
+                {
+                    // primitives don't expose their values other
+                    // than through serialization
+                    Primitive *p = GetFieldAsPrimitive(i,si);
+                    for (int f=0; f<p->NumFields(); f++)
+                    {
+                        ostringstream out;
+                        p->XMLSerialize(out, f);
+                        h = HashString(h, out.str());
+                    }
+                }
+                break;
+            }
+        }
+    }
+    return h;
+}
+
+// ----------------------------------------------------------------------------
+
 void Attribute::CopyFrom(Attribute &a)
 {
     EnsureIndexCreated();
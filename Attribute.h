@@ -12,6 +12,8 @@ class PrimitiveArrayBase;
 class PrimitiveVectorBase;
 class XMLUnserializer;
 class XMLSerializer;
+class BinaryUnserializer;
+class BinarySerializer;
 
 // ****************************************************************************
 // ----------------------------------------------------------------------------
@@ -21,6 +23,7 @@ class XMLSerializer;
 typedef unsigned char  byte;
 typedef int            int32;
 typedef long long      int64;
+typedef unsigned long long uint64;
 
 
 enum BasicType
@@ -130,14 +133,26 @@ class Attribute
     virtual void XMLUnserialize(XMLUnserializer *reader);
     void         XMLUnserialize(istream &in);
     void         XMLUnserialize(const string &s);
+    void         XMLUnserializeFromFile(const string &filename);
 
     // to unserialize more than one in a row, you need a persisitent
     // unserializer; these two static functions accomplish that
     static XMLUnserializer *CreateXMLUnserializer(const string &s);
     static void             FreeXMLUnserializer(XMLUnserializer *reader);
 
+    // a compact binary form; much smaller and faster than XML for
+    // attributes with large numeric arrays (see Attribute.cpp)
+    void         BinarySerialize(ostream &out);
+    string       BinarySerialize();
+    void         BinaryUnserialize(istream &in);
+    void         BinaryUnserialize(const string &s);
+
     void CopyFrom(Attribute&);
 
+    // a hash of the type and field values, stable across runs, so
+    // attributes with equal contents have equal hashes
+    uint64       ComputeHash();
+
     // static methods for creating/copying/analyzing attributes by typename
     static Attribute *CreateAttribute(const string &);
     static Attribute *CreateAttribute(SpecificType);
@@ -190,6 +205,8 @@ class Attribute
   private:
     friend class XMLUnserializer;
     friend class XMLSerializer;
+    friend class BinaryUnserializer;
+    friend class BinarySerializer;
 
     void AddField(const string &n,void *v,int l,BasicType t,SpecificType st=0);
     Attribute(const Attribute&);
@@ -0,0 +1,242 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Batch.h"
+
+#include <QApplication>
+#include <QGLPixelBuffer>
+#include <QImage>
+
+#include <eavlException.h>
+#include <eavlVTKExporter.h>
+#include <eavl3DWindow.h>
+#include <eavlScene.h>
+
+#include "Pipeline.h"
+#include "PipelineAttributes.h"
+#include "Plot.h"
+
+static void
+PrintBatchUsage()
+{
+    cerr << "Usage: eavlab -batch <pipeline.xml> [options]\n"
+         << "Options:\n"
+         << "  -output <prefix>   write the results to <prefix>.vtk, or to\n"
+         << "                     <prefix>_<chunk>.vtk if there are several chunks\n"
+         << "  -trace <file>      write the timings as a Chrome trace (JSON)\n"
+         << "  -threads <n>       execute at most n chunks at once\n"
+         << "  -image <file>      render the results offscreen to an image\n"
+         << "  -field <name>      color the image by this field\n"
+         << "  -cellset <name>    draw this cell set in the image\n"
+         << "  -size <w> <h>      image size (default 1024 768)\n";
+}
+
+// ****************************************************************************
+// Function:  WriteResults
+//
+// Purpose:
+///   Write the final result of each chunk of a pipeline as VTK.
+//
+// Arguments:
+//   pipe       the (executed) pipeline
+//   prefix     the file name, without the chunk number or extension
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+WriteResults(Pipeline *pipe, const string &prefix)
+{
+    int nchunks = pipe->GetNumChunks();
+    for (int c=0; c<nchunks; c++)
+    {
+        ostringstream fn;
+        fn << prefix;
+        if (nchunks > 1)
+            fn << "_" << c;
+        fn << ".vtk";
+
+        ofstream out(fn.str().c_str());
+        if (!out)
+            throw Exception("Couldn't write %s", fn.str().c_str());
+
+        // operations like ExternalFace add their output as the last
+        // cell set, so that's the interesting one
+        eavlDataSet *ds = pipe->GetResult(c);
+        int cellset = std::max(ds->GetNumCellSets()-1, 0);
+        eavlVTKExporter exporter(ds, cellset);
+        exporter.Export(out);
+        cout << "Wrote " << fn.str() << endl;
+    }
+}
+
+// ****************************************************************************
+// Function:  RenderImage
+//
+// Purpose:
+///   Render the results of a pipeline into an offscreen buffer, the
+///   same way a 3D window would, and save it as an image.  Qt still
+///   needs a display for this on X11; on compute nodes a virtual one
+///   such as Xvfb will do.
+//
+// Arguments:
+//   argc,argv  the command line, for QApplication
+//   pipe       the (executed) pipeline
+//   cellset    the cell set to draw
+//   field      the field to color by, or "" for a single color
+//   w,h        image size
+//   filename   the image file; the format comes from the extension
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+RenderImage(int &argc, char *argv[], Pipeline *pipe,
+            const string &cellset, const string &field,
+            int w, int h, const string &filename)
+{
+    QApplication app(argc, argv);
+    if (!QGLPixelBuffer::hasOpenGLPbuffers())
+        throw Exception("Offscreen rendering isn't supported here");
+
+    QGLPixelBuffer pbuffer(QSize(w, h));
+    pbuffer.makeCurrent();
+
+    eavl3DGLScene *scene = new eavl3DGLScene();
+    eavl3DWindow *window = new eavl3DWindow(eavlColor(0.15, 0.0, 0.25),
+                                            NULL, scene);
+    window->Resize(w, h);
+
+    Plot plot;
+    plot.pipe = pipe;
+    plot.cellset = cellset;
+    plot.field = field;
+    plot.CreateRenderer();
+    if (!plot.valid || plot.renderers.empty())
+        throw Exception("Couldn't create a plot of the results");
+    scene->plots.insert(scene->plots.end(),
+                        plot.renderers.begin(), plot.renderers.end());
+
+    scene->ResetView(window);
+    window->Paint();
+
+    if (!pbuffer.toImage().save(filename.c_str()))
+        throw Exception("Couldn't write %s", filename.c_str());
+    cout << "Wrote " << filename << endl;
+
+    scene->plots.clear();
+    plot.DeleteRenderers();
+}
+
+// ****************************************************************************
+// Function:  RunBatch
+//
+// Purpose:
+///   Headless mode; see Batch.h.
+//
+// Arguments:
+//   argc,argv  the command line; argv[1] is "-batch"
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+int
+RunBatch(int &argc, char *argv[])
+{
+    string pipelineFile = "";
+    string outputPrefix = "";
+    string traceFile = "";
+    string imageFile = "";
+    string cellset = "";
+    string field = "";
+    int width = 1024, height = 768;
+    for (int i=2; i<argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-output" && i+1 < argc)
+            outputPrefix = argv[++i];
+        else if (arg == "-trace" && i+1 < argc)
+            traceFile = argv[++i];
+        else if (arg == "-threads" && i+1 < argc)
+            Pipeline::maxChunkThreads = atoi(argv[++i]);
+        else if (arg == "-image" && i+1 < argc)
+            imageFile = argv[++i];
+        else if (arg == "-cellset" && i+1 < argc)
+            cellset = argv[++i];
+        else if (arg == "-field" && i+1 < argc)
+            field = argv[++i];
+        else if (arg == "-size" && i+2 < argc)
+        {
+            width = atoi(argv[++i]);
+            height = atoi(argv[++i]);
+        }
+        else if (pipelineFile == "" && arg[0] != '-')
+            pipelineFile = arg;
+        else
+        {
+            PrintBatchUsage();
+            return 1;
+        }
+    }
+    if (pipelineFile == "" || width <= 0 || height <= 0)
+    {
+        PrintBatchUsage();
+        return 1;
+    }
+
+    try
+    {
+        PipelineAttributes atts;
+        atts.XMLUnserializeFromFile(pipelineFile);
+
+        Pipeline *pipe = new Pipeline;
+        Pipeline::allPipelines.push_back(pipe);
+        pipe->SetFromAttributes(&atts);
+        if (imageFile != "")
+            pipe->RequestVariable(field);
+        pipe->Execute();
+
+        cout << "Executed " << pipe->GetName() << " ("
+             << pipe->GetNumChunks() << " chunks)" << endl;
+        cout << "stage            wall(s)   cpu(s)     cells    points   mem(MB)" << endl;
+        for (size_t s=0; s<pipe->results.size(); s++)
+        {
+            StageProfile prof = pipe->GetStageProfile(s);
+            string name = (s == 0) ? pipe->source->GetSourceType()
+                                   : pipe->ops[s-1]->GetOperationName();
+            char line[256];
+            sprintf(line, "%-15.15s %8.3f %8.3f %9lld %9lld %9.1f\n",
+                    name.c_str(), prof.wallTime, prof.cpuTime,
+                    prof.outCells, prof.outPoints,
+                    prof.bytes / (1024.*1024.));
+            cout << line;
+        }
+
+        if (traceFile != "")
+        {
+            ofstream out(traceFile.c_str());
+            if (!out)
+                throw Exception("Couldn't write %s", traceFile.c_str());
+            Pipeline::WriteChromeTrace(out);
+        }
+
+        if (outputPrefix != "")
+            WriteResults(pipe, outputPrefix);
+
+        if (imageFile != "")
+            RenderImage(argc, argv, pipe, cellset, field,
+                        width, height, imageFile);
+    }
+    catch (const Exception &e)
+    {
+        cerr << "Error: " << e.message << endl;
+        return 1;
+    }
+    catch (const eavlException &e)
+    {
+        cerr << "Error: " << e.GetErrorText() << endl;
+        return 1;
+    }
+    return 0;
+}
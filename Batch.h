@@ -0,0 +1,25 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef BATCH_H
+#define BATCH_H
+
+// ****************************************************************************
+// Function:  RunBatch
+//
+// Purpose:
+///   Headless mode: read a pipeline description (a PipelineAttributes
+///   in XML, e.g. from File -> Save Pipeline), execute it, and write
+///   the results, timings, and optionally an offscreen image.
+///   Run "eavlab -batch" for the options.
+//
+// Arguments:
+//   argc,argv  the command line; argv[1] is "-batch"
+//
+// Returns:  the process exit code
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+int RunBatch(int &argc, char *argv[]);
+
+#endif
@@ -0,0 +1,160 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef OP_CALCULATOR_H
+#define OP_CALCULATOR_H
+
+#include "Operation.h"
+
+#include "ExpressionProgram.h"
+
+// ****************************************************************************
+// Class:  CalculatorAttributes
+//
+// Purpose:
+///   Attributes for the calculator operation: an expression over fields
+///   (see ExpressionProgram for the syntax), and the name of the new
+///   field it makes.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class CalculatorAttributes : public Attribute
+{
+  public:
+    string expression;
+    string output;
+  public:
+    virtual const char *GetType() {return "CalculatorAttributes";}
+    static Attribute *Create() { return new CalculatorAttributes; }
+    CalculatorAttributes() : Attribute()
+    {
+        expression = "";
+        output = "result";
+    }
+    virtual ~CalculatorAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("expression", expression);
+        Add("output", output);
+    }
+};
+
+// ****************************************************************************
+// Class:  CalculatorOperation
+//
+// Purpose:
+///   Operation that adds a scalar field computed from an expression
+///   over other fields, e.g. "mag(velocity)" or "p / p0 * 1e-5".  The
+///   fields must all be nodal, or all on the same cell set, and the
+///   new field is the same.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class CalculatorOperation : public Operation
+{
+    CalculatorAttributes *atts;
+  public:
+    CalculatorOperation()
+        : Operation()
+    {
+        atts = new CalculatorAttributes;
+    }
+    virtual ~CalculatorOperation()
+    {
+        delete atts;
+    }
+    virtual std::string GetOperationName()
+    {
+        return "Calculator";
+    }
+    virtual std::string GetOperationShortName()
+    {
+        return "calc";
+    }
+    virtual std::string GetOperationInfo()
+    {
+        return atts->output + "=" + atts->expression;
+    }
+    virtual Attribute *GetSettings()
+    {
+        return atts;
+    }
+    virtual std::vector<std::string> GetNeededVariables()
+    {
+        ExpressionProgram program;
+        try
+        {
+            program.Compile(atts->expression);
+        }
+        catch (const eavlException &)
+        {
+            // Execute will report it
+            return std::vector<std::string>();
+        }
+        return program.GetVariables();
+    }
+    virtual std::vector<std::string> GetOutputVariables()
+    {
+        std::vector<std::string> vars;
+        vars.push_back(atts->output);
+        return vars;
+    }
+    virtual void Execute()
+    {
+        if (input->GetFieldIndex(atts->output) >= 0)
+            throw eavlException("Calculator: there is already a field "
+                                "named " + atts->output);
+
+        ExpressionProgram program;
+        program.Compile(atts->expression);
+        const std::vector<std::string> &names = program.GetVariables();
+        if (names.empty())
+            throw eavlException("Calculator: the expression must use "
+                                "at least one field");
+
+        std::vector<eavlArray*> arrays;
+        eavlField *first = NULL;
+        for (size_t i=0; i<names.size(); i++)
+        {
+            eavlField *f = input->GetField(names[i]);
+            if (!first)
+                first = f;
+            else if (f->GetAssociation() != first->GetAssociation() ||
+                     f->GetAssocCellSet() != first->GetAssocCellSet() ||
+                     f->GetArray()->GetNumberOfTuples() !=
+                     first->GetArray()->GetNumberOfTuples())
+                throw eavlException("Calculator: " + names[i] + " and " +
+                                    names[0] + " aren't on the same points "
+                                    "or cells");
+            arrays.push_back(f->GetArray());
+        }
+
+        int n = first->GetArray()->GetNumberOfTuples();
+        eavlFloatArray *result = new eavlFloatArray(atts->output, 1, n);
+        program.Execute(arrays, n, result->GetHostArray());
+        switch (first->GetAssociation())
+        {
+          case eavlField::ASSOC_CELL_SET:
+            input->AddField(new eavlField(first->GetOrder(), result,
+                                          eavlField::ASSOC_CELL_SET,
+                                          first->GetAssocCellSet()));
+            break;
+          case eavlField::ASSOC_LOGICALDIM:
+            input->AddField(new eavlField(first->GetOrder(), result,
+                                          eavlField::ASSOC_LOGICALDIM,
+                                          first->GetAssocLogicalDim()));
+            break;
+          default:
+            input->AddField(new eavlField(first->GetOrder(), result,
+                                          first->GetAssociation()));
+            break;
+        }
+        output = input;
+    }
+};
+
+#endif
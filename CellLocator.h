@@ -0,0 +1,365 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef CELL_LOCATOR_H
+#define CELL_LOCATOR_H
+
+#include "STL.h"
+#include <algorithm>
+#include <cmath>
+#include <eavlCellSet.h>
+#include <eavlCellSetAllStructured.h>
+#include <eavlCoordinates.h>
+#include <eavlDataSet.h>
+#include <eavlLogicalStructureRegular.h>
+#include "MultiLevelContour.h"
+
+// ****************************************************************************
+// Class:  CellLocator
+//
+// Purpose:
+///   Finds the cell of a 3D cell set containing a point, and the nodes
+///   and weights to interpolate a nodal field there.  Create() picks
+///   the fastest kind for a data set.  Once built, a locator is only
+///   read, so any number of threads can use it at once; each passes
+///   its own hint (the last cell found, or -1), which is tried first.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class CellLocator
+{
+  public:
+    enum { MaxNodes = 8 };
+
+    virtual ~CellLocator()
+    {
+    }
+
+    /// If p is inside the mesh, get up to MaxNodes nodes and their
+    /// weights for interpolating at p, and return how many; else 0.
+    virtual int Locate(const double *p, int &hint,
+                       int *nodes, double *weights) = 0;
+
+    void GetBounds(double *lo, double *hi)
+    {
+        for (int d=0; d<3; d++)
+        {
+            lo[d] = bmin[d];
+            hi[d] = bmax[d];
+        }
+    }
+
+    static CellLocator *Create(eavlDataSet *ds, eavlCellSet *cs);
+
+  protected:
+    double bmin[3], bmax[3];
+};
+
+// ****************************************************************************
+// Class:  RectilinearCellLocator
+//
+// Purpose:
+///   Locator for a 3D rectilinear grid: a binary search along each
+///   axis, and trilinear weights.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class RectilinearCellLocator : public CellLocator
+{
+    std::vector<double> axes[3];
+    int                 stride[3];
+  public:
+    /// Returns NULL unless ds is a 3D rectilinear grid whose axes
+    /// increase.
+    static RectilinearCellLocator *Create(eavlDataSet *ds, eavlCellSet *cs)
+    {
+        eavlLogicalStructureRegular *log =
+            dynamic_cast<eavlLogicalStructureRegular*>(ds->GetLogicalStructure());
+        if (!log || !dynamic_cast<eavlCellSetAllStructured*>(cs) ||
+            ds->GetNumCoordinateSystems() < 1)
+            return NULL;
+        eavlRegularStructure reg = log->GetRegularStructure();
+        eavlCoordinatesCartesian *coords =
+            dynamic_cast<eavlCoordinatesCartesian*>(ds->GetCoordinateSystem(0));
+        if (reg.dimension != 3 || !coords || coords->GetDimension() != 3)
+            return NULL;
+
+        RectilinearCellLocator *loc = new RectilinearCellLocator;
+        loc->stride[0] = 1;
+        loc->stride[1] = reg.nodeDims[0];
+        loc->stride[2] = reg.nodeDims[0] * reg.nodeDims[1];
+        for (int d=0; d<3; d++)
+        {
+            eavlCoordinateAxisField *af =
+                dynamic_cast<eavlCoordinateAxisField*>(coords->GetAxis(d));
+            if (!af || ds->GetFieldIndex(af->GetFieldName()) < 0)
+            {
+                delete loc;
+                return NULL;
+            }
+            eavlField *f = ds->GetField(af->GetFieldName());
+            if (f->GetAssociation() != eavlField::ASSOC_LOGICALDIM ||
+                f->GetAssocLogicalDim() != d)
+            {
+                delete loc;
+                return NULL;
+            }
+            int n = reg.nodeDims[d];
+            for (int i=0; i<n; i++)
+            {
+                loc->axes[d].push_back(f->GetArray()->GetComponentAsDouble(
+                                                   i, af->GetComponent()));
+                if (i > 0 && loc->axes[d][i] <= loc->axes[d][i-1])
+                {
+                    delete loc;
+                    return NULL;
+                }
+            }
+            loc->bmin[d] = loc->axes[d].front();
+            loc->bmax[d] = loc->axes[d].back();
+        }
+        return loc;
+    }
+
+    virtual int Locate(const double *p, int &, int *nodes, double *weights)
+    {
+        int idx[3];
+        double t[3];
+        for (int d=0; d<3; d++)
+        {
+            const std::vector<double> &a = axes[d];
+            if (!(p[d] >= a.front() && p[d] <= a.back()) || a.size() < 2)
+                return 0;
+            int i = std::upper_bound(a.begin(), a.end(), p[d]) - a.begin() - 1;
+            i = std::min(i, (int)a.size() - 2);
+            idx[d] = i;
+            t[d] = (p[d] - a[i]) / (a[i+1] - a[i]);
+        }
+        int base = idx[0]*stride[0] + idx[1]*stride[1] + idx[2]*stride[2];
+        for (int c=0; c<8; c++)
+        {
+            int di = c & 1, dj = (c >> 1) & 1, dk = (c >> 2) & 1;
+            nodes[c] = base + di*stride[0] + dj*stride[1] + dk*stride[2];
+            weights[c] = (di ? t[0] : 1-t[0]) *
+                         (dj ? t[1] : 1-t[1]) *
+                         (dk ? t[2] : 1-t[2]);
+        }
+        return 8;
+    }
+};
+
+// ****************************************************************************
+// Class:  BinnedCellLocator
+//
+// Purpose:
+///   Locator for any 3D cell set: a uniform grid of bins over the
+///   bounds, about one per cell, each listing the cells whose bounding
+///   boxes overlap it.  A point is tested against the cells of its bin
+///   by splitting them into tetrahedra, whose barycentric coordinates
+///   are the weights.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class BinnedCellLocator : public CellLocator
+{
+    eavlDataSet      *ds;
+    eavlCellSet      *cs;
+    int               nbins[3];
+    double            binsize[3];
+    std::vector<int>  binStart;    ///< into binCells, per bin, plus the end
+    std::vector<int>  binCells;
+  public:
+    BinnedCellLocator(eavlDataSet *data, eavlCellSet *cells)
+        : ds(data), cs(cells)
+    {
+        int ncells = cs->GetNumCells();
+        std::vector<double> boxes(ncells*6);
+        for (int d=0; d<3; d++)
+        {
+            bmin[d] = +HUGE_VAL;
+            bmax[d] = -HUGE_VAL;
+        }
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cs->GetCellNodes(c);
+            double *box = &boxes[c*6];
+            for (int d=0; d<3; d++)
+            {
+                box[d] = +HUGE_VAL;
+                box[3+d] = -HUGE_VAL;
+            }
+            for (int j=0; j<cell.numIndices; j++)
+            {
+                for (int d=0; d<3; d++)
+                {
+                    double x = ds->GetPoint(cell.indices[j], d);
+                    box[d] = std::min(box[d], x);
+                    box[3+d] = std::max(box[3+d], x);
+                }
+            }
+            for (int d=0; d<3; d++)
+            {
+                bmin[d] = std::min(bmin[d], box[d]);
+                bmax[d] = std::max(bmax[d], box[3+d]);
+            }
+        }
+
+        // about one bin per cell, as close to cubes as we can
+        double extent[3], volume = 1;
+        for (int d=0; d<3; d++)
+        {
+            extent[d] = std::max(bmax[d] - bmin[d], 1e-30);
+            volume *= extent[d];
+        }
+        double side = pow(volume / std::max(ncells, 1), 1./3.);
+        int totalbins = 1;
+        for (int d=0; d<3; d++)
+        {
+            nbins[d] = std::max(1, std::min(1024, (int)(extent[d] / side)));
+            binsize[d] = extent[d] / nbins[d];
+            totalbins *= nbins[d];
+        }
+
+        // count, then fill, the cells of each bin
+        binStart.assign(totalbins+1, 0);
+        for (int pass=0; pass<2; pass++)
+        {
+            std::vector<int> fill;
+            if (pass == 1)
+            {
+                for (int b=0; b<totalbins; b++)
+                    binStart[b+1] += binStart[b];
+                binCells.resize(binStart[totalbins]);
+                fill.assign(binStart.begin(), binStart.end()-1);
+            }
+            for (int c=0; c<ncells; c++)
+            {
+                int lo[3], hi[3];
+                for (int d=0; d<3; d++)
+                {
+                    lo[d] = Bin(boxes[c*6+d], d);
+                    hi[d] = Bin(boxes[c*6+3+d], d);
+                }
+                for (int k=lo[2]; k<=hi[2]; k++)
+                {
+                    for (int j=lo[1]; j<=hi[1]; j++)
+                    {
+                        for (int i=lo[0]; i<=hi[0]; i++)
+                        {
+                            int b = (k*nbins[1] + j)*nbins[0] + i;
+                            if (pass == 0)
+                                binStart[b+1]++;
+                            else
+                                binCells[fill[b]++] = c;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    virtual int Locate(const double *p, int &hint, int *nodes, double *weights)
+    {
+        for (int d=0; d<3; d++)
+        {
+            if (!(p[d] >= bmin[d] && p[d] <= bmax[d]))
+                return 0;
+        }
+        if (hint >= 0)
+        {
+            int n = TestCell(hint, p, nodes, weights);
+            if (n)
+                return n;
+        }
+        int b = (Bin(p[2],2)*nbins[1] + Bin(p[1],1))*nbins[0] + Bin(p[0],0);
+        for (int i=binStart[b]; i<binStart[b+1]; i++)
+        {
+            int c = binCells[i];
+            if (c == hint)
+                continue;
+            int n = TestCell(c, p, nodes, weights);
+            if (n)
+            {
+                hint = c;
+                return n;
+            }
+        }
+        return 0;
+    }
+
+  protected:
+    int Bin(double x, int d)
+    {
+        int b = (int)((x - bmin[d]) / binsize[d]);
+        return std::max(0, std::min(nbins[d]-1, b));
+    }
+
+    /// If p is in the cell, get the nodes of the tetrahedron holding
+    /// it and its barycentric coordinates.
+    int TestCell(int c, const double *p, int *nodes, double *weights)
+    {
+        eavlCell cell = cs->GetCellNodes(c);
+        int tets[12][4], nverts;
+        int ntets = MultiLevelContour::DecomposeCell(cell, tets, nverts);
+        if (nverts != 4)
+            return 0;
+        const double eps = 1e-9;
+        for (int t=0; t<ntets; t++)
+        {
+            double x[4][3];
+            for (int k=0; k<4; k++)
+                for (int d=0; d<3; d++)
+                    x[k][d] = ds->GetPoint(cell.indices[tets[t][k]], d);
+
+            // solve p - x0 = a*(x1-x0) + b*(x2-x0) + c*(x3-x0)
+            double m[3][3], r[3];
+            for (int d=0; d<3; d++)
+            {
+                m[d][0] = x[1][d] - x[0][d];
+                m[d][1] = x[2][d] - x[0][d];
+                m[d][2] = x[3][d] - x[0][d];
+                r[d] = p[d] - x[0][d];
+            }
+            double det = m[0][0]*(m[1][1]*m[2][2] - m[1][2]*m[2][1]) -
+                         m[0][1]*(m[1][0]*m[2][2] - m[1][2]*m[2][0]) +
+                         m[0][2]*(m[1][0]*m[2][1] - m[1][1]*m[2][0]);
+            if (det == 0)
+                continue;
+            double a = (r[0]*(m[1][1]*m[2][2] - m[1][2]*m[2][1]) -
+                        m[0][1]*(r[1]*m[2][2] - m[1][2]*r[2]) +
+                        m[0][2]*(r[1]*m[2][1] - m[1][1]*r[2])) / det;
+            double b = (m[0][0]*(r[1]*m[2][2] - m[1][2]*r[2]) -
+                        r[0]*(m[1][0]*m[2][2] - m[1][2]*m[2][0]) +
+                        m[0][2]*(m[1][0]*r[2] - r[1]*m[2][0])) / det;
+            double g = (m[0][0]*(m[1][1]*r[2] - r[1]*m[2][1]) -
+                        m[0][1]*(m[1][0]*r[2] - r[1]*m[2][0]) +
+                        r[0]*(m[1][0]*m[2][1] - m[1][1]*m[2][0])) / det;
+            double w0 = 1 - a - b - g;
+            if (a < -eps || b < -eps || g < -eps || w0 < -eps)
+                continue;
+            weights[0] = w0;
+            weights[1] = a;
+            weights[2] = b;
+            weights[3] = g;
+            for (int k=0; k<4; k++)
+                nodes[k] = cell.indices[tets[t][k]];
+            return 4;
+        }
+        return 0;
+    }
+};
+
+inline CellLocator *
+CellLocator::Create(eavlDataSet *ds, eavlCellSet *cs)
+{
+    CellLocator *loc = RectilinearCellLocator::Create(ds, cs);
+    if (loc)
+        return loc;
+    return new BinnedCellLocator(ds, cs);
+}
+
+#endif
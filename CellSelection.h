@@ -0,0 +1,187 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef CELL_SELECTION_H
+#define CELL_SELECTION_H
+
+#include "STL.h"
+#include <algorithm>
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <eavlCellSet.h>
+#include <eavlField.h>
+#include <eavlFloatArray.h>
+
+// ****************************************************************************
+// Class:  CellSelection
+//
+// Purpose:
+///   Finds the cells of a cell set whose scalar field lies within a
+///   range, as a list of their indices in increasing order.  For a
+///   cell field the cell's own value is tested; for a nodal field,
+///   all of the cell's nodes must be in range.
+///
+///   The selection is a parallel compaction: threads from the global
+///   pool take turns grabbing blocks of cells, flagging the selected
+///   ones and counting them per block; a prefix sum of the counts
+///   gives each block its place in the output; then the blocks are
+///   grabbed again and each one writes its indices there.  As with
+///   HistogramEngine, the calling thread works too.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class CellSelection
+{
+  protected:
+    enum { BlockSize = 16384 };
+    enum Pass { Flag, Scatter };
+
+    class Task : public QRunnable
+    {
+      public:
+        CellSelection *selection;
+        Pass           pass;
+        QSemaphore    *done;
+        virtual void run()
+        {
+            selection->Work(pass);
+            done->release();
+        }
+    };
+
+    eavlCellSet       *cellset;
+    eavlArray         *array;
+    const float       *host;   ///< non-NULL for float arrays
+    bool               nodal;
+    double             lo, hi;
+    int                ncells;
+    int                nblocks;
+    int                nthreads;
+    QAtomicInt         nextBlock;
+    std::vector<char>  flags;
+    std::vector<int>   offsets;
+    std::vector<int>   selected;
+
+  public:
+    CellSelection(eavlCellSet *cs, eavlField *f, double minval, double maxval)
+        : cellset(cs), array(f->GetArray()), host(NULL),
+          nodal(f->GetAssociation() == eavlField::ASSOC_POINTS),
+          lo(minval), hi(maxval)
+    {
+        eavlFloatArray *fa = dynamic_cast<eavlFloatArray*>(array);
+        if (fa)
+            host = fa->GetHostArray();
+    }
+
+    /// Select the cells, using up to maxThreads threads (0 for as
+    /// many as there are cores).
+    void Execute(int maxThreads = 0)
+    {
+        ncells = cellset->GetNumCells();
+        nblocks = (ncells + BlockSize - 1) / BlockSize;
+        nthreads = QThread::idealThreadCount();
+        if (maxThreads > 0)
+            nthreads = std::min(nthreads, maxThreads);
+        nthreads = std::max(1, std::min(nthreads, nblocks/4));
+
+        // get any lazily built connectivity ready before threading
+        if (ncells > 0)
+            cellset->GetCellNodes(0);
+
+        flags.assign(ncells, 0);
+        offsets.assign(nblocks+1, 0);
+        RunPass(Flag);
+
+        for (int b=0; b<nblocks; b++)
+            offsets[b+1] += offsets[b];
+        selected.resize(offsets[nblocks]);
+        if (!selected.empty())
+            RunPass(Scatter);
+        flags.clear();
+    }
+
+    std::vector<int> &GetSelected() { return selected; }
+
+  protected:
+    void RunPass(Pass pass)
+    {
+        nextBlock = 0;
+        QSemaphore done;
+        int started = 0;
+        for (int t=1; t<nthreads; t++)
+        {
+            Task *task = new Task;
+            task->selection = this;
+            task->pass = pass;
+            task->done = &done;
+            if (!QThreadPool::globalInstance()->tryStart(task))
+            {
+                delete task;
+                break;
+            }
+            started++;
+        }
+        Work(pass);
+        done.acquire(started);
+    }
+
+    bool InRange(double v)
+    {
+        return v >= lo && v <= hi;
+    }
+
+    double Value(int i)
+    {
+        return host ? host[i] : array->GetComponentAsDouble(i, 0);
+    }
+
+    void Work(Pass pass)
+    {
+        while (true)
+        {
+            int block = nextBlock.fetchAndAddOrdered(1);
+            if (block >= nblocks)
+                break;
+            int start = block * BlockSize;
+            int end = std::min(ncells, start + BlockSize);
+
+            if (pass == Flag)
+            {
+                int count = 0;
+                for (int c=start; c<end; c++)
+                {
+                    bool in;
+                    if (nodal)
+                    {
+                        eavlCell cell = cellset->GetCellNodes(c);
+                        in = cell.numIndices > 0;
+                        for (int j=0; j<cell.numIndices && in; j++)
+                            in = InRange(Value(cell.indices[j]));
+                    }
+                    else
+                    {
+                        in = InRange(Value(c));
+                    }
+                    flags[c] = in;
+                    count += in;
+                }
+                // offsets[0] stays 0 for the prefix sum
+                offsets[block+1] = count;
+            }
+            else
+            {
+                int *out = selected.empty() ? NULL : &selected[offsets[block]];
+                for (int c=start; c<end; c++)
+                {
+                    if (flags[c])
+                        *out++ = c;
+                }
+            }
+        }
+    }
+};
+
+#endif
@@ -28,6 +28,8 @@ struct DSInfo
     vector<FieldInfo> nodalfields;
     vector<CellSetInfo> cellsets;
     map<string, vector<FieldInfo> > cellsetfields;
+    /// fields the source has but which haven't been read yet
+    vector<string> unloadedfields;
 
     void Print(std::ostream &out)
     {
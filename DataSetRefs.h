@@ -0,0 +1,243 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef DATA_SET_REFS_H
+#define DATA_SET_REFS_H
+
+#include "STL.h"
+#include <algorithm>
+#include <QMutex>
+#include <QMutexLocker>
+#include "eavlDataSet.h"
+
+// ****************************************************************************
+// Class:  DataSetRefs
+//
+// Purpose:
+///   Reference counts for the data sets the pipelines make, so they
+///   are deleted once nothing (a pipeline's results, the result
+///   cache, a plot) holds them any more.
+///
+///   An EAVL data set doesn't own its parts; a shallow copy shares
+///   all of them, and each stage of a pipeline shares most of its
+///   fields, arrays, cell sets and coordinates with the one before.
+///   So the parts are counted too: a data set holds a reference to
+///   each part it had when it was retained (or updated), a field
+///   holds one to its array, and each is deleted along with the last
+///   thing that held it.  Parts nothing ever retained are left alone.
+///
+///   Like the importer pool, this assumes importers and EAVL filters
+///   hand over whatever they return, so they won't touch it again.
+///
+///   The forget callback is called for each array about to be
+///   deleted, so caches keyed by array pointers can drop it.  It's
+///   called without the mutex held, so it may release things too.
+///
+///   All methods are safe to call from the chunk threads.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class DataSetRefs
+{
+  protected:
+    struct Parts
+    {
+        int                           refs;
+        std::vector<eavlField*>       fields;
+        std::vector<eavlCellSet*>     cellsets;
+        std::vector<eavlCoordinates*> coords;
+        eavlLogicalStructure         *log;
+    };
+    /// what the last references were just released to, to be deleted
+    /// once the mutex is unlocked
+    struct Garbage
+    {
+        std::vector<eavlDataSet*>          datasets;
+        std::vector<eavlField*>            fields;
+        std::vector<eavlArray*>            arrays;
+        std::vector<eavlCellSet*>          cellsets;
+        std::vector<eavlCoordinates*>      coords;
+        std::vector<eavlLogicalStructure*> logs;
+    };
+    std::map<eavlDataSet*, Parts>         datasets;
+    std::map<eavlField*, int>             fields;
+    std::map<eavlArray*, int>             arrays;
+    std::map<eavlCellSet*, int>           cellsets;
+    std::map<eavlCoordinates*, int>       coords;
+    std::map<eavlLogicalStructure*, int>  logs;
+    void                                (*forget)(eavlArray*);
+    QMutex                                mutex;
+
+  public:
+    DataSetRefs(void (*forgetArray)(eavlArray*) = NULL)
+        : forget(forgetArray)
+    {
+    }
+
+    void Retain(eavlDataSet *ds)
+    {
+        QMutexLocker lock(&mutex);
+        RetainDataSet(ds);
+    }
+
+    void Release(eavlDataSet *ds)
+    {
+        Garbage g;
+        {
+            QMutexLocker lock(&mutex);
+            ReleaseDataSet(ds, g);
+        }
+        Delete(g);
+    }
+
+    /// Have a retained data set hold on to the parts added to it since
+    /// (e.g. by a mutator).  Does nothing if it isn't retained.
+    void Update(eavlDataSet *ds)
+    {
+        QMutexLocker lock(&mutex);
+        std::map<eavlDataSet*, Parts>::iterator it = datasets.find(ds);
+        if (it != datasets.end())
+            AddParts(ds, it->second);
+    }
+
+    /// For holding on to a single field (and its array).
+    void Retain(eavlField *f)
+    {
+        QMutexLocker lock(&mutex);
+        RetainField(f);
+    }
+
+    void Release(eavlField *f)
+    {
+        Garbage g;
+        {
+            QMutexLocker lock(&mutex);
+            ReleaseField(f, g);
+        }
+        Delete(g);
+    }
+
+    int GetNumDataSets() { QMutexLocker lock(&mutex); return datasets.size(); }
+    int GetNumArrays()   { QMutexLocker lock(&mutex); return arrays.size(); }
+
+  protected:
+    template <class T>
+    static void Ref(std::map<T*,int> &counts, T *p)
+    {
+        if (p)
+            counts[p]++;
+    }
+
+    template <class T>
+    static void Ref(std::map<T*,int> &counts, std::vector<T*> &held, T *p)
+    {
+        if (std::find(held.begin(), held.end(), p) != held.end())
+            return;
+        held.push_back(p);
+        Ref(counts, p);
+    }
+
+    template <class T>
+    static void Unref(std::map<T*,int> &counts, T *p, std::vector<T*> &dead)
+    {
+        typename std::map<T*,int>::iterator it = counts.find(p);
+        if (it == counts.end())
+            return;
+        if (--it->second > 0)
+            return;
+        counts.erase(it);
+        dead.push_back(p);
+    }
+
+    // these assume the mutex is already locked
+    void RetainField(eavlField *f)
+    {
+        if (++fields[f] == 1)
+            Ref(arrays, f->GetArray());
+    }
+
+    void ReleaseField(eavlField *f, Garbage &g)
+    {
+        size_t n = g.fields.size();
+        Unref(fields, f, g.fields);
+        if (g.fields.size() > n)
+            Unref(arrays, f->GetArray(), g.arrays);
+    }
+
+    void RetainDataSet(eavlDataSet *ds)
+    {
+        std::map<eavlDataSet*, Parts>::iterator it = datasets.find(ds);
+        if (it != datasets.end())
+        {
+            it->second.refs++;
+            AddParts(ds, it->second);
+            return;
+        }
+
+        Parts &p = datasets[ds];
+        p.refs = 1;
+        p.log = ds->GetLogicalStructure();
+        Ref(logs, p.log);
+        AddParts(ds, p);
+    }
+
+    /// Hold on to the parts of ds that p doesn't have yet.
+    void AddParts(eavlDataSet *ds, Parts &p)
+    {
+        for (int i=0; i<ds->GetNumFields(); i++)
+        {
+            eavlField *f = ds->GetField(i);
+            if (std::find(p.fields.begin(), p.fields.end(), f) != p.fields.end())
+                continue;
+            p.fields.push_back(f);
+            RetainField(f);
+        }
+        for (int i=0; i<ds->GetNumCellSets(); i++)
+            Ref(cellsets, p.cellsets, ds->GetCellSet(i));
+        for (int i=0; i<ds->GetNumCoordinateSystems(); i++)
+            Ref(coords, p.coords, ds->GetCoordinateSystem(i));
+    }
+
+    void ReleaseDataSet(eavlDataSet *ds, Garbage &g)
+    {
+        std::map<eavlDataSet*, Parts>::iterator it = datasets.find(ds);
+        if (it == datasets.end() || --it->second.refs > 0)
+            return;
+
+        Parts &p = it->second;
+        for (size_t i=0; i<p.fields.size(); i++)
+            ReleaseField(p.fields[i], g);
+        for (size_t i=0; i<p.cellsets.size(); i++)
+            Unref(cellsets, p.cellsets[i], g.cellsets);
+        for (size_t i=0; i<p.coords.size(); i++)
+            Unref(coords, p.coords[i], g.coords);
+        if (p.log)
+            Unref(logs, p.log, g.logs);
+        datasets.erase(it);
+        g.datasets.push_back(ds);
+    }
+
+    // this must be called without the mutex locked
+    void Delete(Garbage &g)
+    {
+        if (forget)
+        {
+            for (size_t i=0; i<g.arrays.size(); i++)
+                forget(g.arrays[i]);
+        }
+        for (size_t i=0; i<g.datasets.size(); i++)
+            delete g.datasets[i];
+        for (size_t i=0; i<g.fields.size(); i++)
+            delete g.fields[i];
+        for (size_t i=0; i<g.coords.size(); i++)
+            delete g.coords[i];
+        for (size_t i=0; i<g.cellsets.size(); i++)
+            delete g.cellsets[i];
+        for (size_t i=0; i<g.logs.size(); i++)
+            delete g.logs[i];
+        for (size_t i=0; i<g.arrays.size(); i++)
+            delete g.arrays[i];
+    }
+};
+
+#endif
@@ -0,0 +1,146 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef OP_DECIMATE_H
+#define OP_DECIMATE_H
+
+#include "Operation.h"
+
+#include "VertexClustering.h"
+
+// ****************************************************************************
+// Class:  DecimateAttributes
+//
+// Purpose:
+///   Attributes for the decimate operation: the surface cell set ("" for
+///   the first one), either a grid resolution (cubes along the longest
+///   side of the bounds) or, if that's 0, a rough target number of
+///   triangles to pick it from, and how many levels of detail to make.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class DecimateAttributes : public Attribute
+{
+  public:
+    string cellset;
+    int    targetTriangles;
+    int    resolution;     ///< if >0, used instead of targetTriangles
+    int    nlevels;
+  public:
+    virtual const char *GetType() {return "DecimateAttributes";}
+    static Attribute *Create() { return new DecimateAttributes; }
+    DecimateAttributes() : Attribute()
+    {
+        cellset = "";
+        targetTriangles = 1000000;
+        resolution = 0;
+        nlevels = 1;
+    }
+    virtual ~DecimateAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("cellset", cellset);
+        Add("targetTriangles", targetTriangles);
+        Add("resolution", resolution);
+        Add("nlevels", nlevels);
+    }
+};
+
+// ****************************************************************************
+// Class:  DecimateOperation
+//
+// Purpose:
+///   Operation that simplifies a surface by vertex clustering.  The
+///   output has a cell set of triangles for each level of detail,
+///   "lod0" being the finest and each next one using clusters twice
+///   as large (so roughly a quarter of the triangles).  The 3D window
+///   draws the coarsest level while the camera is moving.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class DecimateOperation : public Operation
+{
+    DecimateAttributes *atts;
+  public:
+    DecimateOperation()
+        : Operation()
+    {
+        atts = new DecimateAttributes;
+    }
+    virtual ~DecimateOperation()
+    {
+        delete atts;
+    }
+    virtual std::string GetOperationName()
+    {
+        return "Decimate";
+    }
+    virtual std::string GetOperationShortName()
+    {
+        return "dec";
+    }
+    virtual std::string GetOperationInfo()
+    {
+        ostringstream os;
+        if (atts->resolution > 0)
+            os << atts->resolution << " cubes";
+        else
+            os << "~" << atts->targetTriangles << " tris";
+        if (atts->nlevels > 1)
+            os << ", " << atts->nlevels << " levels";
+        if (atts->cellset != "")
+            os << " on " << atts->cellset;
+        return os.str();
+    }
+    virtual Attribute *GetSettings()
+    {
+        return atts;
+    }
+    virtual void Execute()
+    {
+        eavlCellSet *cs = (atts->cellset == "") ? input->GetCellSet(0)
+                                                : input->GetCellSet(atts->cellset);
+        if (cs->GetDimensionality() != 2)
+            throw eavlException("Decimate: the cell set must be a surface");
+        if (atts->nlevels < 1 || atts->nlevels > 8)
+            throw eavlException("Decimate: use 1 to 8 levels");
+
+        double lo[3], hi[3], area = 0;
+        bool needArea = (atts->resolution <= 0);
+        VertexClustering::GetBounds(input, cs, lo, hi,
+                                    needArea ? &area : NULL);
+
+        double size;
+        if (atts->resolution > 0)
+        {
+            double extent = std::max(hi[0]-lo[0],
+                                     std::max(hi[1]-lo[1], hi[2]-lo[2]));
+            size = extent / atts->resolution;
+        }
+        else
+        {
+            // a surface crosses about 1.5 cubes per its area in cube
+            // faces, and there are about twice as many triangles as
+            // vertices
+            if (atts->targetTriangles < 1)
+                throw eavlException("Decimate: need a resolution or "
+                                    "a target triangle count");
+            size = sqrt(3. * area / atts->targetTriangles);
+        }
+        if (!(size > 0))
+        {
+            // empty or flat to a point; any size works
+            size = 1;
+        }
+
+        VertexClustering clustering(input, cs, lo, size, atts->nlevels);
+        clustering.Execute();
+        output = clustering.CreateOutput("lod");
+    }
+};
+
+#endif
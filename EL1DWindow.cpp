@@ -22,12 +22,12 @@
 // Creation:    January 17, 2013
 //
 // Modifications:
+//   The plot list and saved camera belong to ELPlotWindow now.
+//
 // ****************************************************************************
 EL1DWindow::EL1DWindow(ELWindowManager *parent)
-    : QGLWidget(parent)
+    : ELPlotWindow(parent)
 {
-    settings = NULL;
-
     mousedown = false;
     shiftKey = false;
     lastx = lasty = -1;
@@ -121,13 +121,20 @@ EL1DWindow::UpdatePlots()
     for (unsigned int i=0;  i<settings->plots.size(); i++)
     {
         Plot &p = settings->plots[i];
-        if (!p.pipe || p.pipe->results.size() == 0)
+        if (!p.pipe)
             continue;
-        p.CreateRenderer();
-        if (!p.renderer)
+        // while a pipeline is executing, keep drawing what we had
+        if (!p.pipe->IsExecuting())
+        {
+            if (!p.pipe->HasResults())
+                continue;
+            p.CreateRenderer();
+        }
+        if (p.renderers.empty())
             continue;
         shoulddraw = true;
-        scene->plots.push_back(p.renderer);
+        scene->plots.insert(scene->plots.end(),
+                            p.renderers.begin(), p.renderers.end());
     }
     return shoulddraw;
 }
@@ -153,6 +160,11 @@ EL1DWindow::ResetView()
     //cerr << "EL1DWindow::ResetView\n";
     UpdatePlots();
     scene->ResetView(window);
+    if (hasSavedView)
+    {
+        window->view.view3d = savedView.view3d;
+        window->view.view2d = savedView.view2d;
+    }
     updateGL();
 }
 
@@ -233,6 +245,7 @@ EL1DWindow::resizeGL(int w, int h)
 void
 EL1DWindow::mousePressEvent(QMouseEvent *mev)
 {
+    hasSavedView = false;
     shiftKey = (mev->modifiers() & Qt::ShiftModifier);
     makeCurrent();
 
@@ -366,3 +379,22 @@ EL1DWindow::SomethingChanged()
 {
     updateGL();
 }
+
+// ****************************************************************************
+// Method:  EL1DWindow::GetView
+//
+// Purpose:
+///   The camera of our EAVL window, for ELPlotWindow.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlView &
+EL1DWindow::GetView()
+{
+    return window->view;
+}
@@ -11,7 +11,7 @@
 #include <eavlDataSet.h>
 #include <Plot.h>
 
-#include "ELPlotList.h"
+#include "ELPlotWindow.h"
 
 class eavl1DWindow;
 class eavlScene;
@@ -28,12 +28,12 @@ class eavlRenderer;
 // Creation:    January 16, 2013
 //
 // Modifications:
+//   Moved the plot list and session saving into ELPlotWindow.
+//
 // ****************************************************************************
-class EL1DWindow : public QGLWidget
+class EL1DWindow : public ELPlotWindow
 {
     Q_OBJECT
-  protected:
-    ELPlotList *settings;
   public:
     EL1DWindow(ELWindowManager *parent);
     virtual void initializeGL();
@@ -69,6 +69,9 @@ class EL1DWindow : public QGLWidget
     eavl1DWindow *window;
     eavlScene    *scene;
 
+  protected:
+    virtual eavlView &GetView();
+
   public slots:
     void CurrentPipelineChanged(int index);
     void PipelineUpdated(Pipeline *p);
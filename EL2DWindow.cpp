@@ -21,12 +21,12 @@
 // Creation:    August 16, 2012
 //
 // Modifications:
+//   The plot list and saved camera belong to ELPlotWindow now.
+//
 // ****************************************************************************
 EL2DWindow::EL2DWindow(ELWindowManager *parent)
-    : QGLWidget(parent)
+    : ELPlotWindow(parent)
 {
-    settings = NULL;
-
     mousedown = false;
     shiftKey = false;
     lastx = lasty = -1;
@@ -119,13 +119,20 @@ EL2DWindow::UpdatePlots()
     for (unsigned int i=0;  i<settings->plots.size(); i++)
     {
         Plot &p = settings->plots[i];
-        if (!p.pipe || p.pipe->results.size() == 0)
+        if (!p.pipe)
             continue;
-        p.CreateRenderer();
-        if (!p.renderer)
+        // while a pipeline is executing, keep drawing what we had
+        if (!p.pipe->IsExecuting())
+        {
+            if (!p.pipe->HasResults())
+                continue;
+            p.CreateRenderer();
+        }
+        if (p.renderers.empty())
             continue;
         shoulddraw = true;
-        scene->plots.push_back(p.renderer);
+        scene->plots.insert(scene->plots.end(),
+                            p.renderers.begin(), p.renderers.end());
     }
     return shoulddraw;
 }
@@ -149,6 +156,11 @@ void
 EL2DWindow::ResetView()
 {
     scene->ResetView(window);
+    if (hasSavedView)
+    {
+        window->view.view3d = savedView.view3d;
+        window->view.view2d = savedView.view2d;
+    }
     updateGL();
 }
 
@@ -271,6 +283,7 @@ EL2DWindow::resizeGL(int w, int h)
 void
 EL2DWindow::mousePressEvent(QMouseEvent *mev)
 {
+    hasSavedView = false;
     shiftKey = (mev->modifiers() & Qt::ShiftModifier);
     makeCurrent();
 
@@ -404,3 +417,22 @@ EL2DWindow::SomethingChanged()
 {
     updateGL();
 }
+
+// ****************************************************************************
+// Method:  EL2DWindow::GetView
+//
+// Purpose:
+///   The camera of our EAVL window, for ELPlotWindow.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlView &
+EL2DWindow::GetView()
+{
+    return window->view;
+}
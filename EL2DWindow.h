@@ -16,7 +16,7 @@
 #include <eavlDataSet.h>
 #include <Plot.h>
 
-#include "ELPlotList.h"
+#include "ELPlotWindow.h"
 
 class eavl2DWindow;
 class eavlScene;
@@ -34,12 +34,12 @@ class eavlRenderer;
 // Creation:    January 10, 2013
 //
 // Modifications:
+//   Moved the plot list and session saving into ELPlotWindow.
+//
 // ****************************************************************************
-class EL2DWindow : public QGLWidget
+class EL2DWindow : public ELPlotWindow
 {
     Q_OBJECT
-  protected:
-    ELPlotList *settings;
   public:
     EL2DWindow(ELWindowManager *parent);
     virtual void initializeGL();
@@ -74,6 +74,9 @@ class EL2DWindow : public QGLWidget
     eavl2DWindow *window;
     eavlScene    *scene;
 
+  protected:
+    virtual eavlView &GetView();
+
   public slots:
     void CurrentPipelineChanged(int index);
     void PipelineUpdated(Pipeline *p);
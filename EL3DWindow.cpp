@@ -22,12 +22,12 @@
 // Creation:    August 16, 2012
 //
 // Modifications:
+//   The plot list and saved camera belong to ELPlotWindow now.
+//
 // ****************************************************************************
 EL3DWindow::EL3DWindow(ELWindowManager *parent)
-    : QGLWidget(parent)
+    : ELPlotWindow(parent)
 {
-    settings = NULL;
-
     mousedown = false;
     shiftKey = false;
     lastx = lasty = -1;
@@ -120,13 +120,27 @@ EL3DWindow::UpdatePlots()
     for (unsigned int i=0;  i<settings->plots.size(); i++)
     {
         Plot &p = settings->plots[i];
-        if (!p.pipe || p.pipe->results.size() == 0)
+        if (!p.pipe)
             continue;
-        p.CreateRenderer();
-        if (!p.renderer)
+        // while a pipeline is executing, keep drawing what we had
+        if (!p.pipe->IsExecuting())
+        {
+            if (!p.pipe->HasResults())
+                continue;
+            p.CreateRenderer();
+            p.CreateCoarseRenderer();
+        }
+        if (p.renderers.empty())
             continue;
         shoulddraw = true;
-        scene->plots.push_back(p.renderer);
+        // draw a coarser level of detail while the camera is moving
+        if (mousedown && !p.coarseRenderers.empty())
+            scene->plots.insert(scene->plots.end(),
+                                p.coarseRenderers.begin(),
+                                p.coarseRenderers.end());
+        else
+            scene->plots.insert(scene->plots.end(),
+                                p.renderers.begin(), p.renderers.end());
     }
     return shoulddraw;
 }
@@ -151,6 +165,11 @@ EL3DWindow::ResetView()
     //cerr << "EL3DWindow::ResetView\n";
     UpdatePlots();
     scene->ResetView(window);
+    if (hasSavedView)
+    {
+        window->view.view3d = savedView.view3d;
+        window->view.view2d = savedView.view2d;
+    }
     updateGL();
 }
 
@@ -285,6 +304,7 @@ EL3DWindow::resizeGL(int w, int h)
 void
 EL3DWindow::mousePressEvent(QMouseEvent *mev)
 {
+    hasSavedView = false;
     shiftKey = (mev->modifiers() & Qt::ShiftModifier);
     makeCurrent();
 
@@ -366,6 +386,8 @@ EL3DWindow::mouseMoveEvent(QMouseEvent *mev)
 // Creation:    August 15, 2012
 //
 // Modifications:
+//   Redraw, since plots are drawn coarser while the mouse is down.
+//
 // ****************************************************************************
 void
 EL3DWindow::mouseReleaseEvent(QMouseEvent *)
@@ -374,7 +396,8 @@ EL3DWindow::mouseReleaseEvent(QMouseEvent *)
 
     mousedown = false;
     shiftKey = false;
-    //updateGL();
+    // back to the full level of detail
+    updateGL();
 }
 
 
@@ -424,3 +447,22 @@ EL3DWindow::SomethingChanged()
 {
     updateGL();
 }
+
+// ****************************************************************************
+// Method:  EL3DWindow::GetView
+//
+// Purpose:
+///   The camera of our EAVL window, for ELPlotWindow.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlView &
+EL3DWindow::GetView()
+{
+    return window->view;
+}
@@ -11,7 +11,7 @@
 #include <eavlDataSet.h>
 #include <Plot.h>
 
-#include "ELPlotList.h"
+#include "ELPlotWindow.h"
 
 class eavl3DWindow;
 class eavlScene;
@@ -31,12 +31,12 @@ class eavl3DAxisAnnotation;
 // Creation:    August 15, 2012
 //
 // Modifications:
+//   Moved the plot list and session saving into ELPlotWindow.
+//
 // ****************************************************************************
-class EL3DWindow : public QGLWidget
+class EL3DWindow : public ELPlotWindow
 {
     Q_OBJECT
-  protected:
-    ELPlotList *settings;
   public:
     EL3DWindow(ELWindowManager *parent);
     virtual void initializeGL();
@@ -70,6 +70,9 @@ class EL3DWindow : public QGLWidget
     eavl3DWindow *window;
     eavlScene    *scene;
 
+  protected:
+    virtual eavlView &GetView();
+
   public slots:
     void CurrentPipelineChanged(int index);
     void PipelineUpdated(Pipeline *p);
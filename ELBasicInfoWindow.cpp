@@ -67,56 +67,98 @@ ELBasicInfoWindow::PipelineUpdated(Pipeline *p)
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Get the file's chunk and mesh counts from the importer pool.
+//
+//   Show the results, profile and cache for every kind of source.
+//
 // ****************************************************************************
 void
 ELBasicInfoWindow::FillFromPipeline(Pipeline *p)
 {
     info->clear();
-    if (p->source->file.empty())
-        return;
 
+    // only a file source has a header; the rest is the same for all
     Source *s = p->source;
-    if (s->sourcetype != Source::File)
-    {
-        ///\todo
-        cerr << "Only supporting file sources for now\n";
-        return;
-    }
-
-    eavlImporter *importer = s->source_file;
-    /*
-    if (!s->var.empty())
+    if (s->sourcetype == Source::File && !s->file.empty())
     {
-        info->insertHtml(("<b>Variable:</b> " + s->var + "<br>").c_str());
-        info->insertHtml(("<b>in mesh:</b> " + s->mesh + "<br>").c_str());
-        info->insertHtml(("<b>in file:</b> " + s->file + "<br>").c_str());
-        info->insertHtml("Contains "
-                         + QString::number(importer->GetNumChunks(s->mesh)) 
-                          + " chunks<br>");
+        ImporterPool &importers = Pipeline::importers;
+        /*
+        if (!s->var.empty())
+        {
+            info->insertHtml(("<b>Variable:</b> " + s->var + "<br>").c_str());
+            info->insertHtml(("<b>in mesh:</b> " + s->mesh + "<br>").c_str());
+            info->insertHtml(("<b>in file:</b> " + s->file + "<br>").c_str());
+            info->insertHtml("Contains "
+                             + QString::number(importer->GetNumChunks(s->mesh)) 
+                              + " chunks<br>");
+        }
+        else*/
+        if (!s->mesh.empty())
+        {
+            info->insertHtml(("<b>Mesh:</b> " + s->mesh + "<br>").c_str());
+            info->insertHtml(("<b>in file:</b> " + s->file + "<br>").c_str());
+            info->insertHtml("Contains "
+                             + QString::number(importers.GetNumChunks(s->file, s->mesh))
+                              + " chunks<br>");
+        }
+        else
+        {
+            info->insertHtml(("<b>File:</b> " + s->file + "<br>").c_str());
+            info->insertHtml("Contains " +
+                             QString::number(importers.GetMeshList(s->file).size()) 
+                              + " meshes<br>");
+        }
     }
-    else*/
-    if (!s->mesh.empty())
+    if (p->IsExecuting())
     {
-        info->insertHtml(("<b>Mesh:</b> " + s->mesh + "<br>").c_str());
-        info->insertHtml(("<b>in file:</b> " + s->file + "<br>").c_str());
-        info->insertHtml("Contains "
-                         + QString::number(importer->GetNumChunks(s->mesh))
-                          + " chunks<br>");
+        info->insertHtml("<br><b>Executing...</b><br>");
     }
-    else
+    else if (p->HasResults())
     {
-        info->insertHtml(("<b>File:</b> " + s->file + "<br>").c_str());
-        info->insertHtml("Contains " +
-                         QString::number(importer->GetMeshList().size()) 
-                          + " meshes<br>");
+        // printing every chunk of a huge file isn't useful
+        const int maxChunksShown = 8;
+        int nchunks = p->GetNumChunks();
+        info->insertHtml("<br><b>Execution Result Follows:</b><br>");
+        for (int c=0; c<nchunks && c<maxChunksShown; c++)
+        {
+            info->insertHtml("<br><b>Chunk " + QString::number(c) + ":</b><br>");
+            ostringstream out;
+            p->GetResult(c)->PrintSummary(out);
+            info->insertPlainText(out.str().c_str());
+        }
+        if (nchunks > maxChunksShown)
+        {
+            info->insertHtml("<br>(" + QString::number(nchunks-maxChunksShown)
+                             + " more chunks not shown)<br>");
+        }
     }
-    if (p->results.size() > 0)
+
+    if (!p->IsExecuting() && p->HasResults())
     {
-        info->insertHtml("<br><b>Execution Result Follows:</b><br><br>");
-        ostringstream out;
-        p->results.back()->PrintSummary(out);
-        info->insertPlainText(out.str().c_str());
+        info->insertHtml("<br><b>Profile:</b><br>");
+        QString table = "stage            wall(s)   cpu(s)     cells    points   mem(MB)\n";
+        for (size_t s=0; s<p->results.size(); s++)
+        {
+            StageProfile prof = p->GetStageProfile(s);
+            string name = (s == 0) ? p->source->GetSourceType()
+                                   : p->ops[s-1]->GetOperationName();
+            table += QString().sprintf("%-15s %8.3f %8.3f %9lld %9lld %9.1f%s\n",
+                                       name.c_str(), prof.wallTime, prof.cpuTime,
+                                       prof.outCells, prof.outPoints,
+                                       prof.bytes / (1024.*1024.),
+                                       prof.ncached ? " (cached)" : "");
+        }
+        info->insertPlainText(table);
     }
+
+    ResultCache &cache = Pipeline::resultCache;
+    const double MB = 1024.*1024.;
+    info->insertHtml("<br><b>Result cache:</b> "
+                     + QString::number(cache.GetNumEntries()) + " data sets, "
+                     + QString::number(cache.GetBytes()/MB, 'f', 1) + " of "
+                     + QString::number(cache.GetMaxBytes()/MB, 'f', 0) + " MB, "
+                     + QString::number(cache.GetNumHits()) + " hits, "
+                     + QString::number(cache.GetNumMisses()) + " misses<br>");
 }
 
 // ****************************************************************************
@@ -155,3 +197,61 @@ ELBasicInfoWindow::SomethingChanged()
 {
     FillFromPipeline(settings->GetPipeline());
 }
+
+// ****************************************************************************
+// Method:  ELBasicInfoWindow::SaveSession
+//
+// Purpose:
+///   Add the pipeline this window is showing to a session.
+//
+// Arguments:
+//   atts       the window's part of the session
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELBasicInfoWindow::SaveSession(WindowAttributes *atts)
+{
+    atts->pipeline = settings->GetPipelineIndex();
+}
+
+// ****************************************************************************
+// Method:  ELBasicInfoWindow::RestoreSession
+//
+// Purpose:
+///   Show the pipeline chosen in a session.
+//
+// Arguments:
+//   atts       the window's part of the session
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELBasicInfoWindow::RestoreSession(WindowAttributes *atts)
+{
+    settings->SetPipelineIndex(atts->pipeline);
+    if (settings->GetPipelineIndex() >= 0)
+        SomethingChanged();
+}
+
+// ****************************************************************************
+// Method:  ELBasicInfoWindow::ForgetPipelines
+//
+// Purpose:
+///   Clear the summary of a pipeline that's about to be deleted.  We
+///   only keep the chosen pipeline's index, so nothing else refers to
+///   it.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELBasicInfoWindow::ForgetPipelines()
+{
+    info->clear();
+}
@@ -6,6 +6,9 @@
 
 #include <QTextEdit>
 
+#include "SessionAttributes.h"
+#include "ELWindow.h"
+
 class Pipeline;
 
 class ELPipelineChooser : public QWidget
@@ -50,6 +53,16 @@ class ELPipelineChooser : public QWidget
     {
         return Pipeline::allPipelines[pipelineCombo->currentIndex()];
     }
+    int GetPipelineIndex()
+    {
+        return pipelineCombo->currentIndex();
+    }
+    void SetPipelineIndex(int index)
+    {
+        PipelineUpdated(NULL);
+        if (index >= 0 && index < pipelineCombo->count())
+            pipelineCombo->setCurrentIndex(index);
+    }
   public slots:
     void PipelineSelected(const QString &p)
     {
@@ -69,8 +82,10 @@ class ELPipelineChooser : public QWidget
 // Creation:    August  3, 2012
 //
 // Modifications:
+//   Made it an ELWindow.
+//
 // ****************************************************************************
-class ELBasicInfoWindow : public QWidget
+class ELBasicInfoWindow : public QWidget, public ELWindow
 {
     Q_OBJECT
   protected:
@@ -80,6 +95,9 @@ class ELBasicInfoWindow : public QWidget
     ELBasicInfoWindow(ELWindowManager *parent);
     void FillFromPipeline(Pipeline *p);
     QWidget *GetSettings();
+    virtual void SaveSession(WindowAttributes *atts);
+    virtual void RestoreSession(WindowAttributes *atts);
+    virtual void ForgetPipelines();
   public slots:
     void CurrentPipelineChanged(int index);
     void PipelineUpdated(Pipeline *p);
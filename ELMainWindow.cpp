@@ -5,19 +5,22 @@
 #include <QFileDialog>
 #include <QGridLayout>
 #include <QInputDialog>
+#include <QMessageBox>
 #include <QMenu>
 #include <QMenuBar>
 #include <QPushButton>
 #include <QSplitter>
 
 #include <sstream>
+#include <fstream>
 #include <cfloat>
 
-#include "eavlImporterFactory.h"
-
 #include "ELPipelineBuilder.h"
 #include "ELWindowManager.h"
 #include "ELBasicInfoWindow.h"
+#include "Pipeline.h"
+#include "PipelineAttributes.h"
+#include "SessionAttributes.h"
 
 // ****************************************************************************
 // Constructor:  ELMainWindow::ELMainWindow
@@ -26,6 +29,11 @@
 // Creation:    July 30, 2012
 //
 // Modifications:
+//   Added File -> Open Time Series, and the time slider under the
+//   workspace.
+//
+//   Windows let go of the pipelines before a session replaces them.
+//
 // ****************************************************************************
 ELMainWindow::ELMainWindow(QWidget *parent) :
     QMainWindow(parent)
@@ -36,16 +44,34 @@ ELMainWindow::ELMainWindow(QWidget *parent) :
 
     QAction *open = file->addAction(tr("Open"));
     open->setShortcut(QString(tr("Ctrl+O")));
+    QAction *openTimeSeries = file->addAction(tr("Open Time Series..."));
+    QAction *openSession = file->addAction(tr("Open Session..."));
+    QAction *saveSession = file->addAction(tr("Save Session..."));
+    QAction *savePipeline = file->addAction(tr("Save Pipeline..."));
+    QAction *exportProfile = file->addAction(tr("Export Profile..."));
     QAction *exit = file->addAction(tr("Exit"));
     exit->setShortcut(QString(tr("Ctrl+X")));
     menuBar()->addMenu(file);
 
     connect(open, SIGNAL(triggered()),
             this, SLOT(OpenFile()));
+    connect(openTimeSeries, SIGNAL(triggered()),
+            this, SLOT(OpenTimeSeries()));
+    connect(openSession, SIGNAL(triggered()),
+            this, SLOT(OpenSession()));
+    connect(saveSession, SIGNAL(triggered()),
+            this, SLOT(SaveSession()));
+    connect(savePipeline, SIGNAL(triggered()),
+            this, SLOT(SavePipeline()));
+    connect(exportProfile, SIGNAL(triggered()),
+            this, SLOT(ExportProfile()));
     connect(exit, SIGNAL(triggered()),
             this, SLOT(Exit()));
 
-    topSplitter = new QSplitter(Qt::Horizontal, this);
+    QWidget *central = new QWidget(this);
+    QGridLayout *centralLayout = new QGridLayout(central);
+    topSplitter = new QSplitter(Qt::Horizontal, central);
+    centralLayout->addWidget(topSplitter, 0,0);
 
     //
     // workspace
@@ -70,11 +96,40 @@ ELMainWindow::ELMainWindow(QWidget *parent) :
             this, SLOT(WindowAdded(QWidget*)));
     connect(windowMgr, SIGNAL(SettingsActivated(QWidget*)),
             this, SLOT(SettingsActivated(QWidget*)));
+    connect(pipelineBuilder, SIGNAL(PipelinesDeleting()),
+            windowMgr, SLOT(ForgetPipelines()));
 
     topSplitter->setStretchFactor(0,40);
     topSplitter->setStretchFactor(1,1);
     topSplitter->setStretchFactor(2,100);
-    setCentralWidget(topSplitter);
+
+    //
+    // time slider, shown when a pipeline reads a time series
+    //
+    timeControls = new QWidget(central);
+    QGridLayout *timeLayout = new QGridLayout(timeControls);
+    timeLayout->setContentsMargins(0,0,0,0);
+    timeLayout->addWidget(new QLabel("Time", timeControls), 0,0);
+    timeSlider = new QSlider(Qt::Horizontal, timeControls);
+    // only move once it's let go, since each step re-executes
+    timeSlider->setTracking(false);
+    timeSlider->setPageStep(1);
+    timeLayout->addWidget(timeSlider, 0,1);
+    timeStepLabel = new QLabel(timeControls);
+    timeLayout->addWidget(timeStepLabel, 0,2);
+    QCheckBox *prefetchOps = new QCheckBox("Prefetch pipeline results",
+                                           timeControls);
+    prefetchOps->setChecked(true);
+    timeLayout->addWidget(prefetchOps, 0,3);
+    timeLayout->setColumnStretch(1, 100);
+    centralLayout->addWidget(timeControls, 1,0);
+    connect(timeSlider, SIGNAL(valueChanged(int)),
+            this, SLOT(TimeChanged(int)));
+    connect(prefetchOps, SIGNAL(toggled(bool)),
+            this, SLOT(PrefetchToggled(bool)));
+    UpdateTimeSlider();
+
+    setCentralWidget(central);
 
     // I guess we want to start with a 3D window
     windowMgr->ChangeWindowType(0, "Polar View");
@@ -119,9 +174,37 @@ void ELMainWindow::Exit()
 // Creation:    July 30, 2012
 //
 // Modifications:
+//   The extensions are shared with File -> Open Time Series.
+//
 // ****************************************************************************
 void
 ELMainWindow::OpenFile()
+{
+    QString filename =  QFileDialog::getOpenFileName(this,
+                                                     "Select File",
+                                                     QString(),
+                                                     GetFileExtensions());
+    if (filename.isNull())
+        return;
+
+    OpenFile(filename);
+}
+
+// ****************************************************************************
+// Method:  ELMainWindow::GetFileExtensions
+//
+// Purpose:
+///   The file name filter for the file types we can read.
+//
+// Programmer:  Jeremy Meredith
+// Creation:    July 30, 2012
+//
+// Modifications:
+//   Split out of OpenFile.
+//
+// ****************************************************************************
+QString
+ELMainWindow::GetFileExtensions()
 {
     QString extensions = "*.vtk *.bov *.pdb *.png";
 #ifdef HAVE_SILO
@@ -138,14 +221,48 @@ ELMainWindow::OpenFile()
     extensions += " *.bp";
     extensions += " *.pixie";
 #endif
-    QString filename =  QFileDialog::getOpenFileName(this,
-                                                     "Select File",
-                                                     QString(),
-                                                     extensions);
-    if (filename.isNull())
+    return extensions;
+}
+
+// ****************************************************************************
+// Method:  ELMainWindow::OpenTimeSeries
+//
+// Purpose:
+///   Slot for File -> Open Time Series.  The user either picks every
+///   file of the series, or just one, in which case the series is the
+///   files named like it but with another number in place of its last
+///   one (e.g. run_0042.silo gives run_*.silo).  Either way they're
+///   ordered by the numbers in their names.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELMainWindow::OpenTimeSeries()
+{
+    QStringList filenames = QFileDialog::getOpenFileNames(this,
+                                                          "Select Time Series",
+                                                          QString(),
+                                                          GetFileExtensions());
+    if (filenames.isEmpty())
         return;
 
-    OpenFile(filename);
+    std::vector<std::string> files;
+    if (filenames.size() == 1)
+    {
+        std::string fn = filenames[0].toStdString();
+        files = Source::ExpandFilePattern(Source::GetTimeSeriesPattern(fn));
+        if (files.empty())
+            files.push_back(fn);
+    }
+    else
+    {
+        for (int i=0; i<filenames.size(); i++)
+            files.push_back(filenames[i].toStdString());
+        Source::SortTimeSteps(files);
+    }
+    pipelineBuilder->addTimeSeries(files);
 }
 
 // ****************************************************************************
@@ -158,22 +275,173 @@ ELMainWindow::OpenFile()
 // Creation:    July 30, 2012
 //
 // Modifications:
+//   Open it in the shared importer pool, which skips scanning it if
+//   its metadata is cached.
+//
+//   The sources list opens it in the background and reports errors.
+//
 // ****************************************************************************
 void
 ELMainWindow::OpenFile(const QString &filename)
 {
-    eavlImporter *importer =
-        eavlImporterFactory::GetImporterForFile(filename.toStdString());
+    pipelineBuilder->addSource(filename.toStdString());
+}
+
+
+// ****************************************************************************
+// Method:  ELMainWindow::SavePipeline
+//
+// Purpose:
+///   Slot for File -> Save Pipeline.  Save a description of the
+///   current pipeline, e.g. for running in batch mode.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELMainWindow::SavePipeline()
+{
+    int index = pipelineBuilder->currentPipeline;
+    if (index < 0 || index >= (int)Pipeline::allPipelines.size())
+        return;
+
+    QString filename = QFileDialog::getSaveFileName(this,
+                                                    "Save Pipeline",
+                                                    "pipeline.xml",
+                                                    "*.xml");
+    if (filename.isNull())
+        return;
+
+    ofstream out(filename.toStdString().c_str());
+    if (!out)
+    {
+        cerr << "Error: couldn't open " << filename.toStdString() << endl;
+        return;
+    }
+    PipelineAttributes *atts = Pipeline::allPipelines[index]->CreateAttributes();
+    atts->XMLSerialize(out);
+    delete atts;
+}
+
+// ****************************************************************************
+// Method:  ELMainWindow::SaveSession
+//
+// Purpose:
+///   Slot for File -> Save Session.  Save all the pipelines and the
+///   windows showing them, so the session can be brought back later.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELMainWindow::SaveSession()
+{
+    QString filename = QFileDialog::getSaveFileName(this,
+                                                    "Save Session",
+                                                    "session.xml",
+                                                    "*.xml");
+    if (filename.isNull())
+        return;
 
-    if (!importer)
+    ofstream out(filename.toStdString().c_str());
+    if (!out)
     {
-        cerr << "Error: unknown file extension\n";
+        cerr << "Error: couldn't open " << filename.toStdString() << endl;
         return;
     }
-    
-    pipelineBuilder->addSource(filename.toStdString(), importer);
+    SessionAttributes atts;
+    pipelineBuilder->SaveSession(&atts);
+    windowMgr->SaveSession(&atts);
+    atts.XMLSerialize(out);
+}
+
+// ****************************************************************************
+// Method:  ELMainWindow::OpenSession
+//
+// Purpose:
+///   Slot for File -> Open Session.  Replace the pipelines and windows
+///   with those in a saved session, then execute the pipelines.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Update the time slider.
+//
+// ****************************************************************************
+void
+ELMainWindow::OpenSession()
+{
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        if (Pipeline::allPipelines[i]->IsExecuting())
+        {
+            QMessageBox::warning(this, "Open Session",
+                                 "Wait for the executing pipelines to "
+                                 "finish before opening a session.");
+            return;
+        }
+    }
+
+    QString filename = QFileDialog::getOpenFileName(this,
+                                                    "Open Session",
+                                                    QString(),
+                                                    "*.xml");
+    if (filename.isNull())
+        return;
+
+    try
+    {
+        SessionAttributes atts;
+        atts.XMLUnserializeFromFile(filename.toStdString());
+
+        pipelineBuilder->RestoreSession(&atts);
+        windowMgr->RestoreSession(&atts);
+        pipelineBuilder->ExecuteAllPipelines();
+        UpdateTimeSlider();
+    }
+    catch (const Exception &e)
+    {
+        QMessageBox::critical(this, "Error opening session",
+                              e.message.c_str());
+    }
+    catch (const eavlException &e)
+    {
+        QMessageBox::critical(this, "Error opening session",
+                              e.GetErrorText().c_str());
+    }
 }
 
+// ****************************************************************************
+// Method:  ELMainWindow::ExportProfile
+//
+// Purpose:
+///   Slot for File -> Export Profile.  Save the execution profile of
+///   all pipelines as a Chrome trace (JSON) file.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELMainWindow::ExportProfile()
+{
+    QString filename = QFileDialog::getSaveFileName(this,
+                                                    "Export Profile",
+                                                    "eavlab_trace.json",
+                                                    "*.json");
+    if (filename.isNull())
+        return;
+
+    ofstream out(filename.toStdString().c_str());
+    if (!out)
+    {
+        cerr << "Error: couldn't open " << filename.toStdString() << endl;
+        return;
+    }
+    Pipeline::WriteChromeTrace(out);
+}
 
 // ****************************************************************************
 // Method:  ELMainWindow::SetPipeline
@@ -189,11 +457,82 @@ ELMainWindow::OpenFile(const QString &filename)
 // Creation:    August 16, 2012
 //
 // Modifications:
+//   Update the time slider, since the time series may have changed.
+//
 // ****************************************************************************
 void
 ELMainWindow::PipelineUpdated(Pipeline *)
 {
-    // currently useless
+    UpdateTimeSlider();
+}
+
+// ****************************************************************************
+// Method:  ELMainWindow::UpdateTimeSlider
+//
+// Purpose:
+///   Make the time slider cover the time steps of the pipelines' time
+///   series, and hide it if there aren't any.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELMainWindow::UpdateTimeSlider()
+{
+    int nsteps = pipelineBuilder->GetNumTimeSteps();
+    int t = std::min(pipelineBuilder->GetCurrentTime(), nsteps-1);
+
+    timeSlider->blockSignals(true);
+    timeSlider->setRange(0, nsteps-1);
+    timeSlider->setValue(t);
+    timeSlider->blockSignals(false);
+    timeStepLabel->setText(QString("%1 of %2").arg(t+1).arg(nsteps));
+    timeControls->setVisible(nsteps > 1);
+}
+
+// ****************************************************************************
+// Method:  ELMainWindow::TimeChanged
+//
+// Purpose:
+///   Slot for when the time slider is moved (and let go).
+//
+// Arguments:
+//   t          the time step
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELMainWindow::TimeChanged(int t)
+{
+    timeStepLabel->setText(QString("%1 of %2").arg(t+1)
+                                              .arg(timeSlider->maximum()+1));
+    pipelineBuilder->SetTime(t);
+}
+
+// ****************************************************************************
+// Method:  ELMainWindow::PrefetchToggled
+//
+// Purpose:
+///   Slot for the check box choosing whether reading ahead in a time
+///   series runs the pipelines too, or just reads the data.
+//
+// Arguments:
+//   on         true to run the pipelines
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELMainWindow::PrefetchToggled(bool on)
+{
+    pipelineBuilder->SetPrefetchOperations(on);
 }
 
 // ****************************************************************************
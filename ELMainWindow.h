@@ -30,6 +30,9 @@ class QSplitter;
 // Programmer:  Jeremy Meredith
 // Creation:    July 30, 2012
 //
+// Modifications:
+//   Added time series and the time slider.
+//
 // ****************************************************************************
 class ELMainWindow : public QMainWindow
 {
@@ -42,16 +45,29 @@ class ELMainWindow : public QMainWindow
   public slots:
     void PipelineUpdated(Pipeline *pipe);
     void OpenFile();
+    void OpenTimeSeries();
+    void SavePipeline();
+    void SaveSession();
+    void OpenSession();
+    void ExportProfile();
     void Exit();
     void WindowAdded(QWidget*);
     void SettingsActivated(QWidget*);
+    void TimeChanged(int);
+    void PrefetchToggled(bool);
 
   private:
+    QString GetFileExtensions();
+    void UpdateTimeSlider();
+
     QSplitter *topSplitter;
     ELPipelineBuilder *pipelineBuilder;
     ELWindowManager *windowMgr;
     QGroupBox *windowSettingsGroup;
     QWidget *activeSettingsWidget;
+    QWidget *timeControls;
+    QSlider *timeSlider;
+    QLabel *timeStepLabel;
 };
 
 #endif
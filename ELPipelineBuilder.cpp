@@ -12,17 +12,37 @@
 #include <QComboBox>
 #include <QLabel>
 #include <QMessageBox>
+#include <QTimer>
 
 #include "Operation.h"
 #include "ELAttributeControl.h"
 #include "ELSources.h"
+#include "PipelineExecutor.h"
+#include "TimePrefetcher.h"
+#include "SessionAttributes.h"
 
-#include "ExternalFaceOperation.h"
-#include "ElevateOperation.h"
-#include "IsosurfaceOperation.h"
-#include "HistogramOperation.h"
-#include "SurfaceNormalsOperation.h"
-#include "TransformOperation.h"
+static ELPipelineBuilder *backgroundBuilder = NULL;
+
+// ****************************************************************************
+// Function:  ExecuteInBackground
+//
+// Purpose:
+///   The Pipeline::backgroundExecutor for the GUI, so things outside
+///   the pipeline builder (like plots reading a field) don't execute
+///   pipelines on the GUI thread.
+//
+// Arguments:
+//   pipeline   the pipeline to execute
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+ExecuteInBackground(Pipeline *pipeline)
+{
+    backgroundBuilder->StartExecution(pipeline);
+}
 
 // ****************************************************************************
 // Constructor:  ELPipelineBuilder::ELPipelineBuilder
@@ -31,11 +51,19 @@
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Added the time step prefetcher.
+//
+//   Become the pipelines' background executor.
+//
 // ****************************************************************************
 ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     : QWidget(parent)
 {
     currentPipeline = -1;
+    currentTime = 0;
+    prefetcher = new TimePrefetcher(this);
+    backgroundBuilder = this;
+    Pipeline::backgroundExecutor = ExecuteInBackground;
 
     // Top layout
     QGridLayout *topLayout = new QGridLayout(this);
@@ -62,7 +90,9 @@ ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     // The pipeline tree
     //
     tree = new QTreeWidget(pipelineGroup);
-    tree->setHeaderLabels(QStringList() << "Operation" << "Settings");
+    tree->setHeaderLabels(QStringList() << "Operation" << "Settings" << "Status"
+                          << "Wall (s)" << "CPU (s)" << "Cells" << "Points"
+                          << "Memory (MB)");
     //tree->setHeaderHidden(true);
     pipelineLayout->addWidget(tree, 0,0);
     connect(tree, SIGNAL(itemSelectionChanged()),
@@ -76,10 +106,16 @@ ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     /// Operation::GetOperationName.  We should loosed this restriction.
     const char *operations[] = {
         "Isosurface",
+        "Calculator",
         "Elevate",
         "ExternalFace",
+        "Decimate",
+        "Gradient",
         "Histogram",
+        "Slice",
+        "Streamline",
         "SurfaceNormals",
+        "Threshold",
         "Transform",
         NULL
     };
@@ -89,14 +125,14 @@ ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
         op->setData(QString(operations[i]));
         connect(op, SIGNAL(triggered()), this, SLOT(newOperation()));
     }
-    QPushButton *addOpButton = new QPushButton("Add Operation", pipelineGroup);
+    addOpButton = new QPushButton("Add Operation", pipelineGroup);
     addOpButton->setMenu(opMenu);
     pipelineLayout->addWidget(addOpButton, 1,0);
 
     //
     // add execute button (probably not the best place for it)
     //
-    QPushButton *deleteOpButton = new QPushButton("Delete Operation", pipelineGroup);
+    deleteOpButton = new QPushButton("Delete Operation", pipelineGroup);
     pipelineLayout->addWidget(deleteOpButton, 2, 0);
     connect(deleteOpButton, SIGNAL(clicked()),
             this, SLOT(deleteCurrentOp()));
@@ -105,11 +141,23 @@ ELPipelineBuilder::ELPipelineBuilder(QWidget *parent)
     //
     // add execute button (probably not the best place for it)
     //
-    QPushButton *executeButton = new QPushButton("Execute", pipelineGroup);
+    executeButton = new QPushButton("Execute", pipelineGroup);
     pipelineLayout->addWidget(executeButton, 3, 0);
     connect(executeButton, SIGNAL(clicked()),
             this, SLOT(executePipeline()));
 
+    cancelButton = new QPushButton("Cancel", pipelineGroup);
+    cancelButton->setEnabled(false);
+    pipelineLayout->addWidget(cancelButton, 4, 0);
+    connect(cancelButton, SIGNAL(clicked()),
+            this, SLOT(cancelExecution()));
+
+    // poll the progress of executing pipelines
+    progressTimer = new QTimer(this);
+    progressTimer->setInterval(250);
+    connect(progressTimer, SIGNAL(timeout()),
+            this, SLOT(UpdateProgress()));
+
     //
     // Settings
     //
@@ -193,6 +241,102 @@ ELPipelineBuilder::rebuildPipelineDisplay()
     }
 
     tree->setCurrentItem(sourceItem);
+    UpdateExecutionState();
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::UpdateExecutionState
+//
+// Purpose:
+///   Fill in the status and profile columns of the pipeline tree,
+///   and only allow editing the current pipeline if it isn't executing.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::UpdateExecutionState()
+{
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
+        return;
+    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
+
+    bool executing = pipeline->IsExecuting();
+    addOpButton->setEnabled(!executing);
+    deleteOpButton->setEnabled(!executing);
+    executeButton->setEnabled(!executing);
+    cancelButton->setEnabled(executing && !pipeline->IsCancelRequested());
+    settingsGroup->setEnabled(!executing);
+
+    int nchunks;
+    std::vector<int> progress = pipeline->GetStageProgress(nchunks);
+    for (int row=0; row<tree->topLevelItemCount(); ++row)
+    {
+        QString status = "";
+        if (executing)
+        {
+            int done = (row < (int)progress.size()) ? progress[row] : 0;
+            if (done == nchunks)
+                status = "done";
+            else if (pipeline->IsCancelRequested())
+                status = "cancelling";
+            else if (nchunks > 1)
+                status = QString("%1 of %2 chunks").arg(done).arg(nchunks);
+            else
+                status = "waiting";
+        }
+        else if (row < (int)pipeline->results.size())
+        {
+            status = "done";
+        }
+        QTreeWidgetItem *item = tree->topLevelItem(row);
+        item->setText(2, status);
+
+        // the profile is only safe to look at when not executing
+        if (executing || row >= (int)pipeline->results.size())
+        {
+            for (int col=3; col<=7; ++col)
+                item->setText(col, "");
+            continue;
+        }
+        StageProfile prof = pipeline->GetStageProfile(row);
+        if (prof.ncached > 0)
+            item->setText(2, QString("done (%1 cached)").arg(prof.ncached));
+        item->setText(3, QString::number(prof.wallTime, 'f', 3));
+        item->setText(4, QString::number(prof.cpuTime, 'f', 3));
+        item->setText(5, QString::number(prof.outCells));
+        item->setText(6, QString::number(prof.outPoints));
+        item->setText(7, QString::number(prof.bytes / (1024.*1024.), 'f', 1));
+    }
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::UpdateProgress
+//
+// Purpose:
+///   Timer slot to refresh the status while pipelines are executing.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::UpdateProgress()
+{
+    bool anyExecuting = false;
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+        anyExecuting |= Pipeline::allPipelines[i]->IsExecuting();
+    if (!anyExecuting)
+        progressTimer->stop();
+
+    UpdateExecutionState();
 }
 
 // ****************************************************************************
@@ -242,29 +386,9 @@ ELPipelineBuilder::newOperation()
 
     QString actionname = action->data().toString();
 
-    QWidget *opSettingsWidget = opSettingsWidgets[actionname];
-    if (opSettingsWidget == NULL)
-    {
-        opSettingsWidget = new ELAttributeControl(settingsGroup);
-        opSettingsWidgets[actionname] = opSettingsWidget;
-        connect(opSettingsWidget, SIGNAL(settingsChanged(Attribute*)),
-                this, SLOT(operatorUpdated(Attribute*)));
-    }
+    QWidget *opSettingsWidget = GetOperationSettingsWidget(actionname);
 
-    if (actionname == "Isosurface")
-        pipeline->ops.push_back(new IsosurfaceOperation);
-    else if (actionname == "Elevate")
-        pipeline->ops.push_back(new ElevateOperation);
-    else if (actionname == "ExternalFace")
-        pipeline->ops.push_back(new ExternalFaceOperation);
-    else if (actionname == "Histogram")
-        pipeline->ops.push_back(new HistogramOperation);
-    else if (actionname == "SurfaceNormals")
-        pipeline->ops.push_back(new SurfaceNormalsOperation);
-    else if (actionname == "Transform")
-        pipeline->ops.push_back(new TransformOperation);
-    else
-        throw "Unexpected operation";
+    pipeline->ops.push_back(Operation::CreateOperation(actionname.toStdString()));
 
     opSettingsWidget->hide();
 
@@ -273,6 +397,34 @@ ELPipelineBuilder::newOperation()
     tree->setCurrentItem(tree->topLevelItem(tree->topLevelItemCount()-1));
 }
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::GetOperationSettingsWidget
+//
+// Purpose:
+///   Return the settings widget shared by all operations with the
+///   given name, creating it the first time.
+//
+// Arguments:
+//   name       the operation name, e.g. "Isosurface"
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+QWidget *
+ELPipelineBuilder::GetOperationSettingsWidget(const QString &name)
+{
+    QWidget *opSettingsWidget = opSettingsWidgets[name];
+    if (opSettingsWidget == NULL)
+    {
+        opSettingsWidget = new ELAttributeControl(settingsGroup);
+        opSettingsWidgets[name] = opSettingsWidget;
+        connect(opSettingsWidget, SIGNAL(settingsChanged(Attribute*)),
+                this, SLOT(operatorUpdated(Attribute*)));
+        opSettingsWidget->hide();
+    }
+    return opSettingsWidget;
+}
 
 // ****************************************************************************
 // Method:  ELPipelineBuilder::addSource
@@ -284,11 +436,128 @@ ELPipelineBuilder::newOperation()
 // Creation:    August  7, 2012
 //
 // Modifications:
+//   The file is opened in Pipeline::importers, not passed in.
+//
 // ****************************************************************************
 void
-ELPipelineBuilder::addSource(const std::string &fn, eavlImporter *imp)
+ELPipelineBuilder::addSource(const std::string &fn)
 {
-    sourceSettings->addSource(fn,imp);
+    sourceSettings->addSource(fn);
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::addTimeSeries
+//
+// Purpose:
+///   When the user opens a time series, add it to the source list.
+//
+// Arguments:
+//   files      the files of the series, in order
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::addTimeSeries(const std::vector<std::string> &files)
+{
+    sourceSettings->addTimeSeries(files);
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::GetNumTimeSteps
+//
+// Purpose:
+///   The number of time steps of the longest time series any pipeline
+///   reads, or 1 if none does.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+int
+ELPipelineBuilder::GetNumTimeSteps()
+{
+    int n = 1;
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        Source *source = Pipeline::allPipelines[i]->source;
+        if (source->sourcetype == Source::File)
+            n = std::max(n, source->GetNumTimeSteps());
+    }
+    return n;
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::SetTime
+//
+// Purpose:
+///   Slot to show every time series at another time step (clamped to
+///   the steps each has).  Pipelines reading a series, directly or
+///   from another pipeline, are re-executed; one already executing is
+///   cancelled and restarted at the new step.  With prefetching, the
+///   results will usually be in the cache already.
+//
+// Arguments:
+//   t          the time step
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::SetTime(int t)
+{
+    if (t == currentTime)
+        return;
+    currentTime = t;
+
+    std::vector<Pipeline*> series;
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        Pipeline *pipeline = Pipeline::allPipelines[i];
+        Source *source = pipeline->source;
+        if (source->sourcetype == Source::File && !source->timeFiles.empty())
+            series.push_back(pipeline);
+    }
+
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        Pipeline *pipeline = Pipeline::allPipelines[i];
+        bool affected = false;
+        for (size_t j=0; j<series.size() && !affected; ++j)
+            affected = (pipeline == series[j] || pipeline->DependsOn(series[j]));
+        if (!affected)
+            continue;
+
+        prefetcher->Forget(pipeline);
+        if (pipeline->IsExecuting())
+            pipeline->RequestCancel();
+        StartExecution(pipeline);
+    }
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::SetPrefetchOperations
+//
+// Purpose:
+///   Choose whether prefetching the next time steps runs the pipelines'
+///   operations too, or just reads the data.
+//
+// Arguments:
+//   ops        true to run the operations
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::SetPrefetchOperations(bool ops)
+{
+    prefetcher->SetRunOperations(ops);
 }
 
 
@@ -368,7 +637,9 @@ ELPipelineBuilder::rowSelected()
 // Method:  ELPipelineBuilder::executePipeline
 //
 // Purpose:
-///   Execute the active pipeline and update any watchers via a signal.
+///   Start executing the active pipeline on a background thread.
+///   Watchers are updated via a signal when it finishes; see
+///   executionFinished.
 //
 // Arguments:
 //   none
@@ -383,24 +654,137 @@ ELPipelineBuilder::executePipeline()
 {
     if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
         return;
-    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
+    StartExecution(Pipeline::allPipelines[currentPipeline]);
+}
 
-    try {
-        pipeline->Execute();
-    }
-    catch (eavlException &e)
+// ****************************************************************************
+// Method:  ELPipelineBuilder::StartExecution
+//
+// Purpose:
+///   Start executing a pipeline on a background thread; see
+///   executePipeline.  If a pipeline it reads from is busy, it's
+///   started once that finishes.
+//
+// Arguments:
+//   pipeline   the pipeline to execute
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Move it, and the pipelines it reads from, to the current time step.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::StartExecution(Pipeline *pipeline)
+{
+    if (pipeline->IsExecuting())
     {
-        QMessageBox::critical(this,
-                              "Error executing pipeline",
-                              e.GetErrorText().c_str());
+        if (std::find(pendingExecutions.begin(), pendingExecutions.end(),
+                      pipeline) == pendingExecutions.end())
+            pendingExecutions.push_back(pipeline);
         return;
     }
 
+    for (Pipeline *p = pipeline; p; p = p->GetSourcePipeline())
+        p->SetTimeIndex(currentTime);
+
+    // run it in the background; other pipelines can execute (and
+    // be edited) at the same time
+    pipeline->SetExecuting(true);
+    PipelineExecutor *executor = new PipelineExecutor(pipeline, this);
+    connect(executor, SIGNAL(finished()),
+            this, SLOT(executionFinished()), Qt::QueuedConnection);
+    executor->start();
+
+    progressTimer->start();
+    UpdateExecutionState();
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::executionFinished
+//
+// Purpose:
+///   Slot for when a background execution finishes (on the GUI
+///   thread, since the connection is queued).  Reports errors and
+///   updates any watchers via a signal.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Start prefetching the next time steps.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::executionFinished()
+{
+    PipelineExecutor *executor = dynamic_cast<PipelineExecutor*>(sender());
+    if (!executor)
+        return;
+    Pipeline *pipeline = executor->pipe;
+    std::string error = executor->error;
+    bool cancelled = pipeline->IsCancelRequested();
+    executor->deleteLater();
+
+    pipeline->SetExecuting(false);
+    UpdateExecutionState();
     UpdatePipelineCombo();
 
+    // start any that were waiting on this one
+    std::vector<Pipeline*> pending;
+    pending.swap(pendingExecutions);
+    for (size_t i=0; i<pending.size(); ++i)
+        StartExecution(pending[i]);
+
+    if (error != "")
+    {
+        if (!cancelled)
+            QMessageBox::critical(this,
+                                  "Error executing pipeline",
+                                  error.c_str());
+        return;
+    }
+
+    // read ahead while this step is being looked at
+    for (Pipeline *p = pipeline; p; p = p->GetSourcePipeline())
+        prefetcher->Prefetch(p);
+
+    // the pipelines it reads from may have been brought up to date too
+    for (Pipeline *up = pipeline->GetSourcePipeline(); up;
+         up = up->GetSourcePipeline())
+        emit pipelineUpdated(up);
     emit pipelineUpdated(pipeline);
 }
 
+// ****************************************************************************
+// Method:  ELPipelineBuilder::cancelExecution
+//
+// Purpose:
+///   Ask the current pipeline to stop executing.  It stops at the
+///   next chunk or operation, so this may not happen right away.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::cancelExecution()
+{
+    if (currentPipeline < 0 || currentPipeline >= (int)Pipeline::allPipelines.size())
+        return;
+    Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
+    if (!pipeline->IsExecuting())
+        return;
+
+    pipeline->RequestCancel();
+    UpdateExecutionState();
+}
+
 // ****************************************************************************
 // Method:  ELPipelineBuilder::sourceUpdated
 //
@@ -457,9 +841,6 @@ ELPipelineBuilder::operatorUpdated(Attribute *settings)
         return;
     Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
     
-    // a bit brute force, but hopefully effective:
-    pipeline->ClearResults();
-
     // find the operator with these settings; a bit of a hack
     // if we changed this to get info about which operator
     // these new settings came from, it would be cleaner
@@ -473,6 +854,11 @@ ELPipelineBuilder::operatorUpdated(Attribute *settings)
         }
     }
 
+    // results upstream of this operator are still good
+    pipeline->InvalidateFrom(opindex);
+    if (opindex < 0)
+        return;
+
     Operation *op = pipeline->ops[opindex];
 
     int rowindex = opindex + 1;
@@ -490,9 +876,6 @@ ELPipelineBuilder::deleteCurrentOp()
 
     Pipeline *pipeline = Pipeline::allPipelines[currentPipeline];
 
-    // a bit brute force, but hopefully effective:
-    pipeline->ClearResults();
-
     QList<QTreeWidgetItem*> s = tree->selectedItems();
     int n = s.size();
     if (n == 0)
@@ -510,11 +893,153 @@ ELPipelineBuilder::deleteCurrentOp()
         if (rowindex == 0)
             return;
         int opindex = rowindex - 1;
-        for (int i = opindex; i < pipeline->ops.size()-1; ++i)
-            pipeline->ops[i] = pipeline->ops[i+1];
-        pipeline->ops.resize(pipeline->ops.size()-1);
+        pipeline->RemoveOperation(opindex);
         rebuildPipelineDisplay();
     }
 
     UpdatePipelineCombo();
 }
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::ExecuteAllPipelines
+//
+// Purpose:
+///   Start executing every pipeline that has a source, e.g. after
+///   restoring a session.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::ExecuteAllPipelines()
+{
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        Pipeline *pipeline = Pipeline::allPipelines[i];
+        if (pipeline->source->GetSourceInfo() != "")
+            StartExecution(pipeline);
+    }
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::SaveSession
+//
+// Purpose:
+///   Add all the pipelines, and which one is being edited, to a session.
+//
+// Arguments:
+//   atts       the session
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELPipelineBuilder::SaveSession(SessionAttributes *atts)
+{
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+        atts->pipelines.push_back(Pipeline::allPipelines[i]->CreateAttributes());
+    atts->currentPipeline = currentPipeline;
+}
+
+// ****************************************************************************
+// Method:  ELPipelineBuilder::RestoreSession
+//
+// Purpose:
+///   Replace all the pipelines with the ones in a session.  They aren't
+///   executed; see ExecuteAllPipelines.  Throws an Exception if any of
+///   them can't be created, in which case nothing is changed.
+//
+// Arguments:
+//   atts       the session
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Restore time series sources, and the time step they were at.
+//
+//   Delete the old pipelines, once the windows have let go of them.
+//
+// ****************************************************************************
+void
+ELPipelineBuilder::RestoreSession(SessionAttributes *atts)
+{
+    std::vector<Pipeline*> pipelines;
+    try
+    {
+        for (size_t i=0; i<atts->pipelines.size(); ++i)
+        {
+            pipelines.push_back(new Pipeline);
+            pipelines.back()->SetFromAttributes(atts->pipelines[i]);
+        }
+
+        // connect the pipeline sources, now that they all exist
+        for (size_t i=0; i<pipelines.size(); ++i)
+        {
+            int up = atts->pipelines[i]->sourcePipeline;
+            if (up < 0)
+                continue;
+            if (up >= (int)pipelines.size())
+                throw Exception("Source pipeline %d doesn't exist", up);
+            pipelines[i]->source->sourcetype = Source::Pipe;
+            pipelines[i]->source->source_pipe = pipelines[up];
+        }
+        for (size_t i=0; i<pipelines.size(); ++i)
+        {
+            Pipeline *p = pipelines[i];
+            for (size_t n=0; n<=pipelines.size() && p; ++n)
+                p = p->GetSourcePipeline();
+            if (p)
+                throw Exception("Pipeline %d is its own source", (int)i);
+        }
+    }
+    catch (...)
+    {
+        for (size_t i=0; i<pipelines.size(); ++i)
+            delete pipelines[i];
+        throw;
+    }
+    if (pipelines.empty())
+        pipelines.push_back(new Pipeline);
+
+    // nothing may refer to the old pipelines once they're deleted
+    std::vector<Pipeline*> old = Pipeline::allPipelines;
+    for (size_t i=0; i<old.size(); ++i)
+        prefetcher->Forget(old[i]);
+    emit PipelinesDeleting();
+    Pipeline::allPipelines = pipelines;
+    for (size_t i=0; i<old.size(); ++i)
+        delete old[i];
+
+    // make the files available for choosing as sources
+    for (size_t i=0; i<pipelines.size(); ++i)
+    {
+        Source *source = pipelines[i]->source;
+        if (source->sourcetype == Source::File && !source->timeFiles.empty())
+        {
+            if (!sourceSettings->hasSource(source->timeFiles[0]))
+                sourceSettings->addTimeSeries(source->timeFiles);
+            currentTime = source->timeIndex;
+        }
+        else if (source->sourcetype == Source::File && source->file != "" &&
+                 !sourceSettings->hasSource(source->file))
+            sourceSettings->addSource(source->file);
+        for (size_t j=0; j<pipelines[i]->ops.size(); ++j)
+            GetOperationSettingsWidget(pipelines[i]->ops[j]->GetOperationName().c_str());
+    }
+
+    pipelineChooser->clear();
+    for (size_t i=0; i<pipelines.size(); ++i)
+        pipelineChooser->addItem("");
+    UpdatePipelineCombo();
+
+    int index = atts->currentPipeline;
+    if (index < 0 || index >= (int)pipelines.size())
+        index = 0;
+    pipelineChooser->setCurrentIndex(index);
+    activatePipeline(index);
+}
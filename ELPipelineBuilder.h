@@ -6,10 +6,14 @@
 #include "eavlImporter.h"
 #include "Pipeline.h"
 class ELSources;
+class SessionAttributes;
 class QGroupBox;
 class QTreeWidgetItem;
 class QTreeWidget;
 class QComboBox;
+class QPushButton;
+class QTimer;
+class TimePrefetcher;
 
 // ****************************************************************************
 // Class:  ELPipelineBuilder
@@ -22,6 +26,8 @@ class QComboBox;
 // Creation:    August  1, 2012
 //
 // Modifications:
+//   Added the current time step, and prefetching of the next ones.
+//
 // ****************************************************************************
 class ELPipelineBuilder : public QWidget
 {
@@ -33,29 +39,55 @@ class ELPipelineBuilder : public QWidget
   signals:
     void pipelineUpdated(Pipeline *pipe);
     void CurrentPipelineChanged(int);
+    /// the pipelines are about to be deleted and replaced
+    void PipelinesDeleting();
 
   public:
     ELPipelineBuilder(QWidget *parent);
-    void addSource(const std::string &fn, eavlImporter *imp);
+    void addSource(const std::string &fn);
+    void addTimeSeries(const std::vector<std::string> &files);
+    int GetNumTimeSteps();
+    int GetCurrentTime() { return currentTime; }
+    void SetPrefetchOperations(bool);
     void addPipeline();
     void rebuildPipelineDisplay();
+    void UpdateExecutionState();
+    void StartExecution(Pipeline *pipeline);
+    void ExecuteAllPipelines();
+    QWidget *GetOperationSettingsWidget(const QString &name);
+    void SaveSession(SessionAttributes *atts);
+    void RestoreSession(SessionAttributes *atts);
 
   public slots:
     void newOperation();
     void rowSelected();
     void executePipeline();
+    void executionFinished();
+    void cancelExecution();
+    void UpdateProgress();
     void activatePipeline(int);
     void sourceUpdated();
     void operatorUpdated(Attribute*);
     void deleteCurrentOp();
     void NewPipeline();
     void UpdatePipelineCombo();
+    void SetTime(int);
 
   protected:
     ELSources *sourceSettings;
     QTreeWidget *tree;
     QGroupBox *settingsGroup;
     QComboBox *pipelineChooser;
+    QPushButton *addOpButton;
+    QPushButton *deleteOpButton;
+    QPushButton *executeButton;
+    QPushButton *cancelButton;
+    QTimer *progressTimer;
+    /// pipelines waiting for one they read from to finish executing
+    std::vector<Pipeline*> pendingExecutions;
+    /// the time step every time series source is shown at
+    int currentTime;
+    TimePrefetcher *prefetcher;
 };
 
 #endif
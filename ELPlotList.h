@@ -10,6 +10,7 @@
 #include <QBrush>
 
 #include "ELSurfacePlotSettings.h"
+#include "SessionAttributes.h"
 
 
 // ****************************************************************************
@@ -164,13 +165,49 @@ class ELPlotList : public QWidget
             Plot &p = plots[i];
             if (p.pipe == pipe)
             {
-                p.UpdateDataSet(pipe->results.back());
+                p.UpdateDataSet();
             }
         }
 
         UpdatePlotList();
         plotSettings->PipelineUpdated(pipe);
     }
+    void SaveSession(WindowAttributes *atts)
+    {
+        for (size_t i=0; i<plots.size(); i++)
+        {
+            PlotAttributes *p = new PlotAttributes;
+            p->SetFromPlot(plots[i]);
+            atts->plots.push_back(p);
+        }
+    }
+    /// Drop every plot, e.g. because the pipelines are being deleted.
+    void ForgetPipelines()
+    {
+        for (size_t i=0; i<plots.size(); i++)
+            plots[i].DeleteRenderers();
+        plots.clear();
+        latestUsedPipeline = NULL;
+        newPlotBtn->setEnabled(false);
+        plotList->clearSelection();
+        UpdatePlotList();
+    }
+    void RestoreSession(WindowAttributes *atts)
+    {
+        ForgetPipelines();
+        for (size_t i=0; i<atts->plots.size(); i++)
+        {
+            Plot p;
+            p.oneDimensional = oneDimensional; ///<\todo:hack!
+            atts->plots[i]->ApplyToPlot(p);
+            plots.push_back(p);
+            if (p.pipe)
+                latestUsedPipeline = p.pipe;
+        }
+        newPlotBtn->setEnabled(latestUsedPipeline != NULL);
+        plotList->clearSelection();
+        UpdatePlotList();
+    }
   public slots:
     void PlotChanged()
     {
@@ -224,6 +261,8 @@ class ELPlotList : public QWidget
         int c = plotList->indexOfTopLevelItem(plotList->currentItem());
         if (c < 0 || c >= n)
             return;
+        // let go of the results it was drawing
+        plots[c].DeleteRenderers();
         for (int i=c; i+1<n; i++)
             plots[i] = plots[i+1];
         plots.resize(n-1);
@@ -0,0 +1,67 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EL_PLOT_WINDOW_H
+#define EL_PLOT_WINDOW_H
+
+#include <QGLWidget>
+
+#include <eavlView.h>
+
+#include "ELWindow.h"
+#include "ELPlotList.h"
+#include "SessionAttributes.h"
+
+// ****************************************************************************
+// Class:  ELPlotWindow
+//
+// Purpose:
+///   Base for the windows which draw a list of plots with a camera
+///   (1D, 2D, 3D and polar).  In a session, such a window is its plot
+///   list and its camera.  The saved camera is re-applied whenever
+///   the view is reset (e.g. when the restored pipelines finish
+///   executing) until the user interacts with it.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class ELPlotWindow : public QGLWidget, public ELWindow
+{
+  protected:
+    ELPlotList *settings;
+    /// a camera from a saved session, kept until the user moves it
+    bool        hasSavedView;
+    eavlView    savedView;
+
+  public:
+    ELPlotWindow(QWidget *parent)
+        : QGLWidget(parent), settings(NULL), hasSavedView(false)
+    {
+    }
+    virtual void SaveSession(WindowAttributes *atts)
+    {
+        settings->SaveSession(atts);
+        atts->view.SetFromView(GetView());
+    }
+    virtual void RestoreSession(WindowAttributes *atts)
+    {
+        settings->RestoreSession(atts);
+        savedView = GetView();
+        atts->view.ApplyToView(savedView);
+        hasSavedView = true;
+        UpdatePlots();
+        updateGL();
+    }
+    virtual void ForgetPipelines()
+    {
+        settings->ForgetPipelines();
+        UpdatePlots();
+        updateGL();
+    }
+    virtual bool UpdatePlots() = 0;
+
+  protected:
+    /// the camera of the EAVL window we draw with
+    virtual eavlView &GetView() = 0;
+};
+
+#endif
@@ -21,12 +21,12 @@
 // Creation:    August 16, 2012
 //
 // Modifications:
+//   The plot list and saved camera belong to ELPlotWindow now.
+//
 // ****************************************************************************
 ELPolarWindow::ELPolarWindow(ELWindowManager *parent)
-    : QGLWidget(parent)
+    : ELPlotWindow(parent)
 {
-    settings = NULL;
-
     mousedown = false;
     shiftKey = false;
     lastx = lasty = -1;
@@ -127,13 +127,20 @@ ELPolarWindow::UpdatePlots()
     for (unsigned int i=0;  i<settings->plots.size(); i++)
     {
         Plot &p = settings->plots[i];
-        if (!p.pipe || p.pipe->results.size() == 0)
+        if (!p.pipe)
             continue;
-        p.CreateRenderer(&TransformTo2DCart);
-        if (!p.renderer)
+        // while a pipeline is executing, keep drawing what we had
+        if (!p.pipe->IsExecuting())
+        {
+            if (!p.pipe->HasResults())
+                continue;
+            p.CreateRenderer(&TransformTo2DCart);
+        }
+        if (p.renderers.empty())
             continue;
         shoulddraw = true;
-        scene->plots.push_back(p.renderer);
+        scene->plots.insert(scene->plots.end(),
+                            p.renderers.begin(), p.renderers.end());
     }
     return shoulddraw;
 }
@@ -157,6 +164,11 @@ void
 ELPolarWindow::ResetView()
 {
     scene->ResetView(window);
+    if (hasSavedView)
+    {
+        window->view.view3d = savedView.view3d;
+        window->view.view2d = savedView.view2d;
+    }
     updateGL();
 }
 
@@ -279,6 +291,7 @@ ELPolarWindow::resizeGL(int w, int h)
 void
 ELPolarWindow::mousePressEvent(QMouseEvent *mev)
 {
+    hasSavedView = false;
     shiftKey = (mev->modifiers() & Qt::ShiftModifier);
     makeCurrent();
 
@@ -412,3 +425,22 @@ ELPolarWindow::SomethingChanged()
 {
     updateGL();
 }
+
+// ****************************************************************************
+// Method:  ELPolarWindow::GetView
+//
+// Purpose:
+///   The camera of our EAVL window, for ELPlotWindow.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+eavlView &
+ELPolarWindow::GetView()
+{
+    return window->view;
+}
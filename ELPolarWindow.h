@@ -16,7 +16,7 @@
 #include <eavlDataSet.h>
 #include <Plot.h>
 
-#include "ELPlotList.h"
+#include "ELPlotWindow.h"
 
 class eavlPolarWindow;
 class eavlScene;
@@ -34,12 +34,12 @@ class eavlRenderer;
 // Creation:    March 20, 2013
 //
 // Modifications:
+//   Moved the plot list and session saving into ELPlotWindow.
+//
 // ****************************************************************************
-class ELPolarWindow : public QGLWidget
+class ELPolarWindow : public ELPlotWindow
 {
     Q_OBJECT
-  protected:
-    ELPlotList *settings;
   public:
     ELPolarWindow(ELWindowManager *parent);
     virtual void initializeGL();
@@ -74,6 +74,9 @@ class ELPolarWindow : public QGLWidget
     eavlPolarWindow *window;
     eavlScene    *scene;
 
+  protected:
+    virtual eavlView &GetView();
+
   public slots:
     void CurrentPipelineChanged(int index);
     void PipelineUpdated(Pipeline *p);
@@ -6,7 +6,11 @@
 #include <QFileInfo>
 #include <QGridLayout>
 #include <QComboBox>
+#include <QMessageBox>
+#include <QTimer>
 
+#include "ELAttributeControl.h"
+#include "FileOpener.h"
 #include "Pipeline.h"
 
 // ****************************************************************************
@@ -16,6 +20,12 @@
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Filled in the geometry tab.
+//
+//   Filled in the pipeline tab.
+//
+//   Added a timer to pick up meshes from files being opened.
+//
 // ****************************************************************************
 ELSources::ELSources(QWidget *parent)
     : QTabWidget(parent)
@@ -25,6 +35,11 @@ ELSources::ELSources(QWidget *parent)
     connect(this, SIGNAL(currentChanged(int)),
             this, SLOT(tabChanged(int)));
 
+    openTimer = new QTimer(this);
+    openTimer->setInterval(250);
+    connect(openTimer, SIGNAL(timeout()),
+            this, SLOT(fileOpenProgress()));
+
     //
     // File source
     //
@@ -45,12 +60,28 @@ ELSources::ELSources(QWidget *parent)
     // Pipeline source
     //
     QWidget *pipeTab = new QWidget();
+    QGridLayout *pipeLayout = new QGridLayout(pipeTab);
+
+    pipeCombo = new QComboBox(pipeTab);
+    pipeCombo->addItem("(none)", -1);
+    pipeLayout->addWidget(pipeCombo);
+
+    connect(pipeCombo, SIGNAL(currentIndexChanged(int)),
+            this, SLOT(pipeChanged(int)));
+
     addTab(pipeTab, "Pipeline");
 
     //
     // Geometry source
     //
     QWidget *geomTab = new QWidget();
+    QGridLayout *geomLayout = new QGridLayout(geomTab);
+
+    geometryControls = new ELAttributeControl(geomTab);
+    geomLayout->addWidget(geometryControls);
+    connect(geometryControls, SIGNAL(settingsChanged(Attribute*)),
+            this, SIGNAL(sourceChanged()));
+
     addTab(geomTab, "Geometry");
 }
 
@@ -59,34 +90,226 @@ ELSources::ELSources(QWidget *parent)
 //
 // Purpose:
 ///   Adds a source, its meshes, and its variables to the tree.
-///   Also keep track of the importer for the source.
+///   The file is opened in Pipeline::importers on another thread;
+///   until that's done it has a placeholder entry, and its meshes are
+///   added as they're found (see fileOpenProgress), so the user can
+///   get on with setting up a pipeline in the meantime.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Get the meshes from the importer pool's metadata.
+//
+//   Open the file in the background.
+//
 // ****************************************************************************
 void
-ELSources::addSource(const std::string &fn, eavlImporter *imp)
+ELSources::addSource(const std::string &fn)
 {
-    openFiles[fn] = imp;
-    QString shortname = QFileInfo(fn.c_str()).fileName();
+    if (openingFiles.count(fn))
+        return;
+    openFiles.insert(fn);
 
     bool firstSource = false;
     if (combo->count() == 1 && combo->itemText(0) == "(none)")
         firstSource = true;
 
-    vector<string> meshes = imp->GetMeshList();
+    // the placeholder's data is just the file, so it can't be chosen
+    // as a file:mesh source
+    combo->blockSignals(true);
+    combo->addItem(QFileInfo(fn.c_str()).fileName() + " (opening...)",
+                   QStringList() << QString(fn.c_str()));
+    combo->blockSignals(false);
+    openingFiles[fn] = firstSource;
+
+    FileOpener *opener = new FileOpener(fn, this);
+    connect(opener, SIGNAL(finished()),
+            this, SLOT(fileOpenFinished()), Qt::QueuedConnection);
+    opener->start();
+    openTimer->start();
+}
+
+// ****************************************************************************
+// Method:  ELSources::addTimeSeries
+//
+// Purpose:
+///   Adds a time series.  Its meshes are listed under its first file,
+///   which is the one opened to find them; the other files are opened
+///   when a pipeline gets to them.
+//
+// Arguments:
+//   files      the files of the series, in order
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::addTimeSeries(const std::vector<std::string> &files)
+{
+    if (files.empty())
+        return;
+    if (files.size() == 1)
+    {
+        addSource(files[0]);
+        return;
+    }
+    timeSeries[files[0]] = files;
+    addSource(files[0]);
+}
+
+// ****************************************************************************
+// Method:  ELSources::GetSourceKey
+//
+// Purpose:
+///   The file the current source is listed under: the first of its
+///   time series, if it has one.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::string
+ELSources::GetSourceKey()
+{
+    if (!source)
+        return "";
+    return source->timeFiles.empty() ? source->file : source->timeFiles[0];
+}
+
+// ****************************************************************************
+// Method:  ELSources::AddMeshes
+//
+// Purpose:
+///   Add the meshes found so far in a file that we don't have yet,
+///   ahead of its placeholder if it's still being opened.  If one is
+///   the current source's mesh (e.g. from a restored session), it's
+///   selected.
+//
+// Arguments:
+//   fn         the file name
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Say how many steps a time series has.
+//
+// ****************************************************************************
+void
+ELSources::AddMeshes(const std::string &fn)
+{
+    QString shortname = QFileInfo(fn.c_str()).fileName();
+    std::map<std::string, std::vector<std::string> >::iterator series =
+        timeSeries.find(fn);
+    if (series != timeSeries.end())
+        shortname += QString(" (%1 steps)").arg(series->second.size());
+    int placeholder = combo->findData(QStringList() << QString(fn.c_str()));
+
+    vector<string> meshes = Pipeline::importers.GetMeshList(fn);
     for (unsigned int i=0; i<meshes.size(); i++)
     {
-        combo->addItem(shortname + ":" + meshes[i].c_str(),
-                       QStringList() <<
-                       QString(fn.c_str()) <<
-                       QString(meshes[i].c_str()));
+        QStringList data = QStringList() <<
+                           QString(fn.c_str()) <<
+                           QString(meshes[i].c_str());
+        if (combo->findData(data) >= 0)
+            continue;
+
+        int index = combo->count();
+        if (placeholder >= 0)
+            index = placeholder++;
+        combo->blockSignals(true);
+        combo->insertItem(index, shortname + ":" + meshes[i].c_str(), data);
+        combo->blockSignals(false);
+
+        std::map<std::string, bool>::iterator opening = openingFiles.find(fn);
+        if (opening != openingFiles.end() && opening->second)
+        {
+            opening->second = false;
+            combo->setCurrentIndex(index);
+        }
+        else if (source && GetSourceKey() == fn && source->mesh == meshes[i])
+        {
+            combo->blockSignals(true);
+            combo->setCurrentIndex(index);
+            combo->blockSignals(false);
+        }
     }
+}
 
-    if (firstSource)
-        combo->setCurrentIndex(1);
+// ****************************************************************************
+// Method:  ELSources::fileOpenProgress
+//
+// Purpose:
+///   Slot for the timer that runs while files are being opened; adds
+///   the meshes found since last time.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::fileOpenProgress()
+{
+    for (std::map<std::string, bool>::iterator it = openingFiles.begin();
+         it != openingFiles.end(); ++it)
+        AddMeshes(it->first);
+}
+
+// ****************************************************************************
+// Method:  ELSources::fileOpenFinished
+//
+// Purpose:
+///   Slot for when a FileOpener finishes (on the GUI thread, since the
+///   connection is queued).  Adds the rest of the file's meshes and
+///   removes its placeholder, or on error, removes the file.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::fileOpenFinished()
+{
+    FileOpener *opener = dynamic_cast<FileOpener*>(sender());
+    if (!opener)
+        return;
+    std::string fn = opener->file;
+    std::string error = opener->error;
+    opener->deleteLater();
+
+    if (error == "")
+        AddMeshes(fn);
+    openingFiles.erase(fn);
+    if (openingFiles.empty())
+        openTimer->stop();
+
+    combo->blockSignals(true);
+    for (int i=combo->count()-1; i>=1; --i)
+    {
+        QStringList data = combo->itemData(i).toStringList();
+        if (data.size() >= 1 && data[0] == fn.c_str() &&
+            (data.size() == 1 || error != ""))
+            combo->removeItem(i);
+    }
+    combo->blockSignals(false);
+
+    if (error != "")
+    {
+        openFiles.erase(fn);
+        timeSeries.erase(fn);
+        QMessageBox::critical(this, "Error opening file",
+                              (fn + ": " + error).c_str());
+    }
 }
 
 
@@ -103,6 +326,11 @@ ELSources::addSource(const std::string &fn, eavlImporter *imp)
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Sources no longer hold an importer.
+//
+//   Set up the time series, if it's one.  The pipeline builder moves it
+//   to the current time step.
+//
 // ****************************************************************************
 void
 ELSources::fileMeshChanged(int index)
@@ -118,7 +346,41 @@ ELSources::fileMeshChanged(int index)
 
     source->file = data[0].toStdString();
     source->mesh = data[1].toStdString();
-    source->source_file = openFiles[source->file];
+    source->timeFiles.clear();
+    source->timeIndex = 0;
+    std::map<std::string, std::vector<std::string> >::iterator series =
+        timeSeries.find(source->file);
+    if (series != timeSeries.end())
+        source->timeFiles = series->second;
+    emit sourceChanged();
+}
+
+// ****************************************************************************
+// Method:  ELSources::pipeChanged
+//
+// Purpose:
+///   Slot for when the source pipeline combo box active item changes.
+//
+// Arguments:
+//   index      the new index in the combo
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELSources::pipeChanged(int index)
+{
+    if (!source)
+        return;
+    if (index < 0)
+        return;
+
+    int pipeindex = pipeCombo->itemData(index).toInt();
+    if (pipeindex < 0 || pipeindex >= (int)Pipeline::allPipelines.size())
+        source->source_pipe = NULL;
+    else
+        source->source_pipe = Pipeline::allPipelines[pipeindex];
     emit sourceChanged();
 }
 
@@ -159,11 +421,14 @@ ELSources::tabChanged(int index)
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Connect the geometry settings too.
+//
 // ****************************************************************************
 void
 ELSources::ConnectSettings(Source *s)
 {
     source = s;
+    geometryControls->ConnectAttributes(s->geometry);
 }
 
 // ****************************************************************************
@@ -179,6 +444,12 @@ ELSources::ConnectSettings(Source *s)
 // Creation:    August 21, 2012
 //
 // Modifications:
+//   Update the geometry tab too.
+//
+//   Update the pipeline tab too.
+//
+//   Time series are listed under their first file.
+//
 // ****************************************************************************
 void
 ELSources::UpdateWindowFromSettings()
@@ -193,7 +464,7 @@ ELSources::UpdateWindowFromSettings()
     {
         QStringList data = combo->itemData(i).toStringList();
         if (data.size() == 2 &&
-            data[0] == source->file.c_str() &&
+            data[0] == GetSourceKey().c_str() &&
             data[1] == source->mesh.c_str())
         {
             sourceindex = i;
@@ -203,4 +474,29 @@ ELSources::UpdateWindowFromSettings()
     combo->blockSignals(true);
     combo->setCurrentIndex(sourceindex);
     combo->blockSignals(false);
+
+    // pipeline tab: any pipeline but this one and those reading
+    // from it, which would make a cycle
+    Pipeline *self = NULL;
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        if (Pipeline::allPipelines[i]->source == source)
+            self = Pipeline::allPipelines[i];
+    }
+    pipeCombo->blockSignals(true);
+    pipeCombo->clear();
+    pipeCombo->addItem("(none)", -1);
+    for (size_t i=0; i<Pipeline::allPipelines.size(); ++i)
+    {
+        Pipeline *p = Pipeline::allPipelines[i];
+        if (p == self || (self && p->DependsOn(self)))
+            continue;
+        pipeCombo->addItem(p->GetName().c_str(), (int)i);
+        if (p == source->source_pipe)
+            pipeCombo->setCurrentIndex(pipeCombo->count()-1);
+    }
+    pipeCombo->blockSignals(false);
+
+    // geometry tab
+    geometryControls->UpdateWindowFromAtts();
 }
@@ -2,11 +2,13 @@
 #ifndef EL_SOURCES_H
 #define EL_SOURCES_H
 
-#include "eavlImporter.h"
 #include <QTabWidget>
 #include "STL.h"
+#include <set>
 
+class ELAttributeControl;
 class QComboBox;
+class QTimer;
 class QTreeWidget;
 class QTreeWidgetItem;
 class Source;
@@ -21,12 +23,23 @@ class Source;
 // Creation:    August  2, 2012
 //
 // Modifications:
+//   Files are opened in the background, and their meshes added as
+//   they're found.
+//
+//   Added time series, which are listed under their first file.
+//
 // ****************************************************************************
 class ELSources : public QTabWidget
 {
     Q_OBJECT
   protected:
-    std::map<std::string, eavlImporter*> openFiles;
+    std::set<std::string> openFiles;
+    /// files still being opened, and whether to select the first of
+    /// their meshes when it shows up
+    std::map<std::string, bool> openingFiles;
+    /// the files of each time series, keyed by the first one
+    std::map<std::string, std::vector<std::string> > timeSeries;
+    QTimer *openTimer;
 
     enum roles {
         fileRole = Qt::UserRole+0,
@@ -35,17 +48,27 @@ class ELSources : public QTabWidget
     };
 
     QComboBox *combo;
+    QComboBox *pipeCombo;
+    ELAttributeControl *geometryControls;
     Source *source;
 
   public:
     ELSources(QWidget *parent);
-    void addSource(const std::string &fn, eavlImporter *imp);        
-    eavlImporter *getImporter(const std::string &fn) { return openFiles[fn]; }
+    void addSource(const std::string &fn);
+    void addTimeSeries(const std::vector<std::string> &files);
+    bool hasSource(const std::string &fn) { return openFiles.count(fn) > 0; }
     void ConnectSettings(Source *s);
     void UpdateWindowFromSettings();
 
+  protected:
+    void AddMeshes(const std::string &fn);
+    std::string GetSourceKey();
+
   public slots:
+    void fileOpenProgress();
+    void fileOpenFinished();
     void fileMeshChanged(int);
+    void pipeChanged(int);
     void tabChanged(int);
 
   signals:
@@ -41,10 +41,14 @@ class ELSurfacePlotSettings : public QWidget
     Plot *plot;
     vector<string> cellsetList;
     vector< vector<string> > fieldList;
+    int unloadedIndex;
+    /// a field being read in the background, to plot once it's there
+    string pendingField;
   public:
     ELSurfacePlotSettings(QWidget *p) : QWidget(p)
     {
         plot = NULL;
+        unloadedIndex = -1;
 
         QGridLayout *topLayout = new QGridLayout(this);
 
@@ -117,10 +121,18 @@ class ELSurfacePlotSettings : public QWidget
         if (index >= 0)
             pipelineCombo->setCurrentIndex(index);
 
+        if (pendingField != "" && plot && p == plot->pipe)
+        {
+            string name = pendingField;
+            pendingField = "";
+            UseReadField(name);
+        }
+
         RebuildVarChooser();
 
         emit SomethingChanged();
     }
+  public slots:
     void RebuildVarChooser()
     {
         // rebuild the field combo box
@@ -134,6 +146,7 @@ class ELSurfacePlotSettings : public QWidget
 
         cellsetList.clear();
         fieldList.clear();
+        unloadedIndex = -1;
 
         varChooser->blockSignals(true);
 
@@ -193,6 +206,25 @@ class ELSurfacePlotSettings : public QWidget
             csItem->setExpanded(true);
         }
 
+        // fields in the source we haven't read yet; choosing one
+        // makes the pipeline read it
+        if (dsinfo.unloadedfields.size() > 0)
+        {
+            QTreeWidgetItem *unItem = new QTreeWidgetItem(QStringList()
+                                                          <<"(not yet read)");
+            varChooser->addTopLevelItem(unItem);
+            unloadedIndex = cellsetList.size();
+            cellsetList.push_back("");
+            fieldList.push_back(vector<string>());
+            for (int i=0; i<dsinfo.unloadedfields.size(); ++i)
+            {
+                QTreeWidgetItem *fItem = new QTreeWidgetItem(QStringList()
+                                                             <<dsinfo.unloadedfields[i].c_str());
+                unItem->addChild(fItem);
+                fieldList[fieldList.size()-1].push_back(dsinfo.unloadedfields[i]);
+            }
+        }
+
         if (selItem)
             selItem->setSelected(true);
         else
@@ -204,9 +236,11 @@ class ELSurfacePlotSettings : public QWidget
         varChooser->blockSignals(false);
 
     }
+  public:
     void NewPlotSelected(Plot *p)
     {
         plot = p;
+        pendingField = "";
         RebuildVarChooser();
         wireframeChk->setChecked(plot->wireframe);
         SetColorTableCombo(plot->colortable);
@@ -232,6 +266,7 @@ class ELSurfacePlotSettings : public QWidget
             return;
 
         plot->pipe = Pipeline::allPipelines[index];
+        pendingField = "";
         RebuildVarChooser();
         emit SomethingChanged();
     }
@@ -275,8 +310,7 @@ class ELSurfacePlotSettings : public QWidget
             return;
 
         // hack: delete the renderer so we can re-do it
-        delete plot->renderer;
-        plot->renderer = NULL;
+        plot->DeleteRenderers();
 
         plot->barsFor1D = (style == "Bars");
 
@@ -288,8 +322,7 @@ class ELSurfacePlotSettings : public QWidget
             return;
 
         // hack: delete the renderer so we can re-do it
-        delete plot->renderer;
-        plot->renderer = NULL;
+        plot->DeleteRenderers();
 
         plot->wireframe = state;
 
@@ -313,8 +346,7 @@ class ELSurfacePlotSettings : public QWidget
         // in the process re-create the renderer with the
         // old color.  oops!  so wait to delete the renderer
         // until you have the right new color to use.)
-        delete plot->renderer;
-        plot->renderer = NULL;
+        plot->DeleteRenderers();
 
         plot->color = eavlColor(color.redF(),
                                 color.greenF(),
@@ -330,8 +362,7 @@ class ELSurfacePlotSettings : public QWidget
             return;
         ///\todo: we're on track to have a bunch of this junk
         /// any time we change stuff; fix it:
-        delete plot->renderer;
-        plot->renderer = NULL;
+        plot->DeleteRenderers();
 
         plot->colortable = ct.toStdString();
         emit SomethingChanged();
@@ -342,8 +373,7 @@ class ELSurfacePlotSettings : public QWidget
             return;
 
         // here, we set the field index and cell index given a field name
-        delete plot->renderer;
-        plot->renderer = NULL;
+        plot->DeleteRenderers();
 
         string oldCS = plot->cellset;
         string oldF = plot->field;
@@ -366,6 +396,13 @@ class ELSurfacePlotSettings : public QWidget
             //cerr << "cellSetIndex="<<cellSetIndex<<endl;
             //cerr << "fieldIndex="<<fieldIndex<<endl;
 
+            if (cellSetIndex == unloadedIndex)
+            {
+                if (fieldIndex >= 0)
+                    ReadUnloadedField(fieldList[cellSetIndex][fieldIndex]);
+                return;
+            }
+
             plot->cellset = cellsetList[cellSetIndex];
             plot->field = (fieldIndex<0) ? "" : fieldList[cellSetIndex][fieldIndex];
         }
@@ -374,6 +411,68 @@ class ELSurfacePlotSettings : public QWidget
             plot->field != oldF)
             emit SomethingChanged();
     }
+    void ReadUnloadedField(const string &name)
+    {
+        Pipeline *p = plot->pipe;
+        if (!p || p->IsExecuting())
+            return;
+
+        try
+        {
+            if (p->RequestVariable(name))
+                p->StartExecution();
+        }
+        catch (const eavlException &e)
+        {
+            cerr << "Error: " <<e.GetErrorText() << endl;
+            return;
+        }
+
+        // if it's executing in the background, finish up once the
+        // pipeline is updated
+        if (p->IsExecuting())
+        {
+            pendingField = name;
+            return;
+        }
+        UseReadField(name);
+    }
+    void UseReadField(const string &name)
+    {
+        Pipeline *p = plot->pipe;
+        if (!p)
+            return;
+
+        // now find out where it ended up; prefer the nodal version
+        DSInfo dsinfo = p->GetVariables(-1);
+        string cellset = "";
+        bool found = false;
+        for (int i=0; i<dsinfo.nodalfields.size() && !found; ++i)
+            found = (dsinfo.nodalfields[i].name == name);
+        for (int k=0; k<dsinfo.cellsets.size() && !found; ++k)
+        {
+            vector<FieldInfo> &csf = dsinfo.cellsetfields[dsinfo.cellsets[k].name];
+            for (int i=0; i<csf.size() && !found; ++i)
+            {
+                if (csf[i].name == name)
+                {
+                    cellset = dsinfo.cellsets[k].name;
+                    found = true;
+                }
+            }
+        }
+        if (!found)
+            return;
+
+        plot->cellset = cellset;
+        plot->field = name;
+
+        // we're inside the tree's selection signal, so don't
+        // tear it down until we get back to the event loop
+        QMetaObject::invokeMethod(this, "RebuildVarChooser",
+                                  Qt::QueuedConnection);
+        emit SomethingChanged();
+    }
   signals:
     void SomethingChanged();
 };
@@ -0,0 +1,34 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EL_WINDOW_H
+#define EL_WINDOW_H
+
+class WindowAttributes;
+
+// ****************************************************************************
+// Class:  ELWindow
+//
+// Purpose:
+///   What the window manager needs from any window it puts in a frame,
+///   beyond it being a QWidget, so it can save and restore them
+///   without knowing their types.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class ELWindow
+{
+  public:
+    virtual ~ELWindow()
+    {
+    }
+    /// Add this window's settings to its part of a session.
+    virtual void SaveSession(WindowAttributes *atts) = 0;
+    /// Replace this window's settings with those from a session.
+    virtual void RestoreSession(WindowAttributes *atts) = 0;
+    /// Let go of everything that refers to a pipeline, since they're
+    /// about to be deleted.
+    virtual void ForgetPipelines() = 0;
+};
+
+#endif
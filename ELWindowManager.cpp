@@ -17,6 +17,8 @@
 #include "EL1DWindow.h"
 #include "ELPolarWindow.h"
 #include "ELEmptyWindow.h"
+#include "SessionAttributes.h"
+#include "ELWindow.h"
 
 struct Arrangement
 {
@@ -599,10 +601,114 @@ ELWindowManager::ChangeWindowType(int index, const QString &type)
     else
     {
         cerr << "sorry, didn't implement window type "<<type.toStdString()<<" yet\n";
+        return;
     }
+    windowTypes[index] = type.toStdString();
     ///\todo: hack to set the combo box when called from a client
     /// instead o as a signal from the frame itself
     if (!sender())
         windowframes[index]->WindowTypeChanged(type);
 }
 
+// ****************************************************************************
+// Method:  ELWindowManager::SaveSession
+//
+// Purpose:
+///   Add the arrangement and the visible windows to a session.
+//
+// Arguments:
+//   atts       the session
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELWindowManager::SaveSession(SessionAttributes *atts)
+{
+    if (arrangementIndex < 0)
+        return;
+
+    Arrangement &a = arrangements[arrangementIndex];
+    atts->arrangement = a.name;
+    for (int i=0; i<a.n; i++)
+    {
+        WindowAttributes *w = new WindowAttributes;
+        w->type = windowTypes[i];
+        ELWindow *win = dynamic_cast<ELWindow*>(GetWindow(i));
+        if (win)
+            win->SaveSession(w);
+        atts->windows.push_back(w);
+    }
+}
+
+// ****************************************************************************
+// Method:  ELWindowManager::RestoreSession
+//
+// Purpose:
+///   Set the arrangement from a session and replace its windows with
+///   new ones of the saved types, plots and cameras.  The session's
+///   pipelines must already be in Pipeline::allPipelines.
+//
+// Arguments:
+//   atts       the session
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELWindowManager::RestoreSession(SessionAttributes *atts)
+{
+    SetArrangement(atts->arrangement);
+    if (arrangementIndex < 0)
+        SetArrangement("1");
+
+    Arrangement &a = arrangements[arrangementIndex];
+    for (int i=0; i<a.n; i++)
+    {
+        WindowAttributes *w = (i < (int)atts->windows.size()) ? atts->windows[i] : NULL;
+        if (!w || w->type == "")
+        {
+            ///\todo: the frame's type chooser can't go back to "(empty)"
+            windowframes[i]->SetWindow(new ELEmptyWindow(this));
+            settings[i] = NULL;
+            windowTypes[i] = "";
+            emit WindowAdded(windowframes[i]->GetWindow());
+            continue;
+        }
+
+        ChangeWindowType(i, w->type.c_str());
+        ELWindow *win = dynamic_cast<ELWindow*>(GetWindow(i));
+        if (win)
+            win->RestoreSession(w);
+    }
+
+    // show the settings of the new window, if any
+    if (activeWindow >= 0 && activeWindow < a.n)
+        SetActiveWindowFrame(windowframes[activeWindow]);
+}
+
+// ****************************************************************************
+// Method:  ELWindowManager::ForgetPipelines
+//
+// Purpose:
+///   Slot to make every window, including those the arrangement hides,
+///   let go of the pipelines before they're deleted.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+ELWindowManager::ForgetPipelines()
+{
+    for (int i=0; i<MAX_WINDOWS; i++)
+    {
+        if (!windowframes[i])
+            continue;
+        ELWindow *win = dynamic_cast<ELWindow*>(windowframes[i]->GetWindow());
+        if (win)
+            win->ForgetPipelines();
+    }
+}
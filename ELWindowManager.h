@@ -8,6 +8,8 @@
 
 #include "ELWindowFrame.h"
 
+class SessionAttributes;
+
 // ****************************************************************************
 // Class:  ELWindowManager
 //
@@ -27,6 +29,7 @@ class ELWindowManager : public QWidget
 
     ELWindowFrame *windowframes[MAX_WINDOWS];
     QWidget *settings[MAX_WINDOWS];
+    std::string windowTypes[MAX_WINDOWS];
     int arrangementIndex;
 
     QGridLayout *windowLayout;
@@ -42,10 +45,13 @@ class ELWindowManager : public QWidget
     void SetActiveWindowFrame(ELWindowFrame *);
     void SetWindow(int index, QWidget *, QWidget *);
     QWidget *GetWindow(int index);
+    void SaveSession(SessionAttributes *atts);
+    void RestoreSession(SessionAttributes *atts);
 
   public slots:
     void arrangementChosen();
     void ChangeWindowType(int, const QString &);
+    void ForgetPipelines();
 };
 
 #endif
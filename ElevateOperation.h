@@ -10,6 +10,7 @@ class ElevateAttributes : public Attribute
     string field;
   public:
     virtual const char *GetType() {return "ElevateAttributes";}
+    static Attribute *Create() { return new ElevateAttributes; }
     ElevateAttributes() : Attribute()
     {
         field = "(default)";
@@ -34,6 +35,11 @@ class ElevateOperation : public Operation
         atts = new ElevateAttributes;
         mutator = new eavlElevateMutator;
     }
+    virtual ~ElevateOperation()
+    {
+        delete atts;
+        delete mutator;
+    }
     virtual std::string GetOperationName()
     {
         return "Elevate";
@@ -61,10 +67,15 @@ class ElevateOperation : public Operation
     {
         return std::vector<std::string>();
     }
+    virtual bool ModifiesCoordinates()
+    {
+        return true;
+    }
     virtual void Execute()
     {
         mutator->SetDataSet(input);
         mutator->SetField(atts->field);
+        FilterLock lock;
         mutator->Execute();
         output = input;
     }
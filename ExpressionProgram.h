@@ -0,0 +1,470 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef EXPRESSION_PROGRAM_H
+#define EXPRESSION_PROGRAM_H
+
+#include "STL.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <eavlArray.h>
+#include <eavlException.h>
+#include <eavlFloatArray.h>
+
+// ****************************************************************************
+// Class:  ExpressionProgram
+//
+// Purpose:
+///   An arithmetic expression over fields, compiled to a flat stack
+///   program which is run over blocks of values at a time.  Each
+///   instruction is a simple loop over the whole block, so there's one
+///   dispatch per instruction per block rather than per value, and the
+///   loops can be vectorized.  The only temporaries are the fixed
+///   stack of blocks.
+///
+///   The syntax is the usual one: numbers, scalar field names (a
+///   component of others is picked with name[i]), + - * / ^ (power,
+///   right associative), unary minus, parentheses, the one-argument
+///   functions sqrt abs exp log log10 sin cos tan asin acos atan floor
+///   ceil, and the two-argument functions min max pow atan2.
+///   mag(name) is the magnitude of a vector field.  A field name that isn't a plain identifier
+///   can be quoted with single quotes.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class ExpressionProgram
+{
+  public:
+    enum { BlockSize = 1024 };
+
+  protected:
+    enum OpCode
+    {
+        PushConst, PushField, PushMag,
+        Neg, Add, Sub, Mul, Div, Pow, Min, Max, Atan2,
+        Sqrt, Abs, Exp, Log, Log10, Sin, Cos, Tan,
+        Asin, Acos, Atan, Floor, Ceil
+    };
+    struct Instruction
+    {
+        OpCode op;
+        int    var;        ///< index into variables, for the pushes
+        int    component;  ///< for PushField; -1 if the field is a scalar
+        float  value;      ///< for PushConst
+    };
+
+    std::vector<Instruction> code;
+    std::vector<std::string> variables;
+    int                      maxDepth;
+
+    // parsing state
+    std::string              text;
+    size_t                   pos;
+    int                      depth;
+
+  public:
+    ExpressionProgram() : maxDepth(0)
+    {
+    }
+    /// Compile an expression, throwing an eavlException if it's bad.
+    void Compile(const std::string &expr)
+    {
+        code.clear();
+        variables.clear();
+        maxDepth = 0;
+        text = expr;
+        pos = 0;
+        depth = 0;
+        ParseSum();
+        SkipSpace();
+        if (pos != text.size())
+            Error("unexpected '" + text.substr(pos, 1) + "'");
+    }
+    /// The fields used, in the order Execute wants their arrays.
+    const std::vector<std::string> &GetVariables() { return variables; }
+
+    /// Evaluate for n tuples of the given arrays (one per variable),
+    /// writing the result into out.
+    void Execute(const std::vector<eavlArray*> &arrays, int n, float *out)
+    {
+        std::vector<const float*> hosts(arrays.size(), (const float*)NULL);
+        std::vector<int> ncomps(arrays.size());
+        for (size_t i=0; i<arrays.size(); i++)
+        {
+            eavlFloatArray *fa = dynamic_cast<eavlFloatArray*>(arrays[i]);
+            if (fa)
+                hosts[i] = fa->GetHostArray();
+            ncomps[i] = arrays[i]->GetNumberOfComponents();
+        }
+        for (size_t i=0; i<code.size(); i++)
+        {
+            if (code[i].op != PushField)
+                continue;
+            const std::string &name = variables[code[i].var];
+            if (code[i].component < 0 && ncomps[code[i].var] != 1)
+                Error(name + " isn't a scalar; use " + name + "[i] or "
+                      "mag(" + name + ")");
+            if (code[i].component >= ncomps[code[i].var])
+                Error(name + " has no such component");
+        }
+        std::vector<float> stackStorage(std::max(maxDepth, 1) * BlockSize);
+        float *stack = &stackStorage[0];
+
+        for (int start=0; start<n; start+=BlockSize)
+        {
+            int len = std::min((int)BlockSize, n - start);
+            int top = -1;
+            for (size_t i=0; i<code.size(); i++)
+            {
+                const Instruction &in = code[i];
+                float *a = stack + std::max(top, 0)*BlockSize;    // top
+                float *b = stack + std::max(top-1, 0)*BlockSize;  // below it
+                switch (in.op)
+                {
+                  case PushConst:
+                    {
+                        float *r = stack + (++top)*BlockSize;
+                        for (int j=0; j<len; j++)
+                            r[j] = in.value;
+                    }
+                    break;
+                  case PushField:
+                  case PushMag:
+                    {
+                        float *r = stack + (++top)*BlockSize;
+                        Load(in, arrays[in.var], hosts[in.var],
+                             ncomps[in.var], start, len, r);
+                    }
+                    break;
+                  case Neg:
+                    for (int j=0; j<len; j++)
+                        a[j] = -a[j];
+                    break;
+                  case Add:
+                    for (int j=0; j<len; j++)
+                        b[j] = b[j] + a[j];
+                    top--;
+                    break;
+                  case Sub:
+                    for (int j=0; j<len; j++)
+                        b[j] = b[j] - a[j];
+                    top--;
+                    break;
+                  case Mul:
+                    for (int j=0; j<len; j++)
+                        b[j] = b[j] * a[j];
+                    top--;
+                    break;
+                  case Div:
+                    for (int j=0; j<len; j++)
+                        b[j] = b[j] / a[j];
+                    top--;
+                    break;
+                  case Pow:
+                    for (int j=0; j<len; j++)
+                        b[j] = powf(b[j], a[j]);
+                    top--;
+                    break;
+                  case Min:
+                    for (int j=0; j<len; j++)
+                        b[j] = (a[j] < b[j]) ? a[j] : b[j];
+                    top--;
+                    break;
+                  case Max:
+                    for (int j=0; j<len; j++)
+                        b[j] = (a[j] > b[j]) ? a[j] : b[j];
+                    top--;
+                    break;
+                  case Atan2:
+                    for (int j=0; j<len; j++)
+                        b[j] = atan2f(b[j], a[j]);
+                    top--;
+                    break;
+                  case Sqrt:  for (int j=0; j<len; j++) a[j] = sqrtf(a[j]);  break;
+                  case Abs:   for (int j=0; j<len; j++) a[j] = fabsf(a[j]);  break;
+                  case Exp:   for (int j=0; j<len; j++) a[j] = expf(a[j]);   break;
+                  case Log:   for (int j=0; j<len; j++) a[j] = logf(a[j]);   break;
+                  case Log10: for (int j=0; j<len; j++) a[j] = log10f(a[j]); break;
+                  case Sin:   for (int j=0; j<len; j++) a[j] = sinf(a[j]);   break;
+                  case Cos:   for (int j=0; j<len; j++) a[j] = cosf(a[j]);   break;
+                  case Tan:   for (int j=0; j<len; j++) a[j] = tanf(a[j]);   break;
+                  case Asin:  for (int j=0; j<len; j++) a[j] = asinf(a[j]);  break;
+                  case Acos:  for (int j=0; j<len; j++) a[j] = acosf(a[j]);  break;
+                  case Atan:  for (int j=0; j<len; j++) a[j] = atanf(a[j]);  break;
+                  case Floor: for (int j=0; j<len; j++) a[j] = floorf(a[j]); break;
+                  case Ceil:  for (int j=0; j<len; j++) a[j] = ceilf(a[j]);  break;
+                }
+            }
+            memcpy(out + start, stack, len*sizeof(float));
+        }
+    }
+
+  protected:
+    /// Fill a block with a component (or the magnitude) of an array.
+    /// Float arrays are read directly; others go through the generic
+    /// accessor.
+    static void Load(const Instruction &in, eavlArray *array,
+                     const float *host, int nc, int start, int len, float *r)
+    {
+        if (in.op == PushField)
+        {
+            int c = std::max(in.component, 0);
+            if (host)
+            {
+                const float *p = host + start*nc + c;
+                if (nc == 1)
+                    memcpy(r, p, len*sizeof(float));
+                else
+                    for (int j=0; j<len; j++)
+                        r[j] = p[j*nc];
+            }
+            else
+            {
+                for (int j=0; j<len; j++)
+                    r[j] = array->GetComponentAsDouble(start+j, c);
+            }
+            return;
+        }
+
+        for (int j=0; j<len; j++)
+            r[j] = 0;
+        for (int c=0; c<nc; c++)
+        {
+            if (host)
+            {
+                const float *p = host + start*nc + c;
+                for (int j=0; j<len; j++)
+                    r[j] += p[j*nc] * p[j*nc];
+            }
+            else
+            {
+                for (int j=0; j<len; j++)
+                {
+                    float x = array->GetComponentAsDouble(start+j, c);
+                    r[j] += x * x;
+                }
+            }
+        }
+        for (int j=0; j<len; j++)
+            r[j] = sqrtf(r[j]);
+    }
+
+    void Error(const std::string &msg)
+    {
+        throw eavlException("Calculator: " + msg + " in \"" + text + "\"");
+    }
+    void SkipSpace()
+    {
+        while (pos < text.size() && isspace(text[pos]))
+            pos++;
+    }
+    bool Accept(char c)
+    {
+        SkipSpace();
+        if (pos < text.size() && text[pos] == c)
+        {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+    void Expect(char c)
+    {
+        if (!Accept(c))
+            Error(std::string("expected '") + c + "'");
+    }
+    void Emit(OpCode op, int pushes = 0, float value = 0,
+              int var = -1, int component = 0)
+    {
+        Instruction in;
+        in.op = op;
+        in.value = value;
+        in.var = var;
+        in.component = component;
+        code.push_back(in);
+        depth += pushes;
+        maxDepth = std::max(maxDepth, depth);
+    }
+    int Variable(const std::string &name)
+    {
+        for (size_t i=0; i<variables.size(); i++)
+            if (variables[i] == name)
+                return i;
+        variables.push_back(name);
+        return variables.size() - 1;
+    }
+    std::string ParseName()
+    {
+        SkipSpace();
+        size_t start = pos;
+        if (pos < text.size() && text[pos] == '\'')
+        {
+            size_t end = text.find('\'', pos+1);
+            if (end == std::string::npos)
+                Error("unterminated quote");
+            pos = end + 1;
+            return text.substr(start+1, end-start-1);
+        }
+        while (pos < text.size() &&
+               (isalnum(text[pos]) || text[pos] == '_'))
+            pos++;
+        if (pos == start)
+            Error("expected a name");
+        return text.substr(start, pos-start);
+    }
+
+    void ParseSum()
+    {
+        ParseProduct();
+        while (true)
+        {
+            if (Accept('+'))
+            {
+                ParseProduct();
+                Emit(Add, -1);
+            }
+            else if (Accept('-'))
+            {
+                ParseProduct();
+                Emit(Sub, -1);
+            }
+            else
+                break;
+        }
+    }
+    void ParseProduct()
+    {
+        ParseUnary();
+        while (true)
+        {
+            if (Accept('*'))
+            {
+                ParseUnary();
+                Emit(Mul, -1);
+            }
+            else if (Accept('/'))
+            {
+                ParseUnary();
+                Emit(Div, -1);
+            }
+            else
+                break;
+        }
+    }
+    void ParseUnary()
+    {
+        if (Accept('-'))
+        {
+            ParseUnary();
+            Emit(Neg);
+        }
+        else if (Accept('+'))
+        {
+            ParseUnary();
+        }
+        else
+        {
+            ParsePower();
+        }
+    }
+    void ParsePower()
+    {
+        ParsePrimary();
+        if (Accept('^'))
+        {
+            ParseUnary();
+            Emit(Pow, -1);
+        }
+    }
+    void ParsePrimary()
+    {
+        SkipSpace();
+        if (pos >= text.size())
+            Error("unexpected end");
+
+        char c = text[pos];
+        if (isdigit(c) || c == '.')
+        {
+            const char *begin = text.c_str() + pos;
+            char *end;
+            double v = strtod(begin, &end);
+            if (end == begin)
+                Error("bad number");
+            pos += end - begin;
+            Emit(PushConst, 1, v);
+            return;
+        }
+        if (Accept('('))
+        {
+            ParseSum();
+            Expect(')');
+            return;
+        }
+
+        bool quoted = (c == '\'');
+        std::string name = ParseName();
+        if (!quoted && Accept('('))
+        {
+            ParseCall(name);
+            return;
+        }
+        int component = -1;
+        if (Accept('['))
+        {
+            SkipSpace();
+            const char *begin = text.c_str() + pos;
+            char *end;
+            component = strtol(begin, &end, 10);
+            if (end == begin || component < 0)
+                Error("bad component of " + name);
+            pos += end - begin;
+            Expect(']');
+        }
+        Emit(PushField, 1, 0, Variable(name), component);
+    }
+    void ParseCall(const std::string &fn)
+    {
+        static const char *unary[] = {"sqrt", "abs", "exp", "log", "log10",
+                                      "sin", "cos", "tan", "asin", "acos",
+                                      "atan", "floor", "ceil", NULL};
+        static const OpCode unaryOps[] = {Sqrt, Abs, Exp, Log, Log10,
+                                          Sin, Cos, Tan, Asin, Acos,
+                                          Atan, Floor, Ceil};
+        static const char *binary[] = {"min", "max", "pow", "atan2", NULL};
+        static const OpCode binaryOps[] = {Min, Max, Pow, Atan2};
+
+        if (fn == "mag")
+        {
+            Emit(PushMag, 1, 0, Variable(ParseName()));
+            Expect(')');
+            return;
+        }
+        for (int i=0; unary[i]; i++)
+        {
+            if (fn == unary[i])
+            {
+                ParseSum();
+                Expect(')');
+                Emit(unaryOps[i]);
+                return;
+            }
+        }
+        for (int i=0; binary[i]; i++)
+        {
+            if (fn == binary[i])
+            {
+                ParseSum();
+                Expect(',');
+                ParseSum();
+                Expect(')');
+                Emit(binaryOps[i], -1);
+                return;
+            }
+        }
+        Error("unknown function " + fn);
+    }
+};
+
+#endif
@@ -18,6 +18,10 @@
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Run the EAVL mutator under a FilterLock.
+//
+//   Delete the mutator in the destructor.
+//
 // ****************************************************************************
 class ExternalFaceOperation : public Operation
 {
@@ -29,6 +33,10 @@ class ExternalFaceOperation : public Operation
     {
         mutator = new eavlExternalFaceMutator;
     }
+    virtual ~ExternalFaceOperation()
+    {
+        delete mutator;
+    }
     virtual std::string GetOperationName()
     {
         return "ExternalFace";
@@ -50,6 +58,7 @@ class ExternalFaceOperation : public Operation
         mutator->SetDataSet(input);
         ///\todo: assuming last cell set
         mutator->SetCellSet(input->GetCellSet(input->GetNumCellSets()-1)->GetName());
+        FilterLock lock;
         mutator->Execute();
         output = input;
     }
@@ -0,0 +1,462 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef FIELD_GRADIENT_H
+#define FIELD_GRADIENT_H
+
+#include "STL.h"
+#include <algorithm>
+#include <cmath>
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <eavlCellSet.h>
+#include <eavlCellSetAllStructured.h>
+#include <eavlCoordinates.h>
+#include <eavlDataSet.h>
+#include <eavlField.h>
+#include <eavlFloatArray.h>
+#include <eavlLogicalStructureRegular.h>
+
+// ****************************************************************************
+// Class:  FieldGradient
+//
+// Purpose:
+///   Computes the gradient of each component of a nodal field, at the
+///   nodes.  The result has 3 values per component per node:
+///   d(component c)/d(x_d) is at [(node*ncomps + c)*3 + d].
+///
+///   On a 3D structured grid it's central differences (one-sided at
+///   the edges) in logical space, mapped to x,y,z by each node's
+///   Jacobian, or by just the axis spacing if the grid is
+///   rectilinear.  The nodes are visited in index order, a row of i
+///   at a time, so the stencil streams through memory.
+///
+///   Otherwise each cell gets a least squares fit of a linear
+///   function to its nodes' values (exact for linear cells), and each
+///   node averages the gradients of the cells using it.  For surface
+///   and line cells the fit is regularized, which leaves out the part
+///   of the gradient normal to the cell.
+///
+///   Like CellSelection, the work is done by threads from the global
+///   pool grabbing blocks of rows, cells or nodes, with the calling
+///   thread working too.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FieldGradient
+{
+  protected:
+    enum { BlockSize = 4096 };
+    enum Pass { Gather, Rows, Cells, Nodes };
+
+    class Task : public QRunnable
+    {
+      public:
+        FieldGradient *gradient;
+        Pass           pass;
+        QSemaphore    *done;
+        virtual void run()
+        {
+            gradient->Work(pass);
+            done->release();
+        }
+    };
+
+    eavlDataSet        *input;
+    eavlCellSet        *cellset;
+    eavlArray          *array;
+    int                 ncomps;
+    int                 npts;
+    int                 nthreads;
+    int                 nitems;
+    int                 nblocks;
+    QAtomicInt          nextBlock;
+
+    const float        *values;     ///< the field, npts*ncomps
+    std::vector<float>  copied;     ///< if it isn't a float array
+    std::vector<double> points;     ///< npts*3, unless rectilinear
+    std::vector<float>  result;
+
+    // structured grids
+    bool                structured;
+    bool                rectilinear;
+    int                 dims[3];
+    std::vector<double> axes[3];
+
+    // unstructured: per cell gradients, and the cells using each node
+    std::vector<float>  cellGrads;
+    std::vector<int>    nodeCellStart;
+    std::vector<int>    nodeCells;
+
+  public:
+    FieldGradient(eavlDataSet *ds, eavlCellSet *cs, eavlField *f)
+        : input(ds), cellset(cs), array(f->GetArray()), values(NULL),
+          structured(false), rectilinear(false)
+    {
+        ncomps = array->GetNumberOfComponents();
+        npts = ds->GetNumPoints();
+        eavlFloatArray *fa = dynamic_cast<eavlFloatArray*>(array);
+        if (fa)
+            values = fa->GetHostArray();
+    }
+
+    /// Compute the gradient, using up to maxThreads threads (0 for as
+    /// many as there are cores).
+    void Execute(int maxThreads = 0)
+    {
+        nthreads = QThread::idealThreadCount();
+        if (maxThreads > 0)
+            nthreads = std::min(nthreads, maxThreads);
+
+        FindStructure();
+        if (!values)
+            copied.resize(npts * ncomps);
+        if (!rectilinear)
+            points.resize(npts * 3);
+        if (!values || !rectilinear)
+            RunPass(Gather, npts);
+        if (!values)
+            values = &copied[0];
+
+        result.assign(npts * ncomps * 3, 0.f);
+        if (structured)
+        {
+            RunPass(Rows, dims[1] * dims[2]);
+        }
+        else
+        {
+            int ncells = cellset->GetNumCells();
+            if (ncells > 0)
+                cellset->GetCellNodes(0);
+            BuildNodeCells(ncells);
+            cellGrads.resize(ncells * ncomps * 3);
+            RunPass(Cells, ncells);
+            RunPass(Nodes, npts);
+            cellGrads.clear();
+            nodeCellStart.clear();
+            nodeCells.clear();
+        }
+        points.clear();
+        copied.clear();
+    }
+
+    int GetNumComponents() { return ncomps; }
+    std::vector<float> &GetResult() { return result; }
+
+  protected:
+    /// Check for a 3D structured grid, and whether its coordinates
+    /// are an axis per logical dimension.
+    void FindStructure()
+    {
+        eavlLogicalStructureRegular *log =
+            dynamic_cast<eavlLogicalStructureRegular*>(input->GetLogicalStructure());
+        if (!log || !dynamic_cast<eavlCellSetAllStructured*>(cellset))
+            return;
+        eavlRegularStructure reg = log->GetRegularStructure();
+        if (reg.dimension != 3)
+            return;
+        for (int d=0; d<3; d++)
+        {
+            dims[d] = reg.nodeDims[d];
+            if (dims[d] < 2)
+                return;
+        }
+        structured = true;
+
+        eavlCoordinatesCartesian *coords = (input->GetNumCoordinateSystems() < 1)
+            ? NULL
+            : dynamic_cast<eavlCoordinatesCartesian*>(input->GetCoordinateSystem(0));
+        if (!coords || coords->GetDimension() != 3)
+            return;
+        for (int d=0; d<3; d++)
+        {
+            eavlCoordinateAxisField *af =
+                dynamic_cast<eavlCoordinateAxisField*>(coords->GetAxis(d));
+            if (!af || input->GetFieldIndex(af->GetFieldName()) < 0)
+                return;
+            eavlField *f = input->GetField(af->GetFieldName());
+            if (f->GetAssociation() != eavlField::ASSOC_LOGICALDIM ||
+                f->GetAssocLogicalDim() != d)
+                return;
+        }
+        for (int d=0; d<3; d++)
+        {
+            eavlCoordinateAxisField *af =
+                dynamic_cast<eavlCoordinateAxisField*>(coords->GetAxis(d));
+            eavlArray *a = input->GetField(af->GetFieldName())->GetArray();
+            axes[d].resize(dims[d]);
+            for (int i=0; i<dims[d]; i++)
+                axes[d][i] = a->GetComponentAsDouble(i, af->GetComponent());
+        }
+        rectilinear = true;
+    }
+
+    /// The cells using each node, in compressed rows.
+    void BuildNodeCells(int ncells)
+    {
+        nodeCellStart.assign(npts+1, 0);
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cellset->GetCellNodes(c);
+            for (int j=0; j<cell.numIndices; j++)
+                nodeCellStart[cell.indices[j]+1]++;
+        }
+        for (int i=0; i<npts; i++)
+            nodeCellStart[i+1] += nodeCellStart[i];
+        nodeCells.resize(nodeCellStart[npts]);
+        std::vector<int> fill(nodeCellStart.begin(), nodeCellStart.end()-1);
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cellset->GetCellNodes(c);
+            for (int j=0; j<cell.numIndices; j++)
+                nodeCells[fill[cell.indices[j]]++] = c;
+        }
+    }
+
+    void RunPass(Pass pass, int n)
+    {
+        nitems = n;
+        nblocks = (n + BlockSize - 1) / BlockSize;
+        if (pass == Rows)
+        {
+            // rows are already a few thousand nodes each
+            nblocks = n;
+        }
+        int nt = std::max(1, std::min(nthreads, nblocks/4));
+
+        nextBlock = 0;
+        QSemaphore done;
+        int started = 0;
+        for (int t=1; t<nt; t++)
+        {
+            Task *task = new Task;
+            task->gradient = this;
+            task->pass = pass;
+            task->done = &done;
+            if (!QThreadPool::globalInstance()->tryStart(task))
+            {
+                delete task;
+                break;
+            }
+            started++;
+        }
+        Work(pass);
+        done.acquire(started);
+    }
+
+    void Work(Pass pass)
+    {
+        while (true)
+        {
+            int block = nextBlock.fetchAndAddOrdered(1);
+            if (block >= nblocks)
+                break;
+            if (pass == Rows)
+            {
+                Row(block % dims[1], block / dims[1]);
+                continue;
+            }
+            int start = block * BlockSize;
+            int end = std::min(nitems, start + BlockSize);
+            for (int i=start; i<end; i++)
+            {
+                switch (pass)
+                {
+                  case Gather: GatherNode(i); break;
+                  case Cells:  Cell(i);       break;
+                  case Nodes:  Node(i);       break;
+                  default:                    break;
+                }
+            }
+        }
+    }
+
+    void GatherNode(int i)
+    {
+        if (!points.empty())
+        {
+            for (int d=0; d<3; d++)
+                points[3*i+d] = input->GetPoint(i, d);
+        }
+        if (!copied.empty())
+        {
+            for (int c=0; c<ncomps; c++)
+                copied[i*ncomps+c] = array->GetComponentAsDouble(i, c);
+        }
+    }
+
+    /// Invert a 3x3 matrix; returns false if it's singular.
+    static bool Invert(const double m[3][3], double inv[3][3])
+    {
+        inv[0][0] = m[1][1]*m[2][2] - m[1][2]*m[2][1];
+        inv[0][1] = m[0][2]*m[2][1] - m[0][1]*m[2][2];
+        inv[0][2] = m[0][1]*m[1][2] - m[0][2]*m[1][1];
+        inv[1][0] = m[1][2]*m[2][0] - m[1][0]*m[2][2];
+        inv[1][1] = m[0][0]*m[2][2] - m[0][2]*m[2][0];
+        inv[1][2] = m[0][2]*m[1][0] - m[0][0]*m[1][2];
+        inv[2][0] = m[1][0]*m[2][1] - m[1][1]*m[2][0];
+        inv[2][1] = m[0][1]*m[2][0] - m[0][0]*m[2][1];
+        inv[2][2] = m[0][0]*m[1][1] - m[0][1]*m[1][0];
+        double det = m[0][0]*inv[0][0] + m[0][1]*inv[1][0] + m[0][2]*inv[2][0];
+        if (det == 0)
+            return false;
+        for (int r=0; r<3; r++)
+            for (int c=0; c<3; c++)
+                inv[r][c] /= det;
+        return true;
+    }
+
+    /// Differences along the i row at logical (j,k).
+    void Row(int j, int k)
+    {
+        const int nx = dims[0], ny = dims[1], nz = dims[2];
+        const int stride[3] = {1, nx, nx*ny};
+        const int index[3] = {0, j, k};
+        const int row = (k*ny + j) * nx;
+
+        // the j and k neighbors are fixed along the row
+        int lo[3], hi[3];
+        for (int l=1; l<3; l++)
+        {
+            int n = (l == 1) ? ny : nz;
+            lo[l] = (index[l] > 0)   ? -stride[l] : 0;
+            hi[l] = (index[l] < n-1) ?  stride[l] : 0;
+        }
+        double dj = 0, dk = 0;
+        if (rectilinear)
+        {
+            dj = axes[1][j + hi[1]/stride[1]] - axes[1][j + lo[1]/stride[1]];
+            dk = axes[2][k + hi[2]/stride[2]] - axes[2][k + lo[2]/stride[2]];
+        }
+
+        for (int i=0; i<nx; i++)
+        {
+            int node = row + i;
+            lo[0] = (i > 0)    ? -1 : 0;
+            hi[0] = (i < nx-1) ?  1 : 0;
+            float *g = &result[node*ncomps*3];
+
+            if (rectilinear)
+            {
+                double dx[3] = {axes[0][i+hi[0]] - axes[0][i+lo[0]], dj, dk};
+                for (int c=0; c<ncomps; c++)
+                {
+                    for (int l=0; l<3; l++)
+                    {
+                        double df = values[(node+hi[l])*ncomps+c] -
+                                    values[(node+lo[l])*ncomps+c];
+                        g[3*c+l] = df / dx[l];
+                    }
+                }
+                continue;
+            }
+
+            // jac[a][l] = d(x_a)/d(logical l), up to a factor that
+            // cancels
+            double jac[3][3], inv[3][3];
+            for (int l=0; l<3; l++)
+            {
+                int scale = (hi[l] - lo[l]) / stride[l];
+                for (int a=0; a<3; a++)
+                    jac[a][l] = (points[3*(node+hi[l])+a] -
+                                 points[3*(node+lo[l])+a]) / scale;
+            }
+            if (!Invert(jac, inv))
+                continue;
+            for (int c=0; c<ncomps; c++)
+            {
+                double df[3];
+                for (int l=0; l<3; l++)
+                {
+                    int scale = (hi[l] - lo[l]) / stride[l];
+                    df[l] = (values[(node+hi[l])*ncomps+c] -
+                             values[(node+lo[l])*ncomps+c]) / scale;
+                }
+                // df/dl = sum_a grad_a * jac[a][l]
+                for (int a=0; a<3; a++)
+                    g[3*c+a] = df[0]*inv[0][a] + df[1]*inv[1][a] + df[2]*inv[2][a];
+            }
+        }
+    }
+
+    /// Least squares gradient of one cell.
+    void Cell(int cellIndex)
+    {
+        eavlCell cell = cellset->GetCellNodes(cellIndex);
+        float *g = &cellGrads[cellIndex*ncomps*3];
+        int n = cell.numIndices;
+        if (n < 2)
+        {
+            std::fill(g, g + ncomps*3, 0.f);
+            return;
+        }
+
+        double center[3] = {0,0,0};
+        for (int j=0; j<n; j++)
+            for (int d=0; d<3; d++)
+                center[d] += points[3*cell.indices[j]+d];
+        for (int d=0; d<3; d++)
+            center[d] /= n;
+
+        double m[3][3] = {{0,0,0},{0,0,0},{0,0,0}};
+        for (int j=0; j<n; j++)
+        {
+            const double *p = &points[3*cell.indices[j]];
+            double r[3] = {p[0]-center[0], p[1]-center[1], p[2]-center[2]};
+            for (int a=0; a<3; a++)
+                for (int b=0; b<3; b++)
+                    m[a][b] += r[a]*r[b];
+        }
+        // a little bit of regularization for flat cells
+        double eps = 1e-9 * (m[0][0] + m[1][1] + m[2][2]);
+        for (int a=0; a<3; a++)
+            m[a][a] += eps;
+        double inv[3][3];
+        if (!Invert(m, inv))
+        {
+            std::fill(g, g + ncomps*3, 0.f);
+            return;
+        }
+
+        for (int c=0; c<ncomps; c++)
+        {
+            double mean = 0;
+            for (int j=0; j<n; j++)
+                mean += values[cell.indices[j]*ncomps+c];
+            mean /= n;
+            double b[3] = {0,0,0};
+            for (int j=0; j<n; j++)
+            {
+                const double *p = &points[3*cell.indices[j]];
+                double df = values[cell.indices[j]*ncomps+c] - mean;
+                for (int d=0; d<3; d++)
+                    b[d] += (p[d]-center[d]) * df;
+            }
+            for (int a=0; a<3; a++)
+                g[3*c+a] = inv[a][0]*b[0] + inv[a][1]*b[1] + inv[a][2]*b[2];
+        }
+    }
+
+    /// Average of the gradients of a node's cells.
+    void Node(int node)
+    {
+        int start = nodeCellStart[node], end = nodeCellStart[node+1];
+        if (start == end)
+            return;
+        float *g = &result[node*ncomps*3];
+        for (int i=start; i<end; i++)
+        {
+            const float *cg = &cellGrads[nodeCells[i]*ncomps*3];
+            for (int v=0; v<ncomps*3; v++)
+                g[v] += cg[v];
+        }
+        float scale = 1.f / (end - start);
+        for (int v=0; v<ncomps*3; v++)
+            g[v] *= scale;
+    }
+};
+
+#endif
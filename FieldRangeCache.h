@@ -0,0 +1,75 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef FIELD_RANGE_CACHE_H
+#define FIELD_RANGE_CACHE_H
+
+#include "STL.h"
+#include <QMutex>
+#include <QMutexLocker>
+#include "eavlArray.h"
+
+struct FieldRange
+{
+    double minval;
+    double maxval;
+    double minmag;
+    double maxmag;
+};
+
+// ****************************************************************************
+// Class:  FieldRangeCache
+//
+// Purpose:
+///   The component-wise and magnitude ranges of arrays, so the GUI's
+///   variable lists, histograms, isosurface levels, etc. don't each
+///   rescan the same array.  Pipeline stages share arrays they don't
+///   change, so these stay valid; the pipeline forgets the arrays in
+///   each new result, since filters may reuse (and rewrite) their
+///   output arrays from one execution to the next.
+///
+///   All methods are safe to call from the chunk threads.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FieldRangeCache
+{
+  protected:
+    std::map<eavlArray*, FieldRange> ranges;
+    QMutex                           mutex;
+
+  public:
+    FieldRange GetRange(eavlArray *a)
+    {
+        {
+            QMutexLocker lock(&mutex);
+            std::map<eavlArray*, FieldRange>::iterator it = ranges.find(a);
+            if (it != ranges.end())
+                return it->second;
+        }
+
+        FieldRange r;
+        r.minval = a->GetComponentWiseMin();
+        r.maxval = a->GetComponentWiseMax();
+        r.minmag = a->GetMagnitudeMin();
+        r.maxmag = a->GetMagnitudeMax();
+
+        QMutexLocker lock(&mutex);
+        ranges[a] = r;
+        return r;
+    }
+
+    void Forget(eavlArray *a)
+    {
+        QMutexLocker lock(&mutex);
+        ranges.erase(a);
+    }
+
+    void Clear()
+    {
+        QMutexLocker lock(&mutex);
+        ranges.clear();
+    }
+};
+
+#endif
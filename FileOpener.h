@@ -0,0 +1,52 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef FILE_OPENER_H
+#define FILE_OPENER_H
+
+#include <QThread>
+#include "Pipeline.h"
+
+// ****************************************************************************
+// Class:  FileOpener
+//
+// Purpose:
+///   Opens a file in Pipeline::importers on its own thread, since
+///   parsing the headers of a big file can take a long time.  Its
+///   meshes can be picked up from the pool as they're found; connect
+///   to finished() (queued) to find out when it's done, then check
+///   the error text.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FileOpener : public QThread
+{
+  public:
+    std::string  file;
+    std::string  error;
+
+  public:
+    FileOpener(const std::string &fn, QObject *parent)
+        : QThread(parent), file(fn)
+    {
+    }
+  protected:
+    virtual void run()
+    {
+        try
+        {
+            if (!Pipeline::importers.Open(file))
+                error = "unknown file extension";
+        }
+        catch (const eavlException &e)
+        {
+            error = e.GetErrorText();
+        }
+        catch (...)
+        {
+            error = "unknown error opening file";
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,35 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef FILTER_LOCK_H
+#define FILTER_LOCK_H
+
+#include <QMutex>
+#include <QMutexLocker>
+
+// ****************************************************************************
+// Class:  FilterLock
+//
+// Purpose:
+///   Hold one of these around every EAVL filter or mutator Execute().
+///   They queue their work in eavlExecutor's process-wide plan
+///   (AddOperation, then Go), so two running at once, e.g. in
+///   different chunks or different pipelines, would race on it.  Our
+///   own algorithms (MultiLevelContour, HistogramEngine, CellSelection
+///   and the like) don't go through the executor, so chunks still run
+///   those, and all the reading, in parallel.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FilterLock
+{
+  protected:
+    static QMutex mutex;
+    QMutexLocker  lock;
+  public:
+    FilterLock() : lock(&mutex)
+    {
+    }
+};
+
+#endif
@@ -0,0 +1,388 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef GEOMETRY_SOURCE_H
+#define GEOMETRY_SOURCE_H
+
+#include "STL.h"
+#include <algorithm>
+#include <cmath>
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <eavlCellSetAllStructured.h>
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+#include <eavlDataSet.h>
+#include <eavlException.h>
+#include <eavlField.h>
+#include <eavlFloatArray.h>
+#include <eavlLogicalStructureRegular.h>
+
+#include "Attribute.h"
+
+// ****************************************************************************
+// Class:  GeometryAttributes
+//
+// Purpose:
+///   Settings for a generated data set: the kind of mesh
+///   ("rectilinear", "curvilinear", "hex" or "tet"), the number of
+///   cells along each axis (a tet mesh has 6 tets per such cell), how
+///   many chunks to split it into along z, and the seed for the noise
+///   field.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class GeometryAttributes : public Attribute
+{
+  public:
+    string meshType;
+    int    cells[3];
+    int    nchunks;
+    int    seed;
+  public:
+    virtual const char *GetType() {return "GeometryAttributes";}
+    static Attribute *Create() { return new GeometryAttributes; }
+    GeometryAttributes() : Attribute()
+    {
+        meshType = "rectilinear";
+        cells[0] = cells[1] = cells[2] = 64;
+        nchunks = 1;
+        seed = 0;
+    }
+    virtual ~GeometryAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("meshType", meshType);
+        Add("cells", cells, 3);
+        Add("nchunks", nchunks);
+        Add("seed", seed);
+    }
+};
+
+// ****************************************************************************
+// Class:  GeometrySource
+//
+// Purpose:
+///   Generates one chunk of a synthetic data set on [-1,1]^3, for
+///   reproducible inputs of any size.  The fields are analytic:
+///   "marschnerlobb" (the Marschner-Lobb test signal), "noise"
+///   (uniform in [0,1), from a hash of the global node index, so it's
+///   the same however the mesh is chunked) and "velocity" (a Burgers
+///   vortex along z, with its core at radius 0.3).
+///
+///   The coordinates and fields are filled in by threads from the
+///   global pool grabbing blocks of nodes, as in CellSelection.  The
+///   chunks themselves are independent, so the pipeline can generate
+///   several at once.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class GeometrySource
+{
+  protected:
+    enum { BlockSize = 16384 };
+    enum Quantity { Coords, MarschnerLobb, Noise, Velocity };
+
+    class Task : public QRunnable
+    {
+      public:
+        GeometrySource *source;
+        QSemaphore     *done;
+        virtual void run()
+        {
+            source->Work();
+            done->release();
+        }
+    };
+
+    GeometryAttributes *atts;
+    int                 dims[3];   ///< nodes in the whole mesh
+    int                 k0;        ///< first node layer of the chunk
+    int                 nk;        ///< node layers in the chunk
+    int                 npts;
+    bool                curvilinear;
+
+    // the current fill
+    Quantity            quantity;
+    float              *values;
+    int                 nblocks;
+    QAtomicInt          nextBlock;
+
+  public:
+    GeometrySource(GeometryAttributes *a, int chunk) : atts(a)
+    {
+        const string &t = atts->meshType;
+        if (t != "rectilinear" && t != "curvilinear" && t != "hex" && t != "tet")
+            throw eavlException("Geometry: unknown mesh type " + t);
+        for (int d=0; d<3; d++)
+        {
+            if (atts->cells[d] < 1)
+                throw eavlException("Geometry: need at least one cell "
+                                    "along each axis");
+            dims[d] = atts->cells[d] + 1;
+        }
+        int nchunks = GetNumChunks(atts);
+        int layers = atts->cells[2];
+        k0 = (int)((long long)layers * chunk / nchunks);
+        nk = (int)((long long)layers * (chunk+1) / nchunks) - k0 + 1;
+        long long n = (long long)dims[0] * dims[1] * nk;
+        if (n > 0x7fffffff)
+            throw eavlException("Geometry: too many nodes in a chunk; "
+                                "use more chunks");
+        npts = (int)n;
+        curvilinear = (t == "curvilinear");
+    }
+
+    static int GetNumChunks(GeometryAttributes *a)
+    {
+        return std::max(1, std::min(a->nchunks, a->cells[2]));
+    }
+
+    static std::vector<std::string> GetFieldList()
+    {
+        std::vector<std::string> names;
+        names.push_back("marschnerlobb");
+        names.push_back("noise");
+        names.push_back("velocity");
+        return names;
+    }
+
+    /// Create the chunk's mesh, with no fields but the coordinates.
+    eavlDataSet *CreateMesh()
+    {
+        eavlDataSet *ds = new eavlDataSet;
+        ds->SetNumPoints(npts);
+        eavlRegularStructure reg;
+        reg.SetNodeDimension3D(dims[0], dims[1], nk);
+        const string &t = atts->meshType;
+
+        eavlLogicalStructureRegular *log = NULL;
+        if (t == "rectilinear" || t == "curvilinear")
+        {
+            log = new eavlLogicalStructureRegular(reg.dimension, reg);
+            ds->SetLogicalStructure(log);
+        }
+        eavlCoordinatesCartesian *cc =
+            new eavlCoordinatesCartesian(log,
+                                         eavlCoordinatesCartesian::X,
+                                         eavlCoordinatesCartesian::Y,
+                                         eavlCoordinatesCartesian::Z);
+        if (t == "rectilinear")
+        {
+            const char *names[3] = {"xcoord", "ycoord", "zcoord"};
+            int n[3] = {dims[0], dims[1], nk};
+            int first[3] = {0, 0, k0};
+            for (int d=0; d<3; d++)
+            {
+                eavlFloatArray *axis = new eavlFloatArray(names[d], 1, n[d]);
+                for (int i=0; i<n[d]; i++)
+                    axis->SetComponentFromDouble(i, 0, Coordinate(d, first[d]+i));
+                ds->AddField(new eavlField(1, axis,
+                                           eavlField::ASSOC_LOGICALDIM, d));
+                cc->SetAxis(d, new eavlCoordinateAxisField(names[d], 0));
+            }
+        }
+        else
+        {
+            eavlFloatArray *coords = new eavlFloatArray("coords", 3, npts);
+            Fill(Coords, coords->GetHostArray());
+            ds->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+            for (int d=0; d<3; d++)
+                cc->SetAxis(d, new eavlCoordinateAxisField("coords", d));
+        }
+        ds->AddCoordinateSystem(cc);
+
+        if (log)
+        {
+            ds->AddCellSet(new eavlCellSetAllStructured("mesh", reg));
+            return ds;
+        }
+
+        eavlExplicitConnectivity conn;
+        int nx = dims[0], ny = dims[1];
+        for (int k=0; k<nk-1; k++)
+        {
+            for (int j=0; j<ny-1; j++)
+            {
+                for (int i=0; i<nx-1; i++)
+                {
+                    int p = (k*ny + j)*nx + i;
+                    int dx = 1, dy = nx, dz = nx*ny;
+                    int hex[8] = {p, p+dx, p+dx+dy, p+dy,
+                                  p+dz, p+dx+dz, p+dx+dy+dz, p+dy+dz};
+                    if (t == "hex")
+                    {
+                        conn.AddElement(EAVL_HEX, 8, hex);
+                        continue;
+                    }
+                    // six tets around the 0-6 diagonal, which match
+                    // up across neighboring hexes
+                    static const int tets[6][4] = {{0,1,2,6}, {0,2,3,6},
+                                                   {0,3,7,6}, {0,7,4,6},
+                                                   {0,4,5,6}, {0,5,1,6}};
+                    for (int q=0; q<6; q++)
+                    {
+                        int tet[4];
+                        for (int v=0; v<4; v++)
+                            tet[v] = hex[tets[q][v]];
+                        conn.AddElement(EAVL_TET, 4, tet);
+                    }
+                }
+            }
+        }
+        eavlCellSetExplicit *cs = new eavlCellSetExplicit("mesh", 3);
+        cs->SetCellNodeConnectivity(conn);
+        ds->AddCellSet(cs);
+        return ds;
+    }
+
+    /// Create one of the fields in GetFieldList() for the chunk.
+    eavlField *CreateField(const std::string &name)
+    {
+        Quantity q;
+        int ncomps = 1;
+        if (name == "marschnerlobb")
+            q = MarschnerLobb;
+        else if (name == "noise")
+            q = Noise;
+        else if (name == "velocity")
+        {
+            q = Velocity;
+            ncomps = 3;
+        }
+        else
+            throw eavlException("Geometry: no field named " + name);
+
+        eavlFloatArray *a = new eavlFloatArray(name, ncomps, npts);
+        Fill(q, a->GetHostArray());
+        return new eavlField(1, a, eavlField::ASSOC_POINTS);
+    }
+
+  protected:
+    double Coordinate(int axis, int index)
+    {
+        return -1. + 2. * index / (dims[axis] - 1);
+    }
+
+    /// The position of a node, by its index in the whole mesh.
+    void Point(int i, int j, int k, double *p)
+    {
+        p[0] = Coordinate(0, i);
+        p[1] = Coordinate(1, j);
+        p[2] = Coordinate(2, k);
+        if (curvilinear)
+        {
+            // a wiggle which leaves the boundary alone
+            double x = p[0], y = p[1], z = p[2];
+            p[0] += 0.05 * sin(M_PI*y) * sin(M_PI*z);
+            p[1] += 0.05 * sin(M_PI*z) * sin(M_PI*x);
+            p[2] += 0.05 * sin(M_PI*x) * sin(M_PI*y);
+        }
+    }
+
+    static unsigned int Hash(unsigned int h)
+    {
+        h = (h ^ 61) ^ (h >> 16);
+        h += h << 3;
+        h ^= h >> 4;
+        h *= 0x27d4eb2d;
+        h ^= h >> 15;
+        return h;
+    }
+
+    void Evaluate(int i, int j, int k, float *out)
+    {
+        if (quantity == Noise)
+        {
+            unsigned int h = Hash(atts->seed);
+            h = Hash(h ^ i);
+            h = Hash(h ^ j);
+            h = Hash(h ^ k);
+            out[0] = (h >> 8) * (1.f / (1 << 24));
+            return;
+        }
+
+        double p[3];
+        Point(i, j, k, p);
+        if (quantity == Coords)
+        {
+            for (int d=0; d<3; d++)
+                out[d] = p[d];
+        }
+        else if (quantity == MarschnerLobb)
+        {
+            const double alpha = 0.25, fm = 6;
+            double r = sqrt(p[0]*p[0] + p[1]*p[1]);
+            double rho = cos(2*M_PI*fm * cos(M_PI*r/2));
+            out[0] = (1 - sin(M_PI*p[2]/2) + alpha*(1 + rho)) / (2*(1 + alpha));
+        }
+        else
+        {
+            // swirl decaying outside the core, plus inflow toward the
+            // axis which is stretched along it
+            const double rc = 0.3, strain = 0.5;
+            double r2 = p[0]*p[0] + p[1]*p[1];
+            double swirl = (r2 > 0) ? (1 - exp(-r2/(rc*rc))) / r2 : 0;
+            out[0] = -p[1]*swirl - 0.5*strain*p[0];
+            out[1] =  p[0]*swirl - 0.5*strain*p[1];
+            out[2] = strain*p[2];
+        }
+    }
+
+    void Fill(Quantity q, float *out)
+    {
+        quantity = q;
+        values = out;
+        nblocks = (npts + BlockSize - 1) / BlockSize;
+        int nthreads = QThread::idealThreadCount();
+        nthreads = std::max(1, std::min(nthreads, nblocks/4));
+
+        nextBlock = 0;
+        QSemaphore done;
+        int started = 0;
+        for (int t=1; t<nthreads; t++)
+        {
+            Task *task = new Task;
+            task->source = this;
+            task->done = &done;
+            if (!QThreadPool::globalInstance()->tryStart(task))
+            {
+                delete task;
+                break;
+            }
+            started++;
+        }
+        Work();
+        done.acquire(started);
+    }
+
+    void Work()
+    {
+        int ncomps = (quantity == Coords || quantity == Velocity) ? 3 : 1;
+        int nx = dims[0], ny = dims[1];
+        while (true)
+        {
+            int block = nextBlock.fetchAndAddOrdered(1);
+            if (block >= nblocks)
+                break;
+            int start = block * BlockSize;
+            int end = std::min(npts, start + BlockSize);
+            for (int n=start; n<end; n++)
+            {
+                int i = n % nx;
+                int j = (n / nx) % ny;
+                int k = n / (nx*ny) + k0;
+                Evaluate(i, j, k, values + n*ncomps);
+            }
+        }
+    }
+};
+
+#endif
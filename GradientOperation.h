@@ -0,0 +1,187 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef OP_GRADIENT_H
+#define OP_GRADIENT_H
+
+#include "Operation.h"
+
+#include "FieldGradient.h"
+
+// ****************************************************************************
+// Class:  GradientAttributes
+//
+// Purpose:
+///   Attributes for the gradient operation: the field, which quantity
+///   to make from its gradient ("gradient", or for a vector field
+///   "divergence", "vorticity" or "qcriterion"), the new field's name
+///   ("" to use the quantity's), and the cell set ("" for the first).
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class GradientAttributes : public Attribute
+{
+  public:
+    string field;
+    string quantity;
+    string output;
+    string cellset;
+  public:
+    virtual const char *GetType() {return "GradientAttributes";}
+    static Attribute *Create() { return new GradientAttributes; }
+    GradientAttributes() : Attribute()
+    {
+        field = "";
+        quantity = "gradient";
+        output = "";
+        cellset = "";
+    }
+    virtual ~GradientAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("field", field);
+        Add("quantity", quantity);
+        Add("output", output);
+        Add("cellset", cellset);
+    }
+};
+
+// ****************************************************************************
+// Class:  GradientOperation
+//
+// Purpose:
+///   Operation that adds a nodal field derived from the gradient of
+///   another: the gradient itself (3 components per component of the
+///   field, d/dx d/dy d/dz of each in turn), or for velocity-like
+///   vector fields the divergence, the vorticity vector, or the
+///   Q-criterion (positive where rotation dominates strain, so its
+///   isosurfaces show vortex cores).
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class GradientOperation : public Operation
+{
+    GradientAttributes *atts;
+  public:
+    GradientOperation()
+        : Operation()
+    {
+        atts = new GradientAttributes;
+    }
+    virtual ~GradientOperation()
+    {
+        delete atts;
+    }
+    virtual std::string GetOperationName()
+    {
+        return "Gradient";
+    }
+    virtual std::string GetOperationShortName()
+    {
+        return "grad";
+    }
+    virtual std::string GetOperationInfo()
+    {
+        return atts->quantity + " of " + atts->field;
+    }
+    virtual Attribute *GetSettings()
+    {
+        return atts;
+    }
+    virtual std::vector<std::string> GetNeededVariables()
+    {
+        std::vector<std::string> vars;
+        vars.push_back(atts->field);
+        return vars;
+    }
+    virtual std::vector<std::string> GetOutputVariables()
+    {
+        std::vector<std::string> vars;
+        vars.push_back(OutputName());
+        return vars;
+    }
+    virtual void Execute()
+    {
+        const std::string &q = atts->quantity;
+        if (q != "gradient" && q != "divergence" &&
+            q != "vorticity" && q != "qcriterion")
+            throw eavlException("Gradient: unknown quantity " + q);
+        std::string name = OutputName();
+        if (input->GetFieldIndex(name) >= 0)
+            throw eavlException("Gradient: there is already a field "
+                                "named " + name);
+
+        eavlCellSet *cs = (atts->cellset == "") ? input->GetCellSet(0)
+                                                : input->GetCellSet(atts->cellset);
+        eavlField *f = recenterCache.GetNodalField(input, atts->field);
+        int nc = f->GetArray()->GetNumberOfComponents();
+        if (q != "gradient" && nc != 3)
+            throw eavlException("Gradient: the " + q + " needs a "
+                                "3-component vector field");
+
+        FieldGradient gradient(input, cs, f);
+        gradient.Execute();
+        const std::vector<float> &g = gradient.GetResult();
+
+        int npts = input->GetNumPoints();
+        eavlFloatArray *result;
+        if (q == "gradient")
+        {
+            result = new eavlFloatArray(name, nc*3, npts);
+            std::copy(g.begin(), g.end(), result->GetHostArray());
+        }
+        else if (q == "divergence")
+        {
+            result = new eavlFloatArray(name, 1, npts);
+            float *r = result->GetHostArray();
+            for (int i=0; i<npts; i++)
+            {
+                const float *j = &g[i*9];
+                r[i] = j[0] + j[4] + j[8];
+            }
+        }
+        else if (q == "vorticity")
+        {
+            result = new eavlFloatArray(name, 3, npts);
+            float *r = result->GetHostArray();
+            for (int i=0; i<npts; i++)
+            {
+                // j[3*c+d] is d(v_c)/d(x_d)
+                const float *j = &g[i*9];
+                r[3*i+0] = j[7] - j[5];
+                r[3*i+1] = j[2] - j[6];
+                r[3*i+2] = j[3] - j[1];
+            }
+        }
+        else
+        {
+            result = new eavlFloatArray(name, 1, npts);
+            float *r = result->GetHostArray();
+            for (int i=0; i<npts; i++)
+            {
+                // Q = (|rotation|^2 - |strain rate|^2) / 2, which
+                // works out to -(1/2) sum of j[a][b]*j[b][a]
+                const float *j = &g[i*9];
+                double sum = 0;
+                for (int a=0; a<3; a++)
+                    for (int b=0; b<3; b++)
+                        sum += j[3*a+b] * j[3*b+a];
+                r[i] = -0.5 * sum;
+            }
+        }
+        input->AddField(new eavlField(1, result, eavlField::ASSOC_POINTS));
+        output = input;
+    }
+
+  protected:
+    std::string OutputName()
+    {
+        return (atts->output == "") ? atts->quantity : atts->output;
+    }
+};
+
+#endif
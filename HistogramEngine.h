@@ -0,0 +1,215 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef HISTOGRAM_ENGINE_H
+#define HISTOGRAM_ENGINE_H
+
+#include "STL.h"
+#include <algorithm>
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include "eavlArray.h"
+#include "eavlFloatArray.h"
+
+// ****************************************************************************
+// Class:  HistogramEngine
+//
+// Purpose:
+///   Bins one component of one or more arrays into the same set of
+///   bins, linear or logarithmic, over a given range.  Values outside
+///   the range (or non-positive ones, for log bins) aren't counted.
+///
+///   The arrays are split into blocks which threads from the global
+///   pool take turns grabbing, each counting into its own private
+///   histogram; these are summed at the end.  The calling thread
+///   works too, so this still finishes if the pool is busy.  Within
+///   a block, the bin positions are computed in one simple loop the
+///   compiler can vectorize, and counted in a second.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class HistogramEngine
+{
+  protected:
+    enum { BlockSize = 16384 };
+
+    struct Input
+    {
+        eavlArray   *array;
+        const float *host;   ///< non-NULL for float arrays
+        int          ncomp;
+        int          component;
+        long long    ntuples;
+    };
+
+    class Task : public QRunnable
+    {
+      public:
+        HistogramEngine *engine;
+        int              index;
+        QSemaphore      *done;
+        virtual void run()
+        {
+            engine->Work(index);
+            done->release();
+        }
+    };
+
+    int                                 nbins;
+    double                              lo, hi;
+    bool                                logscale;
+    std::vector<Input>                  inputs;
+    /// the first global block number of each input, plus the total
+    std::vector<long long>              firstBlock;
+    QAtomicInt                          nextBlock;
+    std::vector<std::vector<long long> > partial;
+    std::vector<std::vector<long long> > counts;
+
+  public:
+    HistogramEngine(int n, double minval, double maxval, bool logbins)
+        : nbins(n), lo(minval), hi(maxval), logscale(logbins)
+    {
+    }
+
+    void AddArray(eavlArray *a, int component = 0)
+    {
+        Input in;
+        in.array = a;
+        in.host = NULL;
+        in.ncomp = a->GetNumberOfComponents();
+        in.component = component;
+        in.ntuples = a->GetNumberOfTuples();
+        eavlFloatArray *fa = dynamic_cast<eavlFloatArray*>(a);
+        if (fa)
+            in.host = fa->GetHostArray();
+        inputs.push_back(in);
+    }
+
+    /// Bin all the arrays, using up to maxThreads threads (0 for as
+    /// many as there are cores).
+    void Execute(int maxThreads = 0)
+    {
+        firstBlock.clear();
+        long long nblocks = 0;
+        for (size_t i=0; i<inputs.size(); i++)
+        {
+            firstBlock.push_back(nblocks);
+            nblocks += (inputs[i].ntuples + BlockSize - 1) / BlockSize;
+        }
+        firstBlock.push_back(nblocks);
+
+        int nthreads = QThread::idealThreadCount();
+        if (maxThreads > 0)
+            nthreads = std::min(nthreads, maxThreads);
+        // no point in threads without a few blocks each
+        nthreads = std::max(1, (int)std::min<long long>(nthreads, nblocks/4));
+
+        partial.assign(nthreads,
+                       std::vector<long long>(inputs.size()*nbins, 0));
+        nextBlock = 0;
+
+        QSemaphore done;
+        int started = 0;
+        for (int t=1; t<nthreads; t++)
+        {
+            Task *task = new Task;
+            task->engine = this;
+            task->index = t;
+            task->done = &done;
+            if (!QThreadPool::globalInstance()->tryStart(task))
+            {
+                delete task;
+                break;
+            }
+            started++;
+        }
+        Work(0);
+        done.acquire(started);
+
+        counts.assign(inputs.size(), std::vector<long long>(nbins, 0));
+        for (size_t t=0; t<partial.size(); t++)
+            for (size_t i=0; i<inputs.size(); i++)
+                for (int b=0; b<nbins; b++)
+                    counts[i][b] += partial[t][i*nbins + b];
+        partial.clear();
+    }
+
+    const std::vector<long long> &GetCounts(int i) { return counts[i]; }
+
+    /// The low edge of bin i; GetBinEdge(nbins) is the high end.
+    double GetBinEdge(int i)
+    {
+        double t = double(i) / double(nbins);
+        if (logscale)
+            return lo * pow(hi/lo, t);
+        return lo + (hi-lo) * t;
+    }
+
+  protected:
+    void Work(int index)
+    {
+        long long *mycounts = &(partial[index][0]);
+        float vals[BlockSize];
+        float pos[BlockSize];
+
+        float flo = logscale ? log(lo) : lo;
+        float fhi = logscale ? log(hi) : hi;
+        float scale = float(nbins) / (fhi - flo);
+        float fn = float(nbins);
+        long long nblocks = firstBlock.back();
+
+        while (true)
+        {
+            long long block = nextBlock.fetchAndAddOrdered(1);
+            if (block >= nblocks)
+                break;
+            int i = std::upper_bound(firstBlock.begin(), firstBlock.end(),
+                                     block) - firstBlock.begin() - 1;
+            const Input &in = inputs[i];
+            long long start = (block - firstBlock[i]) * BlockSize;
+            int n = (int)std::min<long long>(BlockSize, in.ntuples - start);
+
+            if (in.host)
+            {
+                const float *p = in.host + start*in.ncomp + in.component;
+                if (in.ncomp == 1)
+                    memcpy(vals, p, n*sizeof(float));
+                else
+                    for (int j=0; j<n; j++)
+                        vals[j] = p[j*in.ncomp];
+            }
+            else
+            {
+                for (int j=0; j<n; j++)
+                    vals[j] = in.array->GetComponentAsDouble(start+j,
+                                                             in.component);
+            }
+
+            if (logscale)
+            {
+                // non-positive values become -inf or nan, and are
+                // skipped below
+                for (int j=0; j<n; j++)
+                    pos[j] = (log(vals[j]) - flo) * scale;
+            }
+            else
+            {
+                for (int j=0; j<n; j++)
+                    pos[j] = (vals[j] - flo) * scale;
+            }
+
+            long long *c = mycounts + i*nbins;
+            for (int j=0; j<n; j++)
+            {
+                float x = pos[j];
+                if (x >= 0.f && x <= fn)
+                    c[x < fn ? int(x) : nbins-1]++;
+            }
+        }
+    }
+};
+
+#endif
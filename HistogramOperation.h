@@ -4,32 +4,47 @@
 
 #include "Operation.h"
 
-#include <eavlScalarBinFilter.h>
+#include "HistogramEngine.h"
+#include <eavlCellSetAllStructured.h>
+#include <eavlCoordinates.h>
+#include <eavlException.h>
+#include <eavlLogicalStructureRegular.h>
 
 // ****************************************************************************
 // Class:  HistogramAttributes
 //
 // Purpose:
-///   Attributes for the surface normal operation.  Currently, just
-///   a boolean flag whether to add the nodal version, or just have
-///   face normals.
+///   Attributes for the histogram operation: the field (or several,
+///   separated by commas or spaces, binned together), the number of
+///   bins, and optionally a fixed range and log-scale bins.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    January 17, 2013
 //
 // Modifications:
+//   Added the range, log scale, and multiple fields.
+//
 // ****************************************************************************
 class HistogramAttributes : public Attribute
 {
   public:
     string field;
-    int nbins;
+    int    nbins;
+    bool   autoRange; ///< use the fields' range instead of min/max
+    float  minval;
+    float  maxval;
+    bool   logScale;
   public:
     virtual const char *GetType() {return "HistogramAttributes";}
+    static Attribute *Create() { return new HistogramAttributes; }
     HistogramAttributes() : Attribute()
     {
         field = "(default)";
         nbins = 10;
+        autoRange = true;
+        minval = 0;
+        maxval = 1;
+        logScale = false;
     }
     virtual ~HistogramAttributes()
     {
@@ -38,34 +53,59 @@ class HistogramAttributes : public Attribute
     {
         Add("field", field);
         Add("nbins", nbins);
+        Add("autoRange", autoRange);
+        Add("minval", minval);
+        Add("maxval", maxval);
+        Add("logScale", logScale);
+    }
+    std::vector<std::string> GetFieldNames()
+    {
+        std::vector<std::string> names;
+        std::string s = field;
+        std::replace(s.begin(), s.end(), ',', ' ');
+        std::istringstream in(s);
+        std::string name;
+        while (in >> name)
+            names.push_back(name);
+        return names;
     }
-    
 };
 
 // ****************************************************************************
 // Class:  HistogramOperation
 //
 // Purpose:
-///   Operation that creates a new field that set that is the surface
-///   normals from another cell set.
-///   Note: this currently has no settings.
+///   Operation that creates a 1D data set whose cells are the bins of
+///   a histogram of a field, with the count in each in "counts".  With
+///   several fields, they share the bins and the counts are in
+///   "counts_<field>".  Every chunk is binned into the one histogram.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    January 17, 2013
 //
 // Modifications:
+//   Bin with HistogramEngine instead of eavlScalarBinFilter, which
+//   rescanned the field for its range every time.
+//
+//   The automatic range covers all the chunks, so they share the bins.
+//
+//   Delete the settings in the destructor.
+//
+//   Bin all the chunks together into one histogram.
 //
 // ****************************************************************************
 class HistogramOperation : public Operation
 {
     HistogramAttributes *atts;
-    eavlScalarBinFilter *filter;
   public:
     HistogramOperation()
         : Operation()
     {
         atts = new HistogramAttributes;
-        filter = new eavlScalarBinFilter;
+    }
+    virtual ~HistogramOperation()
+    {
+        delete atts;
     }
     virtual std::string GetOperationName()
     {
@@ -78,7 +118,10 @@ class HistogramOperation : public Operation
     virtual std::string GetOperationInfo()
     {
         ostringstream os;
-        os << atts->field << " in " << atts->nbins << " bins";
+        os << atts->field << " in " << atts->nbins
+           << (atts->logScale ? " log bins" : " bins");
+        if (!atts->autoRange)
+            os << " [" << atts->minval << "," << atts->maxval << "]";
         return os.str();
     }
     virtual Attribute *GetSettings()
@@ -89,23 +132,119 @@ class HistogramOperation : public Operation
     {
         std::vector<std::string> vars;
         if (atts->field != "(default)")
-            vars.push_back(atts->field);
+            vars = atts->GetFieldNames();
+        return vars;
+    }
+    virtual std::vector<std::string> GetMergedRangeVariables()
+    {
+        std::vector<std::string> vars;
+        if (atts->autoRange)
+            vars = atts->GetFieldNames();
         return vars;
     }
+    virtual bool CombinesChunks()
+    {
+        return true;
+    }
     virtual std::vector<std::string> GetOutputVariables()
     {
+        std::vector<std::string> names = atts->GetFieldNames();
         std::vector<std::string> vars;
-        vars.push_back("counts");
+        if (names.size() <= 1)
+            vars.push_back("counts");
+        else
+            for (size_t i=0; i<names.size(); i++)
+                vars.push_back("counts_" + names[i]);
         return vars;
     }
     virtual void Execute()
     {
-        filter->SetInput(input);
-        filter->SetField(atts->field);
-        filter->SetNumBins(atts->nbins);
-        filter->Execute();
+        std::vector<std::string> names = atts->GetFieldNames();
+        if (names.empty() || atts->nbins < 1)
+            throw eavlException("Histogram: need a field and at least one bin");
+
+        // every chunk's arrays for the first field, then the next, ...
+        std::vector<eavlDataSet*> inputs = chunkInputs;
+        if (inputs.empty())
+            inputs.push_back(input);
+        std::vector<eavlArray*> arrays;
+        for (size_t i=0; i<names.size(); i++)
+            for (size_t c=0; c<inputs.size(); c++)
+                arrays.push_back(inputs[c]->GetField(names[i])->GetArray());
+
+        double lo = atts->minval, hi = atts->maxval;
+        if (atts->autoRange)
+        {
+            // the pipeline gives us the range over all the chunks
+            if (hasMergedRange)
+            {
+                lo = mergedRange.minval;
+                hi = mergedRange.maxval;
+            }
+            for (size_t i=0; i<arrays.size() && !hasMergedRange; i++)
+            {
+                FieldRange r = fieldRanges.GetRange(arrays[i]);
+                lo = (i==0) ? r.minval : std::min(lo, r.minval);
+                hi = (i==0) ? r.maxval : std::max(hi, r.maxval);
+            }
+            if (hi <= lo)
+            {
+                lo -= .5;
+                hi += .5;
+            }
+        }
+        if (hi <= lo)
+            throw eavlException("Histogram: the range is empty");
+        if (atts->logScale && lo <= 0)
+            throw eavlException("Histogram: log bins need a positive "
+                                "minimum; set the range");
+
+        HistogramEngine engine(atts->nbins, lo, hi, atts->logScale);
+        for (size_t i=0; i<arrays.size(); i++)
+            engine.AddArray(arrays[i]);
+        engine.Execute();
+
+        // a 1D rectilinear mesh whose cells are the bins
+        int nbins = atts->nbins;
+        eavlRegularStructure reg;
+        reg.SetNodeDimension1D(nbins+1);
+        eavlLogicalStructureRegular *log =
+            new eavlLogicalStructureRegular(reg.dimension, reg);
+
+        output = new eavlDataSet;
+        output->SetNumPoints(nbins+1);
+        output->SetLogicalStructure(log);
+
+        eavlFloatArray *edges = new eavlFloatArray("xcoord", 1, nbins+1);
+        for (int b=0; b<=nbins; b++)
+            edges->SetComponentFromDouble(b, 0, engine.GetBinEdge(b));
+        output->AddField(new eavlField(1, edges,
+                                       eavlField::ASSOC_LOGICALDIM, 0));
+
+        eavlCoordinatesCartesian *coords =
+            new eavlCoordinatesCartesian(log, eavlCoordinatesCartesian::X);
+        coords->SetAxis(0, new eavlCoordinateAxisField("xcoord", 0));
+        output->AddCoordinateSystem(coords);
+
+        output->AddCellSet(new eavlCellSetAllStructured("bins", reg));
 
-        output = filter->GetOutput();
+        for (size_t i=0; i<names.size(); i++)
+        {
+            string name = (names.size() == 1) ? "counts" : "counts_" + names[i];
+            std::vector<long long> sum(nbins, 0);
+            for (size_t c=0; c<inputs.size(); c++)
+            {
+                const std::vector<long long> &n =
+                    engine.GetCounts(i*inputs.size() + c);
+                for (int b=0; b<nbins; b++)
+                    sum[b] += n[b];
+            }
+            eavlFloatArray *counts = new eavlFloatArray(name, 1, nbins);
+            for (int b=0; b<nbins; b++)
+                counts->SetComponentFromDouble(b, 0, sum[b]);
+            output->AddField(new eavlField(0, counts,
+                                           eavlField::ASSOC_CELL_SET, 0));
+        }
     }
 };
 
@@ -0,0 +1,743 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef IMPORTER_POOL_H
+#define IMPORTER_POOL_H
+
+#include "STL.h"
+#include <fstream>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include "Attribute.h"
+#include "FieldRangeCache.h"
+#include "eavlImporter.h"
+#include "eavlImporterFactory.h"
+#include "eavlException.h"
+
+// ****************************************************************************
+// Class:  FileMeshMetadata
+//
+// Purpose:
+///   What we know about one mesh in a file without reading it: its
+///   chunk count and fields, and the range of any field that's been
+///   read in full.  Ranges are stored four to a field, as in
+///   FieldRange.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FileMeshMetadata : public Attribute
+{
+  public:
+    string         name;
+    int            nchunks;
+    vector<string> fields;
+    vector<string> rangeFields;
+    vector<double> ranges;
+  public:
+    virtual const char *GetType() {return "FileMeshMetadata";}
+    static Attribute *Create() { return new FileMeshMetadata; }
+    FileMeshMetadata() : Attribute()
+    {
+        name = "";
+        nchunks = 0;
+    }
+    virtual void AddFields()
+    {
+        Add("name", name);
+        Add("nchunks", nchunks);
+        Add("fields", fields);
+        Add("rangeFields", rangeFields);
+        Add("ranges", ranges);
+    }
+};
+
+// ****************************************************************************
+// Class:  FileMetadata
+//
+// Purpose:
+///   The meshes in a file, along with the file's size and modification
+///   time when they were scanned, so we can tell if it's been rewritten.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FileMetadata : public Attribute
+{
+  public:
+    string                    file;
+    int64                     size;
+    int64                     mtime;
+    vector<FileMeshMetadata*> meshes;
+  public:
+    virtual const char *GetType() {return "FileMetadata";}
+    static Attribute *Create() { return new FileMetadata; }
+    FileMetadata() : Attribute()
+    {
+        file = "";
+        size = 0;
+        mtime = 0;
+    }
+    virtual ~FileMetadata()
+    {
+        for (size_t i=0; i<meshes.size(); i++)
+            delete meshes[i];
+    }
+    virtual void AddFields()
+    {
+        Add("file", file);
+        Add("size", size);
+        Add("mtime", mtime);
+        Add("meshes", meshes);
+    }
+    FileMeshMetadata *GetMesh(const string &mesh)
+    {
+        for (size_t i=0; i<meshes.size(); i++)
+        {
+            if (meshes[i]->name == mesh)
+                return meshes[i];
+        }
+        return NULL;
+    }
+};
+
+// ****************************************************************************
+// Class:  FileMetadataList
+//
+// Purpose:
+///   The on-disk form of the metadata cache.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class FileMetadataList : public Attribute
+{
+  public:
+    vector<FileMetadata*> files;
+  public:
+    virtual const char *GetType() {return "FileMetadataList";}
+    static Attribute *Create() { return new FileMetadataList; }
+    FileMetadataList() : Attribute()
+    {
+    }
+    virtual ~FileMetadataList()
+    {
+        for (size_t i=0; i<files.size(); i++)
+            delete files[i];
+    }
+    virtual void AddFields()
+    {
+        Add("files", files);
+    }
+};
+
+// ****************************************************************************
+// Class:  ImporterPool
+//
+// Purpose:
+///   Every file that's been opened, by name, with its metadata and (at
+///   times) an importer for it.  The metadata (meshes, fields, chunk
+///   counts, and field ranges once they're known) is scanned once per
+///   version of a file, and can be saved to disk, so re-opening a file
+///   with thousands of domains doesn't re-read all its headers; until
+///   something actually reads from it, a file with valid metadata
+///   doesn't even get an importer.
+///
+///   Readers hold an importer between Acquire and Release (see
+///   ImporterHandle).  Once more than the maximum number of importers
+///   are open, the least recently used idle ones are closed, and
+///   re-opened the next time they're needed.  That only frees file
+///   handles and the like; data sets an importer returned belong to
+///   the caller.
+///
+///   Most importers (Silo, HDF5, etc.) aren't thread-safe, and several
+///   pipelines, or chunks, may be sharing one, so only one thread at a
+///   time may be calling into any importer (or creating or deleting
+///   one); ImporterHandle takes care of that for reads.  Whoever needs
+///   both locks takes the importer lock first.
+///
+///   All methods are safe to call from the chunk threads.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Scan files without holding the lock, so they can be opened in the
+//   background (see FileOpener).  While a file is being scanned its
+//   meshes show up one at a time, and Acquire waits for it to finish.
+//
+//   Added the importer lock, which used to belong to the pipelines.
+//
+//   An importer replaced by a rescan is kept, with its own count of
+//   users, until the last of them releases it.  Importers are deleted
+//   outside the pool lock.
+//
+//   Open importers and scan headers under the importer lock too.
+//
+// ****************************************************************************
+class ImporterPool
+{
+  protected:
+    struct Entry
+    {
+        FileMetadata *meta;
+        eavlImporter *importer;
+        int           users;
+        long long     lastUse;
+        /// true while Scan is filling in the metadata
+        bool          scanning;
+    };
+    /// an importer a rescan replaced while it was in use
+    struct Retired
+    {
+        eavlImporter *importer;
+        int           users;
+    };
+    std::map<std::string, Entry> entries;
+    std::vector<Retired>         retired;
+    /// metadata from Load for files that haven't been opened yet
+    std::map<std::string, FileMetadata*> saved;
+    int                          maxOpen;
+    long long                    useCount;
+    QMutex                       mutex;
+    QWaitCondition               scanned;
+    /// held by whoever is calling into an importer
+    QMutex                       importerMutex;
+    friend class ImporterHandle;
+
+  public:
+    ImporterPool(int maxopen = 32)
+        : maxOpen(maxopen), useCount(0)
+    {
+    }
+
+    /// Make a file available, scanning its metadata unless what we
+    /// have is still current.  Returns false if no importer can read
+    /// it; errors reading it are thrown as an eavlException.  If
+    /// another thread is already scanning it, this returns right away.
+    bool Open(const std::string &fn)
+    {
+        {
+            QMutexLocker lock(&mutex);
+            Entry *e = FindEntry(fn);
+            if (e && (e->scanning || IsCurrent(e->meta)))
+                return true;
+            if (UseSaved(fn))
+                return true;
+        }
+
+        // opening and scanning are the slow parts, so the lock isn't
+        // held for them
+        eavlImporter *importer;
+        {
+            QMutexLocker importerLock(&importerMutex);
+            importer = eavlImporterFactory::GetImporterForFile(fn);
+        }
+        if (!importer)
+            return false;
+        Scan(fn, importer);
+        return true;
+    }
+
+    bool IsOpen(const std::string &fn)
+    {
+        QMutexLocker lock(&mutex);
+        return FindEntry(fn) != NULL;
+    }
+
+    /// True while the file's meshes are still being found.
+    bool IsScanning(const std::string &fn)
+    {
+        QMutexLocker lock(&mutex);
+        Entry *e = FindEntry(fn);
+        return e && e->scanning;
+    }
+
+    std::vector<std::string> GetMeshList(const std::string &fn)
+    {
+        QMutexLocker lock(&mutex);
+        std::vector<std::string> meshes;
+        Entry *e = FindEntry(fn);
+        if (e)
+        {
+            for (size_t i=0; i<e->meta->meshes.size(); i++)
+                meshes.push_back(e->meta->meshes[i]->name);
+        }
+        return meshes;
+    }
+
+    std::vector<std::string> GetFieldList(const std::string &fn,
+                                          const std::string &mesh)
+    {
+        QMutexLocker lock(&mutex);
+        FileMeshMetadata *m = FindMesh(fn, mesh);
+        return m ? m->fields : std::vector<std::string>();
+    }
+
+    int GetNumChunks(const std::string &fn, const std::string &mesh)
+    {
+        QMutexLocker lock(&mutex);
+        FileMeshMetadata *m = FindMesh(fn, mesh);
+        return m ? m->nchunks : 0;
+    }
+
+    /// The range of a field over every chunk, if it's been recorded.
+    bool GetFieldRange(const std::string &fn, const std::string &mesh,
+                       const std::string &field, FieldRange &r)
+    {
+        QMutexLocker lock(&mutex);
+        FileMeshMetadata *m = FindMesh(fn, mesh);
+        if (!m)
+            return false;
+        for (size_t i=0; i<m->rangeFields.size(); i++)
+        {
+            if (m->rangeFields[i] != field)
+                continue;
+            r.minval = m->ranges[4*i+0];
+            r.maxval = m->ranges[4*i+1];
+            r.minmag = m->ranges[4*i+2];
+            r.maxmag = m->ranges[4*i+3];
+            return true;
+        }
+        return false;
+    }
+
+    void SetFieldRange(const std::string &fn, const std::string &mesh,
+                       const std::string &field, const FieldRange &r)
+    {
+        QMutexLocker lock(&mutex);
+        FileMeshMetadata *m = FindMesh(fn, mesh);
+        if (!m)
+            return;
+        for (size_t i=0; i<m->rangeFields.size(); i++)
+        {
+            if (m->rangeFields[i] == field)
+                return;
+        }
+        m->rangeFields.push_back(field);
+        m->ranges.push_back(r.minval);
+        m->ranges.push_back(r.maxval);
+        m->ranges.push_back(r.minmag);
+        m->ranges.push_back(r.maxmag);
+    }
+
+    /// Get an importer for an open file, opening one if needed, and
+    /// waiting for it if it's being scanned.  Every Acquire needs a
+    /// matching Release of the importer it returned.
+    eavlImporter *Acquire(const std::string &fn)
+    {
+        QMutexLocker lock(&mutex);
+        while (true)
+        {
+            Entry *e = FindEntry(fn);
+            if (!e)
+                throw eavlException("file " + fn + " isn't open");
+            if (e->scanning)
+            {
+                scanned.wait(&mutex);
+                continue;
+            }
+            if (e->importer)
+            {
+                e->users++;
+                return e->importer;
+            }
+
+            // rescan if it changed while we had it closed
+            if (!IsCurrent(e->meta))
+            {
+                lock.unlock();
+                bool opened = Open(fn);
+                lock.relock();
+                if (!opened)
+                    throw eavlException("couldn't re-open file " + fn);
+                continue;
+            }
+
+            // otherwise just re-open it, with others waiting as if
+            // it were being scanned
+            e->scanning = true;
+            lock.unlock();
+            eavlImporter *importer = NULL;
+            try
+            {
+                QMutexLocker importerLock(&importerMutex);
+                importer = eavlImporterFactory::GetImporterForFile(fn);
+            }
+            catch (...)
+            {
+            }
+            lock.relock();
+            e = FindEntry(fn);
+            e->scanning = false;
+            e->importer = importer;
+            scanned.wakeAll();
+            if (!importer)
+                throw eavlException("couldn't re-open file " + fn);
+        }
+    }
+
+    void Release(const std::string &fn, eavlImporter *importer)
+    {
+        std::vector<eavlImporter*> doomed;
+        {
+            QMutexLocker lock(&mutex);
+            Entry *e = FindEntry(fn);
+            if (e && e->importer == importer && e->users > 0)
+            {
+                e->users--;
+                e->lastUse = ++useCount;
+                CloseIdle(doomed);
+            }
+            else
+            {
+                // the file was rescanned while we had it
+                for (size_t i=0; i<retired.size(); i++)
+                {
+                    if (retired[i].importer != importer)
+                        continue;
+                    if (--retired[i].users == 0)
+                    {
+                        doomed.push_back(importer);
+                        retired.erase(retired.begin() + i);
+                    }
+                    break;
+                }
+            }
+        }
+        DeleteImporters(doomed);
+    }
+
+    void SetMaxOpenFiles(int n)
+    {
+        std::vector<eavlImporter*> doomed;
+        {
+            QMutexLocker lock(&mutex);
+            maxOpen = n;
+            CloseIdle(doomed);
+        }
+        DeleteImporters(doomed);
+    }
+
+    int GetMaxOpenFiles() { QMutexLocker lock(&mutex); return maxOpen; }
+
+    int GetNumOpenImporters()
+    {
+        QMutexLocker lock(&mutex);
+        int n = 0;
+        for (std::map<std::string, Entry>::iterator it = entries.begin();
+             it != entries.end(); ++it)
+        {
+            if (it->second.importer)
+                n++;
+        }
+        return n;
+    }
+
+    /// Read saved metadata.  This only makes it available to Open;
+    /// it doesn't open the files.  Returns false if there's nothing
+    /// usable saved.
+    bool Load(const std::string &filename)
+    {
+        std::ifstream in(filename.c_str(), std::ios::binary);
+        if (!in)
+            return false;
+        FileMetadataList list;
+        try
+        {
+            list.BinaryUnserialize(in);
+        }
+        catch (...)
+        {
+            return false;
+        }
+
+        QMutexLocker lock(&mutex);
+        for (size_t i=0; i<list.files.size(); i++)
+        {
+            FileMetadata *meta = list.files[i];
+            if (saved.count(meta->file))
+                delete saved[meta->file];
+            saved[meta->file] = meta;
+        }
+        list.files.clear();
+        return true;
+    }
+
+    /// Write the metadata for every file we know about (that still
+    /// exists) so a later Load can skip scanning them.
+    bool Save(const std::string &filename)
+    {
+        FileMetadataList list;
+        {
+            QMutexLocker lock(&mutex);
+            // leave out files that are part way through a scan
+            std::map<std::string, FileMetadata*> all(saved);
+            for (std::map<std::string, Entry>::iterator it = entries.begin();
+                 it != entries.end(); ++it)
+            {
+                if (!it->second.scanning)
+                    all[it->first] = it->second.meta;
+            }
+            for (std::map<std::string, FileMetadata*>::iterator it = all.begin();
+                 it != all.end(); ++it)
+            {
+                if (!QFileInfo(it->first.c_str()).exists())
+                    continue;
+                FileMetadata *copy = new FileMetadata;
+                copy->BinaryUnserialize(it->second->BinarySerialize());
+                list.files.push_back(copy);
+            }
+        }
+
+        std::ofstream out(filename.c_str(), std::ios::binary);
+        if (!out)
+            return false;
+        list.BinarySerialize(out);
+        return true;
+    }
+
+  protected:
+    // these assume the mutex is already locked
+    Entry *FindEntry(const std::string &fn)
+    {
+        std::map<std::string, Entry>::iterator it = entries.find(fn);
+        return (it == entries.end()) ? NULL : &it->second;
+    }
+
+    FileMeshMetadata *FindMesh(const std::string &fn, const std::string &mesh)
+    {
+        Entry *e = FindEntry(fn);
+        return e ? e->meta->GetMesh(mesh) : NULL;
+    }
+
+    static bool IsCurrent(FileMetadata *meta)
+    {
+        QFileInfo info(meta->file.c_str());
+        return info.exists() &&
+               info.size() == meta->size &&
+               (int64)info.lastModified().toTime_t() == meta->mtime;
+    }
+
+    /// Make an entry for a file from metadata saved by Load, if that's
+    /// still current.
+    bool UseSaved(const std::string &fn)
+    {
+        std::map<std::string, FileMetadata*>::iterator s = saved.find(fn);
+        if (s == saved.end())
+            return false;
+        FileMetadata *meta = s->second;
+        saved.erase(s);
+        if (!IsCurrent(meta))
+        {
+            delete meta;
+            return false;
+        }
+        // there's no entry yet, so nothing to delete
+        std::vector<eavlImporter*> doomed;
+        SetEntry(fn, meta, NULL, false, doomed);
+        return true;
+    }
+
+    /// Make an entry for a file (or refresh a stale one) by asking its
+    /// new importer.  Each mesh is added to the metadata once we know
+    /// everything about it.  This doesn't assume the mutex is locked.
+    void Scan(const std::string &fn, eavlImporter *importer)
+    {
+        QFileInfo info(fn.c_str());
+        FileMetadata *meta = new FileMetadata;
+        meta->file = fn;
+        meta->size = info.size();
+        meta->mtime = info.lastModified().toTime_t();
+        std::vector<eavlImporter*> doomed;
+        {
+            QMutexLocker lock(&mutex);
+            Entry *e = FindEntry(fn);
+            if (e && e->scanning)
+            {
+                // another thread got here first
+                delete meta;
+                doomed.push_back(importer);
+                lock.unlock();
+                DeleteImporters(doomed);
+                return;
+            }
+            SetEntry(fn, meta, importer, true, doomed);
+        }
+        DeleteImporters(doomed);
+
+        try
+        {
+            // let readers of other files in between meshes
+            std::vector<std::string> meshes;
+            {
+                QMutexLocker importerLock(&importerMutex);
+                meshes = importer->GetMeshList();
+            }
+            for (size_t i=0; i<meshes.size(); i++)
+            {
+                QMutexLocker importerLock(&importerMutex);
+                FileMeshMetadata *m = new FileMeshMetadata;
+                m->name = meshes[i];
+                m->nchunks = importer->GetNumChunks(meshes[i]);
+                m->fields = importer->GetFieldList(meshes[i]);
+
+                QMutexLocker lock(&mutex);
+                meta->meshes.push_back(m);
+            }
+        }
+        catch (...)
+        {
+            // nobody can have acquired it while it was scanning
+            {
+                QMutexLocker lock(&mutex);
+                entries.erase(fn);
+                delete meta;
+                scanned.wakeAll();
+            }
+            doomed.push_back(importer);
+            DeleteImporters(doomed);
+            throw;
+        }
+
+        {
+            QMutexLocker lock(&mutex);
+            FindEntry(fn)->scanning = false;
+            CloseIdle(doomed);
+            scanned.wakeAll();
+        }
+        DeleteImporters(doomed);
+    }
+
+    /// Make or refresh a file's entry.  Its old importer is added to
+    /// doomed, unless someone is still using it, in which case it's
+    /// retired until they release it.
+    Entry *SetEntry(const std::string &fn, FileMetadata *meta,
+                    eavlImporter *importer, bool scanning,
+                    std::vector<eavlImporter*> &doomed)
+    {
+        Entry *e = FindEntry(fn);
+        if (e)
+        {
+            delete e->meta;
+            if (e->importer && e->users > 0)
+            {
+                Retired r;
+                r.importer = e->importer;
+                r.users = e->users;
+                retired.push_back(r);
+            }
+            else if (e->importer)
+                doomed.push_back(e->importer);
+        }
+        else
+        {
+            e = &entries[fn];
+        }
+        e->meta = meta;
+        e->importer = importer;
+        e->users = 0;
+        e->lastUse = ++useCount;
+        e->scanning = scanning;
+        return e;
+    }
+
+    /// Add the least recently used idle importers past the maximum
+    /// to doomed.
+    void CloseIdle(std::vector<eavlImporter*> &doomed)
+    {
+        while (true)
+        {
+            int nopen = 0;
+            Entry *oldest = NULL;
+            for (std::map<std::string, Entry>::iterator it = entries.begin();
+                 it != entries.end(); ++it)
+            {
+                Entry &e = it->second;
+                if (!e.importer)
+                    continue;
+                nopen++;
+                if (e.users == 0 && !e.scanning &&
+                    (!oldest || e.lastUse < oldest->lastUse))
+                    oldest = &e;
+            }
+            if (nopen <= maxOpen || !oldest)
+                return;
+            doomed.push_back(oldest->importer);
+            oldest->importer = NULL;
+        }
+    }
+
+    /// Delete importers we've let go of.  Deleting one may call into
+    /// it, so this takes the importer lock, and since the importer
+    /// lock is taken before the pool's, it mustn't be called with the
+    /// pool's held.
+    void DeleteImporters(std::vector<eavlImporter*> &doomed)
+    {
+        if (doomed.empty())
+            return;
+        QMutexLocker lock(&importerMutex);
+        for (size_t i=0; i<doomed.size(); i++)
+            delete doomed[i];
+        doomed.clear();
+    }
+};
+
+// ****************************************************************************
+// Class:  ImporterHandle
+//
+// Purpose:
+///   Holds an importer from a pool for as long as it's in scope, like
+///   a QMutexLocker.  An empty file name holds nothing.  Reads go
+///   through the handle, which makes sure only one thread at a time
+///   is in an importer, so the handle may be shared by the chunks.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Read through the handle, under the pool's importer lock, rather
+//   than handing out the importer.
+//
+//   Release the importer we acquired, even if the file was rescanned.
+//
+// ****************************************************************************
+class ImporterHandle
+{
+  protected:
+    ImporterPool &pool;
+    std::string   file;
+    eavlImporter *importer;
+
+  public:
+    ImporterHandle(ImporterPool &p, const std::string &fn)
+        : pool(p), file(fn), importer(NULL)
+    {
+        if (file != "")
+            importer = pool.Acquire(file);
+    }
+    ~ImporterHandle()
+    {
+        if (importer)
+            pool.Release(file, importer);
+    }
+    eavlDataSet *GetMesh(const std::string &mesh, int chunk)
+    {
+        QMutexLocker lock(&pool.importerMutex);
+        return importer->GetMesh(mesh, chunk);
+    }
+    eavlField *GetField(const std::string &name, const std::string &mesh,
+                        int chunk)
+    {
+        QMutexLocker lock(&pool.importerMutex);
+        return importer->GetField(name, mesh, chunk);
+    }
+
+  private:
+    ImporterHandle(const ImporterHandle&);
+    void operator=(const ImporterHandle&);
+};
+
+#endif
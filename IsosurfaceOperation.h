@@ -4,31 +4,44 @@
 
 #include "Operation.h"
 
+#include "MultiLevelContour.h"
+
 #include <eavlIsosurfaceFilter.h>
+#include <eavlException.h>
 
 // ****************************************************************************
 // Class:  IsosurfaceAttributes
 //
 // Purpose:
-///   Attributes for the isosurface operation.  Currently, one var and one
-///   target value.
+///   Attributes for the isosurface operation.  One var, and either a
+///   list of target values or a number of evenly spaced levels, and
+///   the cell set to contour ("" for the first one).
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Allow several values, or N levels between the field's min and max.
+//
+//   Added the cell set.
+//
 // ****************************************************************************
 class IsosurfaceAttributes : public Attribute
 {
   public:
-    string field;
-    float value;
+    string        field;
+    vector<float> values;
+    int           nlevels; ///< if >0, used instead of values
+    string        cellset;
   public:
     virtual const char *GetType() {return "IsosurfaceAttributes";}
+    static Attribute *Create() { return new IsosurfaceAttributes; }
     IsosurfaceAttributes() : Attribute()
     {
         field = "(default)";
-        value = -1;
+        values.push_back(-1);
+        nlevels = 0;
+        cellset = "";
     }
     virtual ~IsosurfaceAttributes()
     {
@@ -36,7 +49,9 @@ class IsosurfaceAttributes : public Attribute
     virtual void AddFields()
     {
         Add("field", field);
-        Add("value", value);
+        Add("values", values);
+        Add("nlevels", nlevels);
+        Add("cellset", cellset);
     }
     
 };
@@ -45,23 +60,40 @@ class IsosurfaceAttributes : public Attribute
 // Class:  IsosurfaceOperation
 //
 // Purpose:
-///   Operation that's an isosurface.
+///   Operation that's an isosurface.  A single value uses the EAVL
+///   isosurface filter; several go through MultiLevelContour so the
+///   cells are only visited once.  Cell-centered fields are recentered
+///   to the nodes first.
 //
 // Programmer:  Jeremy Meredith
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Support several values, or N evenly spaced levels.
+//
+//   Pick the cell set by name, and accept cell-centered fields.
+//
+//   Run the EAVL filter under a FilterLock.
+//
+//   Use a new filter each time, so its output is ours to keep.
+//
+//   Space the levels over the field's range in all the chunks.
+//
+//   Delete the settings in the destructor.
+//
 // ****************************************************************************
 class IsosurfaceOperation : public Operation
 {
     IsosurfaceAttributes *atts;
-    eavlIsosurfaceFilter *filter;
   public:
     IsosurfaceOperation()
         : Operation()
     {
         atts = new IsosurfaceAttributes;
-        filter = new eavlIsosurfaceFilter;
+    }
+    virtual ~IsosurfaceOperation()
+    {
+        delete atts;
     }
     virtual std::string GetOperationName()
     {
@@ -74,8 +106,21 @@ class IsosurfaceOperation : public Operation
     virtual std::string GetOperationInfo()
     {
         ostringstream os;
-        os << atts->field << "=" << atts->value;
-        return os.str();        
+        if (atts->nlevels > 0)
+        {
+            os << atts->field << ": " << atts->nlevels << " levels";
+        }
+        else
+        {
+            os << atts->field << "=";
+            for (size_t i=0; i<atts->values.size() && i<3; i++)
+                os << (i>0 ? "," : "") << atts->values[i];
+            if (atts->values.size() > 3)
+                os << ",...";
+        }
+        if (atts->cellset != "")
+            os << " on " << atts->cellset;
+        return os.str();
     }
     virtual Attribute *GetSettings()
     {
@@ -103,17 +148,65 @@ class IsosurfaceOperation : public Operation
             vars.push_back("newy");
             vars.push_back("newz");
         }
+        if (atts->nlevels > 1 || atts->values.size() > 1)
+            vars.push_back("level");
         return vars;
     }
+    /// The levels are spaced over the field's range in all the chunks,
+    /// so every chunk gets the same ones.
+    virtual std::vector<std::string> GetMergedRangeVariables()
+    {
+        std::vector<std::string> vars;
+        if (atts->nlevels > 0)
+            vars.push_back(atts->field);
+        return vars;
+    }
+    /// Get the isovalues: nlevels values evenly spaced strictly between
+    /// the field's min and max, or else the given values.
+    std::vector<float> GetLevels(eavlField *f)
+    {
+        if (atts->nlevels <= 0)
+            return atts->values;
+
+        std::vector<float> levels;
+        FieldRange r = hasMergedRange ? mergedRange
+                                      : fieldRanges.GetRange(f->GetArray());
+        for (int i=1; i<=atts->nlevels; i++)
+        {
+            levels.push_back(r.minval + (r.maxval-r.minval) * i /
+                             double(atts->nlevels+1));
+        }
+        return levels;
+    }
     virtual void Execute()
     {
-        filter->SetInput(input);
-        ///\todo: assuming cell set 0
-        filter->SetCellSet(input->GetCellSet(0)->GetName());
-        filter->SetField(atts->field);
-        filter->SetIsoValue(atts->value);
-        filter->Execute();
-        output = filter->GetOutput();
+        eavlCellSet *cs = (atts->cellset == "") ? input->GetCellSet(0)
+                                                : input->GetCellSet(atts->cellset);
+        eavlField *f = recenterCache.GetNodalField(input, atts->field);
+        std::vector<float> levels = GetLevels(f);
+        if (levels.empty())
+            throw eavlException("Isosurface: no values given");
+
+        if (levels.size() == 1)
+        {
+            // the pipeline keeps the output, so don't let a filter
+            // re-use it next time
+            eavlIsosurfaceFilter filter;
+            filter.SetInput(input);
+            filter.SetCellSet(cs->GetName());
+            filter.SetField(f->GetArray()->GetName());
+            filter.SetIsoValue(levels[0]);
+            FilterLock lock;
+            filter.Execute();
+            output = filter.GetOutput();
+        }
+        else
+        {
+            if (f->GetAssociation() != eavlField::ASSOC_POINTS)
+                throw eavlException("Isosurface: field must be nodal");
+            MultiLevelContour contour(levels);
+            output = contour.Execute(input, cs, f);
+        }
     }
 };
 
@@ -0,0 +1,397 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef MULTI_LEVEL_CONTOUR_H
+#define MULTI_LEVEL_CONTOUR_H
+
+#include "STL.h"
+#include <algorithm>
+#include <eavlDataSet.h>
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+#include <eavlFloatArray.h>
+
+// ****************************************************************************
+// Class:  MultiLevelContour
+//
+// Purpose:
+///   Contours a cell set at several levels in one pass over the cells.
+///   Each cell is classified once against the sorted levels by its
+///   range of values, and only the levels inside that range are
+///   contoured, by splitting the cell into tetrahedra (or triangles
+///   in 2D).  The result is one cell set of triangles (or lines) with
+///   the nodal fields interpolated onto the new points, the cell set's
+///   cell fields copied from the cells they came from, and, if there
+///   are several levels, a "level" cell field holding the index of
+///   each one's level.  Points on the same edge at the same level are
+///   shared.
+///
+///   The values come from Value(), so derived classes can contour
+///   things that aren't stored as fields.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class MultiLevelContour
+{
+  protected:
+    struct EdgeKey
+    {
+        int a, b, level;
+        bool operator<(const EdgeKey &k) const
+        {
+            if (a != k.a) return a < k.a;
+            if (b != k.b) return b < k.b;
+            return level < k.level;
+        }
+    };
+
+    std::vector<float>       levels;
+    std::string              cellsetName;
+    std::vector<float>       v;
+    std::map<EdgeKey,int>    edgePoints;
+    std::vector<int>         edgeA, edgeB;
+    std::vector<float>       edgeAlpha;
+    eavlExplicitConnectivity conn;
+    std::vector<int>         cellLevels;
+    std::vector<int>         cellSources;
+
+  public:
+    MultiLevelContour(const std::vector<float> &l,
+                      const std::string &name = "isosurface")
+        : levels(l), cellsetName(name)
+    {
+        std::sort(levels.begin(), levels.end());
+    }
+    virtual ~MultiLevelContour()
+    {
+    }
+
+    /// Contour a scalar nodal field.
+    eavlDataSet *Execute(eavlDataSet *input, eavlCellSet *cs,
+                         eavlField *field)
+    {
+        eavlArray *arr = field->GetArray();
+        int npoints = input->GetNumPoints();
+        v.resize(npoints);
+        for (int i=0; i<npoints; i++)
+            v[i] = arr->GetComponentAsDouble(i,0);
+        return Contour(input, cs);
+    }
+
+  protected:
+    /// The value to contour at a node of the input.
+    virtual float Value(int node)
+    {
+        return v[node];
+    }
+
+    eavlDataSet *Contour(eavlDataSet *input, eavlCellSet *cs)
+    {
+        int simplices[12][4];
+        float vals[12];
+        int ncells = cs->GetNumCells();
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cs->GetCellNodes(c);
+            if (cell.numIndices < 2)
+                continue;
+
+            // classify the cell against all the levels at once
+            for (int j=0; j<cell.numIndices; j++)
+                vals[j] = Value(cell.indices[j]);
+            float lo = *std::min_element(vals, vals + cell.numIndices);
+            float hi = *std::max_element(vals, vals + cell.numIndices);
+            int first = std::lower_bound(levels.begin(), levels.end(), lo)
+                        - levels.begin();
+            int last  = std::lower_bound(levels.begin(), levels.end(), hi)
+                        - levels.begin();
+            if (first >= last)
+                continue;
+
+            int nverts = 0;
+            int n = DecomposeCell(cell, simplices, nverts);
+            for (int l=first; l<last; l++)
+            {
+                for (int s=0; s<n; s++)
+                {
+                    if (nverts == 4)
+                        ContourTet(simplices[s], cell, vals, l, c);
+                    else
+                        ContourTri(simplices[s], cell, vals, l, c);
+                }
+            }
+        }
+
+        int csindex = 0;
+        for (int i=0; i<input->GetNumCellSets(); i++)
+        {
+            if (input->GetCellSet(i) == cs)
+                csindex = i;
+        }
+        return CreateOutput(input, csindex, cs->GetDimensionality() - 1);
+    }
+
+  public:
+    /// Split a cell into tetrahedra (3D) or triangles (2D), as indices
+    /// into the cell's nodes; returns how many, with the number of
+    /// nodes in each in nverts.
+    static int DecomposeCell(const eavlCell &cell, int simplices[12][4],
+                             int &nverts)
+    {
+        static const int hexTets[6][4] = {{0,1,2,6}, {0,2,3,6}, {0,3,7,6},
+                                          {0,7,4,6}, {0,4,5,6}, {0,5,1,6}};
+        static const int voxelToHex[8] = {0,1,3,2,4,5,7,6};
+        static const int wedgeTets[3][4] = {{0,1,2,3}, {1,2,3,4}, {2,3,4,5}};
+        static const int pyrTets[2][4] = {{0,1,2,4}, {0,2,3,4}};
+        static const int quadTris[2][3] = {{0,1,2}, {0,2,3}};
+        static const int pixelTris[2][3] = {{0,1,3}, {0,3,2}};
+
+        int n = 0;
+        switch (cell.type)
+        {
+          case EAVL_TET:
+            nverts = 4;
+            for (int k=0; k<4; k++)
+                simplices[0][k] = k;
+            return 1;
+          case EAVL_HEX:
+          case EAVL_VOXEL:
+            nverts = 4;
+            for (int t=0; t<6; t++)
+            {
+                for (int k=0; k<4; k++)
+                {
+                    int h = hexTets[t][k];
+                    simplices[t][k] = (cell.type == EAVL_VOXEL) ?
+                                      voxelToHex[h] : h;
+                }
+            }
+            return 6;
+          case EAVL_WEDGE:
+            nverts = 4;
+            for (int t=0; t<3; t++)
+                for (int k=0; k<4; k++)
+                    simplices[t][k] = wedgeTets[t][k];
+            return 3;
+          case EAVL_PYRAMID:
+            nverts = 4;
+            for (int t=0; t<2; t++)
+                for (int k=0; k<4; k++)
+                    simplices[t][k] = pyrTets[t][k];
+            return 2;
+          case EAVL_TRI:
+            nverts = 3;
+            for (int k=0; k<3; k++)
+                simplices[0][k] = k;
+            return 1;
+          case EAVL_QUAD:
+          case EAVL_PIXEL:
+            nverts = 3;
+            for (int t=0; t<2; t++)
+            {
+                for (int k=0; k<3; k++)
+                {
+                    simplices[t][k] = (cell.type == EAVL_PIXEL) ?
+                                      pixelTris[t][k] : quadTris[t][k];
+                }
+            }
+            return 2;
+          case EAVL_POLYGON:
+            nverts = 3;
+            for (int k=1; k+1<cell.numIndices && n<12; k++, n++)
+            {
+                simplices[n][0] = 0;
+                simplices[n][1] = k;
+                simplices[n][2] = k+1;
+            }
+            return n;
+          default:
+            return 0;
+        }
+    }
+
+  protected:
+    /// Get the index of the new point where the given level crosses
+    /// the edge between nodes a and b (with values va and vb),
+    /// creating it if needed.
+    int EdgePoint(int a, int b, float va, float vb, int level)
+    {
+        if (b < a)
+        {
+            std::swap(a, b);
+            std::swap(va, vb);
+        }
+        EdgeKey key;
+        key.a = a;
+        key.b = b;
+        key.level = level;
+        std::map<EdgeKey,int>::iterator it = edgePoints.find(key);
+        if (it != edgePoints.end())
+            return it->second;
+
+        int index = edgeA.size();
+        edgePoints[key] = index;
+        edgeA.push_back(a);
+        edgeB.push_back(b);
+        edgeAlpha.push_back((levels[level] - va) / (vb - va));
+        return index;
+    }
+
+    void AddCell(eavlCellShape shape, int n, const int *ids,
+                 int level, int source)
+    {
+        conn.AddElement(shape, n, ids);
+        cellLevels.push_back(level);
+        cellSources.push_back(source);
+    }
+
+    void ContourTet(const int *local, const eavlCell &cell,
+                    const float *vals, int level, int source)
+    {
+        float value = levels[level];
+        int in[4], out[4], nin = 0, nout = 0;
+        for (int k=0; k<4; k++)
+        {
+            if (vals[local[k]] > value)
+                in[nin++] = local[k];
+            else
+                out[nout++] = local[k];
+        }
+        if (nin == 0 || nout == 0)
+            return;
+
+        const int *ids = cell.indices;
+        int tri[3];
+        if (nin == 1 || nout == 1)
+        {
+            int s = (nin == 1) ? in[0] : out[0];
+            int *o = (nin == 1) ? out : in;
+            for (int k=0; k<3; k++)
+                tri[k] = EdgePoint(ids[s], ids[o[k]],
+                                   vals[s], vals[o[k]], level);
+            AddCell(EAVL_TRI, 3, tri, level, source);
+        }
+        else
+        {
+            // a quad through the four crossed edges
+            int p[4] = {EdgePoint(ids[in[0]], ids[out[0]],
+                                  vals[in[0]], vals[out[0]], level),
+                        EdgePoint(ids[in[0]], ids[out[1]],
+                                  vals[in[0]], vals[out[1]], level),
+                        EdgePoint(ids[in[1]], ids[out[1]],
+                                  vals[in[1]], vals[out[1]], level),
+                        EdgePoint(ids[in[1]], ids[out[0]],
+                                  vals[in[1]], vals[out[0]], level)};
+            tri[0] = p[0]; tri[1] = p[1]; tri[2] = p[2];
+            AddCell(EAVL_TRI, 3, tri, level, source);
+            tri[0] = p[0]; tri[1] = p[2]; tri[2] = p[3];
+            AddCell(EAVL_TRI, 3, tri, level, source);
+        }
+    }
+
+    void ContourTri(const int *local, const eavlCell &cell,
+                    const float *vals, int level, int source)
+    {
+        float value = levels[level];
+        int in[3], out[3], nin = 0, nout = 0;
+        for (int k=0; k<3; k++)
+        {
+            if (vals[local[k]] > value)
+                in[nin++] = local[k];
+            else
+                out[nout++] = local[k];
+        }
+        if (nin == 0 || nout == 0)
+            return;
+
+        const int *ids = cell.indices;
+        int s = (nin == 1) ? in[0] : out[0];
+        int *o = (nin == 1) ? out : in;
+        int line[2] = {EdgePoint(ids[s], ids[o[0]], vals[s], vals[o[0]], level),
+                       EdgePoint(ids[s], ids[o[1]], vals[s], vals[o[1]], level)};
+        AddCell(EAVL_BEAM, 2, line, level, source);
+    }
+
+    eavlDataSet *CreateOutput(eavlDataSet *input, int csindex, int dim)
+    {
+        int npts = edgeA.size();
+        int ncells = cellSources.size();
+        eavlDataSet *out = new eavlDataSet;
+        out->SetNumPoints(npts);
+
+        eavlFloatArray *coords = new eavlFloatArray("coords", 3, npts);
+        for (int i=0; i<npts; i++)
+        {
+            float t = edgeAlpha[i];
+            for (int d=0; d<3; d++)
+            {
+                double pa = input->GetPoint(edgeA[i], d);
+                double pb = input->GetPoint(edgeB[i], d);
+                coords->SetComponentFromDouble(i, d, pa + t*(pb-pa));
+            }
+        }
+        eavlCoordinatesCartesian *cc =
+            new eavlCoordinatesCartesian(NULL,
+                                         eavlCoordinatesCartesian::X,
+                                         eavlCoordinatesCartesian::Y,
+                                         eavlCoordinatesCartesian::Z);
+        cc->SetAxis(0, new eavlCoordinateAxisField("coords", 0));
+        cc->SetAxis(1, new eavlCoordinateAxisField("coords", 1));
+        cc->SetAxis(2, new eavlCoordinateAxisField("coords", 2));
+        out->AddCoordinateSystem(cc);
+        out->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+
+        eavlCellSetExplicit *cells = new eavlCellSetExplicit(cellsetName, dim);
+        cells->SetCellNodeConnectivity(conn);
+        out->AddCellSet(cells);
+
+        if (levels.size() > 1)
+        {
+            eavlFloatArray *level = new eavlFloatArray("level", 1, ncells);
+            for (int i=0; i<ncells; i++)
+                level->SetComponentFromDouble(i, 0, cellLevels[i]);
+            out->AddField(new eavlField(0, level,
+                                        eavlField::ASSOC_CELL_SET, 0));
+        }
+
+        // interpolate the nodal fields, and copy the cell set's
+        // cell fields from the cells each new one came from
+        for (int f=0; f<input->GetNumFields(); f++)
+        {
+            eavlField *inf = input->GetField(f);
+            eavlArray *ina = inf->GetArray();
+            if (ina->GetName() == "coords" || ina->GetName() == "level")
+                continue;
+            int nc = ina->GetNumberOfComponents();
+            if (inf->GetAssociation() == eavlField::ASSOC_POINTS)
+            {
+                eavlFloatArray *a = new eavlFloatArray(ina->GetName(), nc, npts);
+                for (int i=0; i<npts; i++)
+                {
+                    float t = edgeAlpha[i];
+                    for (int c=0; c<nc; c++)
+                    {
+                        double va = ina->GetComponentAsDouble(edgeA[i], c);
+                        double vb = ina->GetComponentAsDouble(edgeB[i], c);
+                        a->SetComponentFromDouble(i, c, va + t*(vb-va));
+                    }
+                }
+                out->AddField(new eavlField(1, a, eavlField::ASSOC_POINTS));
+            }
+            else if (inf->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                     inf->GetAssocCellSet() == csindex)
+            {
+                eavlFloatArray *a = new eavlFloatArray(ina->GetName(), nc, ncells);
+                for (int i=0; i<ncells; i++)
+                    for (int c=0; c<nc; c++)
+                        a->SetComponentFromDouble(i, c,
+                               ina->GetComponentAsDouble(cellSources[i], c));
+                out->AddField(new eavlField(0, a,
+                                            eavlField::ASSOC_CELL_SET, 0));
+            }
+        }
+        return out;
+    }
+};
+
+#endif
@@ -0,0 +1,129 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Operation.h"
+
+#include "CalculatorOperation.h"
+#include "DecimateOperation.h"
+#include "ExternalFaceOperation.h"
+#include "ElevateOperation.h"
+#include "GradientOperation.h"
+#include "IsosurfaceOperation.h"
+#include "HistogramOperation.h"
+#include "SliceOperation.h"
+#include "StreamlineOperation.h"
+#include "SurfaceNormalsOperation.h"
+#include "ThresholdOperation.h"
+#include "TransformOperation.h"
+
+// drop what the shared caches know about an array about to be deleted,
+// since another one may well get the same address
+static void
+ForgetArray(eavlArray *a)
+{
+    Operation::fieldRanges.Forget(a);
+    Operation::recenterCache.Forget(a);
+}
+
+DataSetRefs Operation::dataSetRefs(ForgetArray);
+RecenterCache Operation::recenterCache(&Operation::dataSetRefs);
+FieldRangeCache Operation::fieldRanges;
+QMutex FilterLock::mutex;
+
+// ****************************************************************************
+// Method:  Operation::CreateOperation
+//
+// Purpose:
+///   Create a new operation (with default settings) given the name
+///   returned by its GetOperationName().
+//
+// Arguments:
+//   name       the operation name, e.g. "Isosurface"
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+Operation *
+Operation::CreateOperation(const std::string &name)
+{
+    if (name == "Isosurface")
+        return new IsosurfaceOperation;
+    else if (name == "Elevate")
+        return new ElevateOperation;
+    else if (name == "Calculator")
+        return new CalculatorOperation;
+    else if (name == "Decimate")
+        return new DecimateOperation;
+    else if (name == "ExternalFace")
+        return new ExternalFaceOperation;
+    else if (name == "Gradient")
+        return new GradientOperation;
+    else if (name == "Histogram")
+        return new HistogramOperation;
+    else if (name == "Slice")
+        return new SliceOperation;
+    else if (name == "Streamline")
+        return new StreamlineOperation;
+    else if (name == "SurfaceNormals")
+        return new SurfaceNormalsOperation;
+    else if (name == "Threshold")
+        return new ThresholdOperation;
+    else if (name == "Transform")
+        return new TransformOperation;
+
+    throw Exception("Unexpected operation %s", name.c_str());
+}
+
+// ****************************************************************************
+// Method:  Operation::RegisterSettingsTypes
+//
+// Purpose:
+///   Register the settings Attribute of every operation, so that a
+///   saved description containing them can be unserialized into a
+///   generic Attribute pointer.  It's safe to call this repeatedly.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Operation::RegisterSettingsTypes()
+{
+    Attribute::Register<IsosurfaceAttributes>();
+    Attribute::Register<ElevateAttributes>();
+    Attribute::Register<CalculatorAttributes>();
+    Attribute::Register<DecimateAttributes>();
+    Attribute::Register<GradientAttributes>();
+    Attribute::Register<HistogramAttributes>();
+    Attribute::Register<SliceAttributes>();
+    Attribute::Register<StreamlineAttributes>();
+    Attribute::Register<SurfaceNormalsAttributes>();
+    Attribute::Register<ThresholdAttributes>();
+    Attribute::Register<TransformAttributes>();
+}
+
+// ****************************************************************************
+// Method:  Operation::Clone
+//
+// Purpose:
+///   Create a new operation of the same type as this one, with a
+///   copy of its settings.  Since AttributeIndex::Copy isn't
+///   implemented, we copy the settings by serializing them.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+Operation *
+Operation::Clone()
+{
+    Operation *op = CreateOperation(GetOperationName());
+    if (GetSettings())
+        op->GetSettings()->BinaryUnserialize(GetSettings()->BinarySerialize());
+    return op;
+}
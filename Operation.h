@@ -9,6 +9,11 @@
 
 #include "STL.h"
 #include "Attribute.h"
+#include "eavlDataSet.h"
+#include "RecenterCache.h"
+#include "FieldRangeCache.h"
+#include "FilterLock.h"
+#include "DataSetRefs.h"
 
 // ****************************************************************************
 // Class:  Operation
@@ -20,18 +25,70 @@
 // Creation:    August 9, 2012
 //
 // Modifications:
+//   Added a virtual destructor, since pipelines can now be deleted.
+//
+//   The recenter cache is public, so pipelines can drop stale entries.
+//
+//   Added the data set reference counts.
+//
+//   Operations can ask for a field's range across all the chunks.
+//
+//   Operations are told how many chunks the pipeline runs.
+//
+//   Operations can combine every chunk's input into one result.
+//
 // ****************************************************************************
 class Operation
 {
   protected:
     eavlDataSet *input;
     eavlDataSet *output;
+    /// see GetMergedRangeVariables
+    bool         hasMergedRange;
+    FieldRange   mergedRange;
+    /// how many chunks the pipeline runs this for (each chunk has its
+    /// own copy of the operation)
+    int          nchunks;
+    /// see CombinesChunks
+    std::vector<eavlDataSet*> chunkInputs;
   public:
-    Operation() : input(NULL), output(NULL) { }
+    /// who holds the data sets the pipelines make, and their parts
+    static DataSetRefs dataSetRefs;
+    /// shared by all operations (and chunks)
+    static RecenterCache recenterCache;
+    /// shared by all operations and pipelines
+    static FieldRangeCache fieldRanges;
+
+    Operation() : input(NULL), output(NULL), hasMergedRange(false), nchunks(1) { }
+    virtual ~Operation() { }
     /// Get the variables the operation is requesting.
     virtual std::vector<std::string> GetNeededVariables() { return std::vector<std::string>(); }
     /// Get the variables this operation creates.
     virtual std::vector<std::string> GetOutputVariables() { return std::vector<std::string>(); }
+    /// Get the existing fields Execute changes in place.  The pipeline
+    /// gives the operation private copies of just these arrays; the
+    /// rest of its input is shared with the previous stage.
+    virtual std::vector<std::string> GetModifiedVariables() { return std::vector<std::string>(); }
+    /// Whether Execute changes the input's coordinates in place.  If so,
+    /// the pipeline also gives it private copies of the coordinate
+    /// systems and the fields their axes use.
+    virtual bool ModifiesCoordinates() { return false; }
+    /// Get the input fields whose range across all the chunks Execute
+    /// needs (e.g. to space isosurface levels).  The pipeline then
+    /// waits for every chunk's input, and passes the range (of all of
+    /// them together) to SetMergedRange before any chunk executes this.
+    virtual std::vector<std::string> GetMergedRangeVariables() { return std::vector<std::string>(); }
+    void SetMergedRange(const FieldRange &r) { hasMergedRange = true; mergedRange = r; }
+    void ClearMergedRange() { hasMergedRange = false; }
+    /// Set the number of chunks; the pipeline does this before Execute.
+    void SetNumChunks(int n) { nchunks = n; }
+    /// Whether Execute makes a single result from every chunk's input
+    /// (e.g. one histogram of all of them).  The pipeline then waits
+    /// for every chunk's input, passes them all to SetChunkInputs, and
+    /// executes only the first chunk's copy; the stages after this
+    /// have a single chunk.
+    virtual bool CombinesChunks() { return false; }
+    void SetChunkInputs(const std::vector<eavlDataSet*> &ds) { chunkInputs = ds; }
     /// Get the Attribute containing this operation's settings.
     virtual Attribute *GetSettings() = 0;
     /// Actual execution method for an operation.
@@ -46,6 +103,17 @@ class Operation
     virtual std::string GetOperationShortName() = 0;
     /// Get a short string describing the settings for this operation.
     virtual std::string GetOperationInfo() = 0;
+
+    /// Get a hash of the settings; operations of the same type with
+    /// equal hashes produce the same output from the same input.
+    uint64 GetSettingsHash() { return GetSettings() ? GetSettings()->ComputeHash() : 0; }
+    /// Create a new operation of the same type with the same settings.
+    Operation *Clone();
+    /// Create a new operation given its GetOperationName().
+    static Operation *CreateOperation(const std::string &name);
+    /// Register every operation's settings type, so they can be
+    /// unserialized through a generic Attribute pointer.
+    static void RegisterSettingsTypes();
 };
 
 #endif
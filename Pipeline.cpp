@@ -1,5 +1,1226 @@
 // Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
 #include "Pipeline.h"
+#include "PipelineAttributes.h"
 
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSemaphore>
+#include <QElapsedTimer>
+#include <QDir>
+#include <QStringList>
+
+#include "eavlCoordinates.h"
+#include "eavlFloatArray.h"
+#include "eavlIntArray.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <time.h>
+#endif
 
 vector<Pipeline*> Pipeline::allPipelines;
+int Pipeline::maxChunkThreads = 0;
+int Pipeline::prefetchSteps = 2;
+ResultCache Pipeline::resultCache(&Operation::dataSetRefs);
+ImporterPool Pipeline::importers;
+void (*Pipeline::backgroundExecutor)(Pipeline*) = NULL;
+
+static QMutex chunkPoolMutex;
+static QThreadPool *chunkPool = NULL;
+
+static QThreadPool *
+GetChunkThreadPool()
+{
+    QMutexLocker lock(&chunkPoolMutex);
+    if (!chunkPool)
+    {
+        chunkPool = new QThreadPool;
+        if (Pipeline::maxChunkThreads > 0)
+            chunkPool->setMaxThreadCount(Pipeline::maxChunkThreads);
+    }
+    return chunkPool;
+}
+
+// wall clock time in seconds since the first time this was called,
+// so profiles from all pipelines share one timeline
+static double
+GetWallTime()
+{
+    static QMutex timerMutex;
+    static QElapsedTimer *timer = NULL;
+    QMutexLocker lock(&timerMutex);
+    if (!timer)
+    {
+        timer = new QElapsedTimer;
+        timer->start();
+    }
+    return double(timer->nsecsElapsed()) * 1.e-9;
+}
+
+// CPU time in seconds used by the calling thread
+static double
+GetThreadCPUTime()
+{
+#ifdef _WIN32
+    FILETIME creation, exit, kernel, user;
+    GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user);
+    unsigned long long k = ((unsigned long long)kernel.dwHighDateTime << 32) | kernel.dwLowDateTime;
+    unsigned long long u = ((unsigned long long)user.dwHighDateTime << 32) | user.dwLowDateTime;
+    return double(k + u) * 1.e-7;
+#else
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return double(ts.tv_sec) + double(ts.tv_nsec) * 1.e-9;
+#endif
+}
+
+static void
+CountCellsAndPoints(eavlDataSet *ds, long long &ncells, long long &npoints)
+{
+    ncells = 0;
+    for (int i=0; i<ds->GetNumCellSets(); i++)
+        ncells += ds->GetCellSet(i)->GetNumCells();
+    npoints = ds->GetNumPoints();
+}
+
+template <class A, class T>
+static eavlArray *
+CopyHostArray(A *a)
+{
+    int nc = a->GetNumberOfComponents();
+    int nt = a->GetNumberOfTuples();
+    A *copy = new A(a->GetName(), nc, nt);
+    if (nc*nt > 0)
+        memcpy(copy->GetHostArray(), a->GetHostArray(), sizeof(T)*nc*nt);
+    return copy;
+}
+
+// ****************************************************************************
+// Function:  CopyArray
+//
+// Purpose:
+///   Create a deep copy of an array.  Float and int arrays are copied
+///   directly; anything else goes through doubles into a float array.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+static eavlArray *
+CopyArray(eavlArray *a)
+{
+    if (eavlFloatArray *fa = dynamic_cast<eavlFloatArray*>(a))
+        return CopyHostArray<eavlFloatArray,float>(fa);
+    if (eavlIntArray *ia = dynamic_cast<eavlIntArray*>(a))
+        return CopyHostArray<eavlIntArray,int>(ia);
+
+    int nc = a->GetNumberOfComponents();
+    int nt = a->GetNumberOfTuples();
+    eavlFloatArray *copy = new eavlFloatArray(a->GetName(), nc, nt);
+    for (int i=0; i<nt; i++)
+        for (int c=0; c<nc; c++)
+            copy->SetComponentFromDouble(i, c, a->GetComponentAsDouble(i, c));
+    return copy;
+}
+
+// ****************************************************************************
+// Function:  CopyField
+//
+// Purpose:
+///   Create a field with the same association as another, but with
+///   its own copy of the array.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+static eavlField *
+CopyField(eavlField *f)
+{
+    eavlArray *a = CopyArray(f->GetArray());
+    switch (f->GetAssociation())
+    {
+      case eavlField::ASSOC_CELL_SET:
+        return new eavlField(f->GetOrder(), a, f->GetAssociation(),
+                             f->GetAssocCellSet());
+      case eavlField::ASSOC_LOGICALDIM:
+        return new eavlField(f->GetOrder(), a, f->GetAssociation(),
+                             f->GetAssocLogicalDim());
+      default:
+        return new eavlField(f->GetOrder(), a, f->GetAssociation());
+    }
+}
+
+// ****************************************************************************
+// Function:  CreateWritableCopy
+//
+// Purpose:
+///   Copy-on-write for mutators.  Results share arrays with the stage
+///   they came from, so an operation which changes its input in place
+///   would also change every earlier result (and whatever the cache
+///   holds for them).  This makes a new data set which shares all the
+///   cell sets and fields with the old one, except for the fields the
+///   operation says it writes, which get private copies.  For an
+///   operation that changes the coordinates, that means the
+///   coordinate systems and the fields their axes use, and nothing
+///   else; e.g. Elevate copies the point coordinates but not the
+///   field it elevates by.
+///
+///   Adding a cell set or field (like ExternalFace or SurfaceNormals)
+///   only needs the new data set structure, not any copies.
+//
+// Arguments:
+//   ds         the previous stage's result
+//   op         the operation that is about to execute on it
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+static eavlDataSet *
+CreateWritableCopy(eavlDataSet *ds, Operation *op)
+{
+    std::vector<std::string> modified = op->GetModifiedVariables();
+    std::set<std::string> copyFields(modified.begin(), modified.end());
+    bool copyCoords = op->ModifiesCoordinates();
+    if (copyCoords)
+    {
+        for (int i=0; i<ds->GetNumCoordinateSystems(); i++)
+        {
+            eavlCoordinates *cs = ds->GetCoordinateSystem(i);
+            for (int j=0; j<cs->GetDimension(); j++)
+            {
+                eavlCoordinateAxisField *axis =
+                    dynamic_cast<eavlCoordinateAxisField*>(cs->GetAxis(j));
+                if (axis)
+                    copyFields.insert(axis->GetFieldName());
+            }
+        }
+    }
+
+    if (copyFields.empty() && !copyCoords)
+        return ds->CreateShallowCopy();
+
+    eavlDataSet *out = new eavlDataSet;
+    out->SetNumPoints(ds->GetNumPoints());
+    out->SetLogicalStructure(ds->GetLogicalStructure());
+    for (int i=0; i<ds->GetNumCoordinateSystems(); i++)
+    {
+        // the axes refer to fields by name, so the copy picks up the
+        // copied fields without changing them; other kinds of
+        // coordinates are shared
+        eavlCoordinates *cs = ds->GetCoordinateSystem(i);
+        eavlCoordinatesCartesian *cart =
+            dynamic_cast<eavlCoordinatesCartesian*>(cs);
+        if (copyCoords && cart)
+            cs = new eavlCoordinatesCartesian(*cart);
+        out->AddCoordinateSystem(cs);
+    }
+    for (int i=0; i<ds->GetNumCellSets(); i++)
+        out->AddCellSet(ds->GetCellSet(i));
+    for (int i=0; i<ds->GetNumFields(); i++)
+    {
+        eavlField *f = ds->GetField(i);
+        if (copyFields.count(f->GetArray()->GetName()))
+            f = CopyField(f);
+        out->AddField(f);
+    }
+    return out;
+}
+
+// ****************************************************************************
+// Function:  ForgetNewArrayRanges
+//
+// Purpose:
+///   Drop any cached ranges and recentered fields for the arrays an
+///   operation produced, i.e. the ones in its output that weren't in
+///   its input.  A filter can hand back the same arrays, with new
+///   contents, each time it runs.
+//
+// Arguments:
+//   in         the operation's input
+//   out        the operation's output
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Forget the arrays in the recenter cache too.
+//
+// ****************************************************************************
+static void
+ForgetNewArrayRanges(eavlDataSet *in, eavlDataSet *out)
+{
+    std::set<eavlArray*> old;
+    for (int i=0; i<in->GetNumFields(); i++)
+        old.insert(in->GetField(i)->GetArray());
+    for (int i=0; i<out->GetNumFields(); i++)
+    {
+        eavlArray *a = out->GetField(i)->GetArray();
+        if (!old.count(a))
+        {
+            Operation::fieldRanges.Forget(a);
+            Operation::recenterCache.Forget(a);
+        }
+    }
+}
+
+// ****************************************************************************
+// Class:  ChunkTask
+//
+// Purpose:
+///   Runs the operation chain for one chunk of a pipeline on the
+///   chunk thread pool.  Errors are passed back as text since we
+///   can't throw across threads.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Run only up to a given stage.
+//
+// ****************************************************************************
+class ChunkTask : public QRunnable
+{
+  public:
+    Pipeline                       *pipe;
+    int                             chunk;
+    int                             firstStage;
+    int                             endStage;
+    const std::vector<std::string> *vars;
+    ImporterHandle                 *importer;
+    std::string                    *error;
+    QSemaphore                     *done;
+  public:
+    virtual void run()
+    {
+        try
+        {
+            pipe->ExecuteChunk(chunk, firstStage, endStage, *vars, importer);
+        }
+        catch (const eavlException &e)
+        {
+            *error = e.GetErrorText();
+        }
+        catch (const Exception &e)
+        {
+            *error = e.message;
+        }
+        catch (...)
+        {
+            *error = "unknown error executing chunk";
+        }
+        done->release();
+    }
+};
+
+// ****************************************************************************
+// Method:  Pipeline::Execute
+//
+// Purpose:
+///   Bring the results up to date.  Each chunk of the source runs
+///   the whole operation chain independently, and chunks are run
+///   concurrently on a thread pool, though only one at a time may be
+///   reading a file or running an EAVL filter (see FilterLock).  The
+///   exception is an operation which needs a field's range across all
+///   the chunks, or which combines them into one result; every chunk's
+///   input to it is finished first.
+///   Stages which are already in
+///   the results are not re-executed.  A cancel request stops it
+///   between chunks and operations; like any other error, the stages
+///   every chunk finished are kept and an exception is thrown.
+//
+// Arguments:
+//   none
+//
+// Programmer:  Jeremy Meredith
+// Creation:    August 3, 2012
+//
+// Modifications:
+//   Added geometry sources.
+//
+//   Added pipeline sources.
+//
+//   Get the file's chunk count from the importer pool, and only hold
+//   an importer while reading.
+//
+//   Open the file first, since it may be a new time step.
+//
+//   EAVL filters only run one at a time.
+//
+//   Results are reference counted.
+//
+//   Wait for every chunk before an operation which needs a merged
+//   field range.
+//
+//   The stages after an operation which combines the chunks have only
+//   one chunk.
+//
+// ****************************************************************************
+void
+Pipeline::Execute()
+{
+    //cerr << "\n\n>>>>EXECUTE\n\n\n";
+
+    if (source->sourcetype == Source::Pipe)
+        ExecuteSourcePipeline();
+
+    int nstages = ops.size() + 1;
+    int firstStage = results.size();
+    if (firstStage >= nstages)
+        return;
+    generation++;
+
+    std::vector<std::string> vars;
+    int nchunks;
+    if (firstStage == 0 && source->sourcetype == Source::Pipe)
+    {
+        // share the source pipeline's results; nothing is copied
+        Pipeline *up = source->source_pipe;
+        nchunks = up->results.back().size();
+        results.push_back(std::vector<eavlDataSet*>(nchunks, (eavlDataSet*)NULL));
+        sourceGeneration = up->generation;
+        profile.assign(1, std::vector<StageProfile>(nchunks));
+        for (int c=0; c<nchunks; c++)
+        {
+            SetResult(0, c, up->results.back()[c]);
+            profile[0][c].start = GetWallTime();
+            CountCellsAndPoints(results[0][c], profile[0][c].outCells,
+                                profile[0][c].outPoints);
+        }
+        firstStage = 1;
+    }
+    else if (firstStage == 0)
+    {
+        if (source->sourcetype == Source::File && source->file == "")
+            throw eavlException("no source file selected");
+
+        // the file (e.g. a new time step) may not have been opened
+        // yet, or may have changed since
+        if (source->sourcetype == Source::File &&
+            !importers.Open(source->file))
+            throw eavlException("couldn't open " + source->file);
+
+        // find the variables needed by the operations and plots
+        vars = GetNeededSourceVariables();
+        if (source->sourcetype == Source::Geometry)
+            nchunks = GeometrySource::GetNumChunks(source->geometry);
+        else
+            nchunks = importers.GetNumChunks(source->file, source->mesh);
+        if (nchunks < 1)
+            throw eavlException("source mesh has no chunks");
+    }
+    else
+    {
+        nchunks = results[0].size();
+    }
+
+    // a stage has a single chunk after an operation that combines them
+    std::vector<int> stageChunks(nstages, nchunks);
+    for (int s=1; s<nstages; s++)
+        stageChunks[s] = ops[s-1]->CombinesChunks() ? 1 : stageChunks[s-1];
+
+    {
+        QMutexLocker lock(&progressMutex);
+        progressChunks = nchunks;
+        stageProgress.assign(nstages, 0);
+        for (int s=0; s<firstStage; s++)
+            stageProgress[s] = nchunks;
+    }
+
+    // make room for every stage up front; each chunk only ever
+    // fills in its own entries, so the chunks don't have to lock
+    profile.resize(firstStage);
+    for (int s=firstStage; s<nstages; s++)
+    {
+        results.push_back(std::vector<eavlDataSet*>(stageChunks[s],
+                                                    (eavlDataSet*)NULL));
+        profile.push_back(std::vector<StageProfile>(stageChunks[s]));
+    }
+    if (firstStage == 0)
+        PrepareCacheKeys(std::set<std::string>(vars.begin(), vars.end()));
+    else
+        PrepareCacheKeys(loadedVariables);
+    PrepareChunkOperations(firstStage, stageChunks);
+
+    // hold the file open only while we're reading it
+    ImporterHandle importer(importers, (firstStage == 0 &&
+                                        source->sourcetype == Source::File)
+                                       ? source->file : "");
+
+    // run the chunks up to each operation that needs its input's
+    // range across all of them, or combines them, then give it the
+    // range and go on
+    for (int start = firstStage; start < nstages; )
+    {
+        int end = start + 1;
+        while (end < nstages &&
+               ops[end-1]->GetMergedRangeVariables().empty() &&
+               !ops[end-1]->CombinesChunks())
+            end++;
+        if (start > 0)
+            PrepareMergedRange(start);
+        ExecuteStages(start, end, stageChunks[start], vars, &importer);
+        if (start == 0)
+            loadedVariables = std::set<std::string>(vars.begin(), vars.end());
+        start = end;
+    }
+}
+
+// ****************************************************************************
+// Method:  Pipeline::ExecuteStages
+//
+// Purpose:
+///   Run every chunk from one stage up to (not including) another,
+///   on the chunk thread pool, and wait for them.  On error, only the
+///   stages every chunk finished are kept, and an exception is thrown.
+//
+// Arguments:
+//   firstStage the first result stage to generate
+//   endStage   the stage after the last one to generate
+//   nchunks    the number of chunks
+//   vars       the fields to read from the source if firstStage is 0
+//   importer   the importer to read them with, for a file source
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::ExecuteStages(int firstStage, int endStage, int nchunks,
+                        const std::vector<std::string> &vars,
+                        ImporterHandle *importer)
+{
+    std::vector<std::string> errors(nchunks);
+    QSemaphore done(0);
+    for (int c=0; c<nchunks; c++)
+    {
+        // chunks check for cancellation themselves, but there's no
+        // point queueing any more of them
+        if (cancelRequested)
+        {
+            for (int rest=c; rest<nchunks; rest++)
+                errors[rest] = "execution cancelled";
+            done.release(nchunks-c);
+            break;
+        }
+
+        ChunkTask *task = new ChunkTask;
+        task->pipe = this;
+        task->chunk = c;
+        task->firstStage = firstStage;
+        task->endStage = endStage;
+        task->vars = &vars;
+        task->importer = importer;
+        task->error = &errors[c];
+        task->done = &done;
+        if (nchunks == 1)
+        {
+            // don't bother with a thread for the simple case
+            task->run();
+            delete task;
+        }
+        else
+        {
+            GetChunkThreadPool()->start(task);
+        }
+    }
+    done.acquire(nchunks);
+
+    // on error, keep only the stages every chunk finished
+    int failed = -1;
+    for (int c=0; c<nchunks && failed<0; c++)
+    {
+        if (errors[c] != "")
+            failed = c;
+    }
+    if (failed >= 0)
+    {
+        int complete = endStage;
+        for (int c=0; c<nchunks; c++)
+        {
+            int n = 0;
+            while (n < complete && results[n][c] != NULL)
+                n++;
+            complete = n;
+        }
+        ReleaseResults(complete);
+        if (complete == 0)
+            loadedVariables.clear();
+        throw eavlException(errors[failed]);
+    }
+}
+
+// ****************************************************************************
+// Method:  Pipeline::PrepareMergedRange
+//
+// Purpose:
+///   If the operation generating a stage needs its input fields'
+///   range across all the chunks, work it out from the previous
+///   stage (which every chunk must have finished) and pass it to the
+///   operation and its chunk copies.
+//
+// Arguments:
+//   stage      the result stage about to be generated
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::PrepareMergedRange(int stage)
+{
+    Operation *op = ops[stage-1];
+    std::vector<std::string> vars = op->GetMergedRangeVariables();
+    if (vars.empty())
+        return;
+
+    FieldRange merged;
+    bool found = false;
+    for (size_t c=0; c<results[stage-1].size(); c++)
+    {
+        eavlDataSet *ds = results[stage-1][c];
+        for (int j=0; j<ds->GetNumFields(); j++)
+        {
+            eavlArray *a = ds->GetField(j)->GetArray();
+            if (std::find(vars.begin(), vars.end(), a->GetName()) == vars.end())
+                continue;
+            FieldRange r = Operation::fieldRanges.GetRange(a);
+            if (!found)
+                merged = r;
+            merged.minval = std::min(merged.minval, r.minval);
+            merged.maxval = std::max(merged.maxval, r.maxval);
+            merged.minmag = std::min(merged.minmag, r.minmag);
+            merged.maxmag = std::max(merged.maxmag, r.maxmag);
+            found = true;
+        }
+    }
+
+    // without it, each chunk falls back to its own range
+    std::vector<Operation*> chunkCopies(1, op);
+    if (chunkOps.count(op))
+        chunkCopies.insert(chunkCopies.end(), chunkOps[op].begin(),
+                           chunkOps[op].end());
+    for (size_t i=0; i<chunkCopies.size(); i++)
+    {
+        if (found)
+            chunkCopies[i]->SetMergedRange(merged);
+        else
+            chunkCopies[i]->ClearMergedRange();
+    }
+}
+
+// ****************************************************************************
+// Method:  Pipeline::ExecuteSourcePipeline
+//
+// Purpose:
+///   For a pipeline source, ask it for the fields we need and bring
+///   it up to date.  That only executes whatever part of it is
+///   stale, and if its results changed since we took them, ours are
+///   thrown away.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::ExecuteSourcePipeline()
+{
+    Pipeline *up = source->source_pipe;
+    if (!up)
+        throw eavlException("no source pipeline selected");
+    if (up == this || up->DependsOn(this))
+        throw eavlException("a pipeline can't be its own source");
+
+    std::set<std::string> needed = GetNeededVariables();
+    for (std::set<std::string>::iterator it = needed.begin();
+         it != needed.end(); ++it)
+        up->RequestVariable(*it);
+    up->Execute();
+
+    if (!results.empty() && sourceGeneration != up->generation)
+        ClearResults();
+}
+
+// ****************************************************************************
+// Method:  Pipeline::PrepareCacheKeys
+//
+// Purpose:
+///   Build the result cache key for every stage.  The key for a stage
+///   is the key of its input plus the name and settings hash of the
+///   operation that generates it.  This is done up front, while
+///   nothing else can be changing the settings.
+//
+// Arguments:
+//   sourcevars the fields read (or to be read) into results[0]
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::PrepareCacheKeys(const std::set<std::string> &sourcevars)
+{
+    stageKeys.resize(ops.size() + 1);
+    stageKeys[0] = GetSourceCacheKey(sourcevars);
+    for (size_t i=0; i<ops.size(); i++)
+    {
+        std::ostringstream key;
+        key << stageKeys[i] << "|" << ops[i]->GetOperationName()
+            << ":" << std::hex << ops[i]->GetSettingsHash();
+        stageKeys[i+1] = key.str();
+    }
+}
+
+// ****************************************************************************
+// Method:  Pipeline::PrepareChunkOperations
+//
+// Purpose:
+///   Make sure every chunk past the first has its own copy of each
+///   operation we're about to execute, with up-to-date settings, and
+///   tell them all how many chunks they run for.  This must happen
+///   before the chunks start running.
+//
+// Arguments:
+//   firstStage  the first result stage we're going to generate
+//   stageChunks the number of chunks in each stage
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   The stages after an operation which combines the chunks have one.
+//
+// ****************************************************************************
+void
+Pipeline::PrepareChunkOperations(int firstStage,
+                                 const std::vector<int> &stageChunks)
+{
+    for (size_t i=0; i<ops.size(); i++)
+        ops[i]->SetNumChunks(stageChunks[i+1]);
+
+    for (int i = std::max(firstStage-1, 0); i < (int)ops.size(); i++)
+    {
+        int nchunks = stageChunks[i+1];
+        if (nchunks <= 1)
+            continue;
+
+        std::vector<Operation*> &copies = chunkOps[ops[i]];
+        while ((int)copies.size() < nchunks-1)
+            copies.push_back(ops[i]->Clone());
+
+        // the settings may have changed since the copies were made
+        if (ops[i]->GetSettings())
+        {
+            string settings = ops[i]->GetSettings()->XMLSerialize();
+            for (size_t c=0; c<copies.size(); c++)
+                copies[c]->GetSettings()->XMLUnserialize(settings);
+        }
+        for (size_t c=0; c<copies.size(); c++)
+            copies[c]->SetNumChunks(nchunks);
+    }
+}
+
+// ****************************************************************************
+// Method:  Pipeline::ExecuteChunk
+//
+// Purpose:
+///   Read or generate the source (if needed) and run the operations
+///   on a single chunk.
+///   This may be called from a thread pool thread.
+//
+// Arguments:
+//   chunk      the chunk (domain) index
+//   firstStage the first result stage to generate
+//   endStage   the stage after the last one to generate
+//   vars       the fields to read from the source if firstStage is 0
+//   importer   the importer to read them with, for a file source
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   The importer is passed in, since it's only held while executing.
+//
+//   Results are reference counted, and the operation's scratch copy of
+//   its input is freed afterwards.
+//
+//   Read through the importer handle, which does the locking.
+//
+//   Stop at the given stage.
+//
+//   An operation which combines the chunks gets all of their inputs.
+//
+// ****************************************************************************
+void
+Pipeline::ExecuteChunk(int chunk, int firstStage, int endStage,
+                       const std::vector<std::string> &vars,
+                       ImporterHandle *importer)
+{
+    if (cancelRequested)
+        throw eavlException("execution cancelled");
+
+    if (firstStage == 0)
+    {
+        StageProfile &prof = profile[0][chunk];
+        prof.start = GetWallTime();
+        double cpu = GetThreadCPUTime();
+
+        std::string key = GetChunkCacheKey(stageKeys[0], chunk);
+        eavlDataSet *ds = resultCache.Find(key);
+        if (ds)
+        {
+            prof.ncached = 1;
+        }
+        else if (source->sourcetype == Source::Geometry)
+        {
+            // chunks are generated independently, so no lock
+            GeometrySource generator(source->geometry, chunk);
+            ds = generator.CreateMesh();
+            for (size_t i=0; i<vars.size(); i++)
+                ds->AddField(generator.CreateField(vars[i]));
+            resultCache.Insert(key, ds);
+            prof.bytes = ds->GetMemoryUsage();
+        }
+        else
+        {
+            // read the mesh and vars; the handle only lets one chunk
+            // at a time into the importer
+            ds = importer->GetMesh(source->mesh, chunk);
+
+            ds = ds->CreateShallowCopy();
+            for (size_t i=0; i<vars.size(); i++)
+            {
+                eavlField *f = importer->GetField(vars[i], source->mesh, chunk);
+                ds->AddField(f);
+            }
+            resultCache.Insert(key, ds);
+            prof.bytes = ds->GetMemoryUsage();
+        }
+        SetResult(0, chunk, ds);
+
+        CountCellsAndPoints(ds, prof.outCells, prof.outPoints);
+        prof.wallTime = GetWallTime() - prof.start;
+        prof.cpuTime = GetThreadCPUTime() - cpu;
+        StageFinished(0);
+        firstStage = 1;
+    }
+
+    for (int stage = firstStage; stage < endStage; stage++)
+    {
+        if (cancelRequested)
+            throw eavlException("execution cancelled");
+
+        StageProfile &prof = profile[stage][chunk];
+        prof.start = GetWallTime();
+        double cpu = GetThreadCPUTime();
+        CountCellsAndPoints(results[stage-1][chunk],
+                            prof.inCells, prof.inPoints);
+
+        // an operation which combines the chunks reads all of them
+        std::vector<eavlDataSet*> inputs;
+        if (ops[stage-1]->CombinesChunks())
+        {
+            inputs = results[stage-1];
+            for (size_t c=1; c<inputs.size(); c++)
+            {
+                long long ncells, npoints;
+                CountCellsAndPoints(inputs[c], ncells, npoints);
+                prof.inCells += ncells;
+                prof.inPoints += npoints;
+            }
+        }
+
+        std::string key = GetChunkCacheKey(stageKeys[stage], chunk);
+        eavlDataSet *cached = resultCache.Find(key);
+        if (cached)
+        {
+            SetResult(stage, chunk, cached);
+            prof.ncached = 1;
+            CountCellsAndPoints(cached, prof.outCells, prof.outPoints);
+            prof.wallTime = GetWallTime() - prof.start;
+            prof.cpuTime = GetThreadCPUTime() - cpu;
+            StageFinished(stage);
+            continue;
+        }
+
+        eavlDataSet *ds = results[stage-1][chunk];
+        long long inBytes = ds->GetMemoryUsage();
+
+        // execute each operation on a copy of the previous result
+        // that it's allowed to change, so the earlier stages (and
+        // the importer's data) stay intact; hold on to the copy
+        // while it runs, along with whatever it adds to it
+        Operation *op = ops[stage-1];
+        if (chunk > 0)
+            op = chunkOps.find(op)->second[chunk-1];
+        ds = CreateWritableCopy(ds, op);
+        Operation::dataSetRefs.Retain(ds);
+        op->SetInput(ds);
+        op->SetChunkInputs(inputs);
+        try
+        {
+            op->Execute();
+        }
+        catch (...)
+        {
+            op->SetInput(NULL);
+            op->SetChunkInputs(std::vector<eavlDataSet*>());
+            Operation::dataSetRefs.Release(ds);
+            throw;
+        }
+
+        // the output is ours (see DataSetRefs); once it's held, let
+        // go of the copy, which frees it unless it's the output
+        eavlDataSet *out = op->GetOutput();
+        SetResult(stage, chunk, out);
+        ForgetNewArrayRanges(ds, out);
+
+        // a mutator's output shares everything with the previous
+        // result but its copies, so only count what it added
+        prof.bytes = out->GetMemoryUsage();
+        if (out == ds)
+            prof.bytes = std::max(0LL, prof.bytes - inBytes);
+        op->SetInput(NULL);
+        op->SetChunkInputs(std::vector<eavlDataSet*>());
+        Operation::dataSetRefs.Release(ds);
+        CountCellsAndPoints(out, prof.outCells, prof.outPoints);
+        prof.wallTime = GetWallTime() - prof.start;
+        prof.cpuTime = GetThreadCPUTime() - cpu;
+
+        resultCache.Insert(key, out);
+        StageFinished(stage);
+
+        //cerr << "Executed op to generate result["<<stage<<"]["<<chunk<<"], summary = \n";
+        //op->GetOutput()->PrintSummary(cerr);
+    }
+}
+
+// escape a string for use in JSON
+static string
+JSONEscape(const string &s)
+{
+    string r;
+    for (size_t i=0; i<s.length(); i++)
+    {
+        if (s[i] == '"' || s[i] == '\\')
+            r += '\\';
+        if ((unsigned char)s[i] >= 32)
+            r += s[i];
+    }
+    return r;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::WriteChromeTrace
+//
+// Purpose:
+///   Write the latest profile of every pipeline in the Chrome trace
+///   event format (see chrome://tracing).  Each pipeline is a process
+///   and each chunk is a thread, and times are in microseconds.
+//
+// Arguments:
+//   out        the stream to write to
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Pipeline::WriteChromeTrace(ostream &out)
+{
+    out << "{\"traceEvents\":[" << endl;
+    bool first = true;
+    for (size_t p=0; p<allPipelines.size(); p++)
+    {
+        Pipeline *pipe = allPipelines[p];
+        if (pipe->IsExecuting())
+            continue;
+
+        out << (first ? "" : ",\n")
+            << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << p
+            << ",\"args\":{\"name\":\"" << JSONEscape(pipe->GetName()) << "\"}}";
+        first = false;
+
+        int nstages = std::min(pipe->results.size(), pipe->profile.size());
+        for (int s=0; s<nstages; s++)
+        {
+            string name = (s == 0) ? pipe->source->GetSourceType()
+                                   : pipe->ops[s-1]->GetOperationName();
+            for (size_t c=0; c<pipe->profile[s].size(); c++)
+            {
+                const StageProfile &prof = pipe->profile[s][c];
+                if (s == 0)
+                {
+                    out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << p
+                        << ",\"tid\":" << c
+                        << ",\"args\":{\"name\":\"chunk " << c << "\"}}";
+                }
+                out << ",\n{\"name\":\"" << JSONEscape(name) << "\""
+                    << ",\"cat\":\"" << (s == 0 ? "source" : "operation") << "\""
+                    << ",\"ph\":\"X\""
+                    << ",\"pid\":" << p << ",\"tid\":" << c
+                    << ",\"ts\":" << (long long)(prof.start * 1.e6)
+                    << ",\"dur\":" << (long long)(prof.wallTime * 1.e6)
+                    << ",\"args\":{"
+                    << "\"stage\":" << s
+                    << ",\"cpu_ms\":" << prof.cpuTime * 1.e3
+                    << ",\"cached\":" << (prof.ncached ? "true" : "false")
+                    << ",\"in_cells\":" << prof.inCells
+                    << ",\"in_points\":" << prof.inPoints
+                    << ",\"out_cells\":" << prof.outCells
+                    << ",\"out_points\":" << prof.outPoints
+                    << ",\"bytes\":" << prof.bytes
+                    << "}}";
+            }
+        }
+    }
+    out << endl << "]}" << endl;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::CreateAttributes
+//
+// Purpose:
+///   Create a description of this pipeline's source and operations
+///   which can be serialized.  The settings are copies, so the
+///   description stays valid if the pipeline changes.
+//
+// Arguments:
+//   none
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Added time series.
+//
+// ****************************************************************************
+PipelineAttributes *
+Pipeline::CreateAttributes()
+{
+    PipelineAttributes *atts = new PipelineAttributes;
+    if (source->sourcetype == Source::Geometry)
+    {
+        atts->geometry = new GeometryAttributes;
+        atts->geometry->BinaryUnserialize(source->geometry->BinarySerialize());
+    }
+    else if (source->sourcetype == Source::Pipe)
+    {
+        std::vector<Pipeline*>::iterator it =
+            std::find(allPipelines.begin(), allPipelines.end(),
+                      source->source_pipe);
+        if (it != allPipelines.end())
+            atts->sourcePipeline = it - allPipelines.begin();
+    }
+    else
+    {
+        atts->file = source->file;
+        atts->mesh = source->mesh;
+        atts->timeFiles = source->timeFiles;
+        atts->timeIndex = source->timeIndex;
+    }
+    for (size_t i=0; i<ops.size(); i++)
+    {
+        OperationAttributes *opatts = new OperationAttributes;
+        opatts->name = ops[i]->GetOperationName();
+        Attribute *settings = ops[i]->GetSettings();
+        if (settings)
+        {
+            opatts->settings = Attribute::CreateAttribute(settings->GetType());
+            opatts->settings->BinaryUnserialize(settings->BinarySerialize());
+        }
+        atts->ops.push_back(opatts);
+    }
+    return atts;
+}
+
+// ****************************************************************************
+// Method:  Pipeline::SetFromAttributes
+//
+// Purpose:
+///   Replace the source and operations with those in a description,
+///   opening the file (if it has one) in the importer pool.  A
+///   pipeline source refers to another pipeline in a session, so it's
+///   up to the caller to connect it.  Throws an Exception if
+///   the file or an operation can't be created, in which case the
+///   pipeline is left unchanged.
+//
+// Arguments:
+//   atts       the description
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Added time series.
+//
+//   Delete the operations being replaced.
+//
+// ****************************************************************************
+void
+Pipeline::SetFromAttributes(PipelineAttributes *atts)
+{
+    std::vector<std::string> timeFiles = atts->timeFiles;
+    if (timeFiles.empty() && atts->timePattern != "")
+    {
+        timeFiles = Source::ExpandFilePattern(atts->timePattern);
+        if (timeFiles.empty())
+            throw Exception("No files match %s", atts->timePattern.c_str());
+    }
+    std::string file = atts->file;
+    if (!timeFiles.empty())
+        file = timeFiles[std::max(0, std::min(atts->timeIndex,
+                                              (int)timeFiles.size()-1))];
+
+    if (file != "" && !atts->geometry)
+    {
+        if (!importers.Open(file))
+            throw Exception("Couldn't open file %s", file.c_str());
+    }
+
+    std::vector<Operation*> newops;
+    for (size_t i=0; i<atts->ops.size(); i++)
+    {
+        OperationAttributes *opatts = atts->ops[i];
+        Operation *op = Operation::CreateOperation(opatts->name);
+        if (op->GetSettings() && opatts->settings)
+            op->GetSettings()->BinaryUnserialize(opatts->settings->BinarySerialize());
+        newops.push_back(op);
+    }
+
+    ClearResults();
+    for (size_t i=0; i<ops.size(); i++)
+        DeleteOperation(ops[i]);
+    ops = newops;
+    source->sourcetype = atts->geometry ? Source::Geometry : Source::File;
+    source->file = file;
+    source->mesh = atts->mesh;
+    source->timeFiles = timeFiles;
+    source->timeIndex = 0;
+    source->SetTimeIndex(atts->timeIndex);
+    if (atts->geometry)
+        source->geometry->BinaryUnserialize(atts->geometry->BinarySerialize());
+}
+
+// compare file names with the numbers in them in numerical order
+static bool
+TimeStepNameLess(const std::string &a, const std::string &b)
+{
+    size_t i = 0, j = 0;
+    while (i < a.size() && j < b.size())
+    {
+        if (isdigit(a[i]) && isdigit(b[j]))
+        {
+            size_t ie = i, je = j;
+            while (ie < a.size() && isdigit(a[ie]))
+                ie++;
+            while (je < b.size() && isdigit(b[je]))
+                je++;
+            // compare by value: drop leading zeros, then length, then digits
+            size_t i0 = i, j0 = j;
+            while (i0 < ie-1 && a[i0] == '0')
+                i0++;
+            while (j0 < je-1 && b[j0] == '0')
+                j0++;
+            if (ie-i0 != je-j0)
+                return ie-i0 < je-j0;
+            int c = a.compare(i0, ie-i0, b, j0, je-j0);
+            if (c != 0)
+                return c < 0;
+            i = ie;
+            j = je;
+        }
+        else
+        {
+            if (a[i] != b[j])
+                return a[i] < b[j];
+            i++;
+            j++;
+        }
+    }
+    return a.size()-i < b.size()-j;
+}
+
+// ****************************************************************************
+// Method:  Source::ExpandFilePattern
+//
+// Purpose:
+///   Find the files of a time series given a pattern with * and ?
+///   wildcards in its file name (not its directory), in the order of
+///   the numbers in their names.
+//
+// Arguments:
+//   pattern    e.g. /data/run_*.silo
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::vector<std::string>
+Source::ExpandFilePattern(const std::string &pattern)
+{
+    QFileInfo info(pattern.c_str());
+    QDir dir = info.dir();
+    QStringList names = dir.entryList(QStringList() << info.fileName(),
+                                      QDir::Files);
+    std::vector<std::string> files;
+    for (int i=0; i<names.size(); i++)
+        files.push_back(dir.filePath(names[i]).toStdString());
+    SortTimeSteps(files);
+    return files;
+}
+
+// ****************************************************************************
+// Method:  Source::SortTimeSteps
+//
+// Purpose:
+///   Put the files of a time series in the order of the numbers in
+///   their names, so run_9 comes before run_10 even if the numbers
+///   aren't zero-padded.
+//
+// Arguments:
+//   files      the files to sort
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+void
+Source::SortTimeSteps(std::vector<std::string> &files)
+{
+    std::sort(files.begin(), files.end(), TimeStepNameLess);
+}
+
+// ****************************************************************************
+// Method:  Source::GetTimeSeriesPattern
+//
+// Purpose:
+///   Guess the pattern for the time series a file belongs to, by
+///   replacing the last number in its name with a wildcard, e.g.
+///   /data/run_0042.silo gives /data/run_*.silo.  A name without a
+///   number gives itself.
+//
+// Arguments:
+//   fn         a file from the series
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+std::string
+Source::GetTimeSeriesPattern(const std::string &fn)
+{
+    size_t slash = fn.find_last_of("/\\");
+    size_t start = (slash == std::string::npos) ? 0 : slash+1;
+    size_t end = fn.size();
+    while (end > start && !isdigit(fn[end-1]))
+        end--;
+    if (end == start)
+        return fn;
+    size_t begin = end;
+    while (begin > start && isdigit(fn[begin-1]))
+        begin--;
+    return fn.substr(0, begin) + "*" + fn.substr(end);
+}
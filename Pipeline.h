@@ -3,12 +3,20 @@
 #define PIPELINE_H
 
 #include "STL.h"
-#include "eavlImporter.h"
+#include <set>
+#include <algorithm>
+#include "ImporterPool.h"
 #include "Operation.h"
 #include <QFileInfo>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
 #include "DSInfo.h"
+#include "GeometrySource.h"
+#include "ResultCache.h"
 
 struct Pipeline;
+class PipelineAttributes;
 
 // ****************************************************************************
 // Struct:  Source
@@ -20,6 +28,15 @@ struct Pipeline;
 // Creation:    August 3, 2012
 //
 // Modifications:
+//   Added the geometry settings and GetFieldList.
+//
+//   Describe pipeline sources by the pipeline's name.
+//
+//   Files come from Pipeline::importers rather than holding an
+//   importer of their own.
+//
+//   Added time series of files.
+//
 // ****************************************************************************
 struct Source
 {
@@ -28,19 +45,49 @@ struct Source
 
     Pipeline     *source_pipe;
     
-    eavlImporter *source_file;
     std::string   file;
     std::string   mesh;
     //std::string   var;
+    /// every file of a time series in order, or empty for a single
+    /// file; file is always the one at timeIndex
+    std::vector<std::string> timeFiles;
+    int           timeIndex;
+
+    GeometryAttributes *geometry;
 
   public:
     Source()
         : sourcetype(File),
           source_pipe(NULL),
-          source_file(NULL),
-          file(""), mesh("")
+          file(""), mesh(""),
+          timeIndex(0),
+          geometry(new GeometryAttributes)
+    {
+    }
+    ~Source()
+    {
+        delete geometry;
+    }
+    int GetNumTimeSteps()
+    {
+        return timeFiles.empty() ? 1 : timeFiles.size();
+    }
+    /// Move to another time step of a series, clamped to the ones
+    /// there are.  Returns true if that changed the file.
+    bool SetTimeIndex(int t)
     {
+        if (timeFiles.empty())
+            return false;
+        t = std::max(0, std::min(t, (int)timeFiles.size()-1));
+        timeIndex = t;
+        if (file == timeFiles[t])
+            return false;
+        file = timeFiles[t];
+        return true;
     }
+    static std::vector<std::string> ExpandFilePattern(const std::string &pattern);
+    static std::string GetTimeSeriesPattern(const std::string &fn);
+    static void SortTimeSteps(std::vector<std::string> &files);
     string GetSourceType()
     {
         if (sourcetype == File && (file=="" || mesh==""))
@@ -52,22 +99,43 @@ struct Source
         else // sourcetype == Pipe
             return "Pipeline";
     }
-    string GetSourceInfo()
+    string GetSourceInfo();
+    /// The fields the source can provide.  A pipeline source provides
+    /// whatever its own source does, and is asked for them directly.
+    std::vector<std::string> GetFieldList();
+};
+
+// ****************************************************************************
+// Struct:  StageProfile
+//
+// Purpose:
+///   Timing and size information for generating one stage of a
+///   pipeline's results (reading the source, or an operation), either
+///   for a single chunk, or summed over all of them.
+///   Memory is an estimate of what the stage allocated.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+struct StageProfile
+{
+    /// wall clock start time, in seconds since the program started
+    double    start;
+    double    wallTime;
+    double    cpuTime;
+    long long inCells,  inPoints;
+    long long outCells, outPoints;
+    long long bytes;
+    /// number of chunks which came from the result cache
+    int       ncached;
+
+  public:
+    StageProfile()
+        : start(0), wallTime(0), cpuTime(0),
+          inCells(0), inPoints(0), outCells(0), outPoints(0),
+          bytes(0), ncached(0)
     {
-        if (sourcetype == File && (file=="" || mesh==""))
-            return "";
-        else if (sourcetype == File)
-        {
-            return QFileInfo(file.c_str()).fileName().toStdString() + ":" + mesh;
-        }
-        else if (sourcetype == Geometry)
-        {
-            return "(some shape?)";
-        }
-        else // sourcetype == Pipe
-        {
-            return "(some pipe ID)";
-        }
     }
 };
 
@@ -88,16 +156,141 @@ struct Pipeline
     std::vector<Operation*> ops;
     /// results should have one more item in it than the ops array.
     /// e.g. ops[i] uses results[i] as input and outputs to results[i+1].
-    /// result[0] is the initial data set.
-    std::vector<eavlDataSet*> results;
+    /// result[0] is the initial data set.  Each of those has one data
+    /// set per chunk (domain) of the source, i.e. results[i][chunk].
+    /// The pipeline holds a reference to each (see DataSetRefs); set
+    /// them with SetResult and drop them with ReleaseResults.
+    std::vector< std::vector<eavlDataSet*> > results;
+    /// copies of the operations for chunks past the first, since an
+    /// operation (and its filter) can only work on one chunk at a time
+    std::map<Operation*, std::vector<Operation*> > chunkOps;
+    /// fields that something downstream (e.g. a plot) has asked for,
+    /// beyond the ones the operations themselves need
+    std::set<std::string> requestedVariables;
+    /// fields from the source which were read into results[0]
+    std::set<std::string> loadedVariables;
+    /// how long each result took to generate, as profile[stage][chunk]
+    std::vector< std::vector<StageProfile> > profile;
+    /// changes whenever results.back() might have, so pipelines
+    /// reading from this one can tell if theirs are stale
+    int generation;
+    /// for a pipeline source, its generation when it was copied into
+    /// results[0]
+    int sourceGeneration;
+
+  protected:
+    /// true while a background thread is executing this pipeline
+    bool executing;
+    QAtomicInt cancelRequested;
+    /// number of chunks which have finished each stage so far
+    QMutex progressMutex;
+    std::vector<int> stageProgress;
+    int progressChunks;
 
   public:
     ///\todo: hack: everyone needs to access these
     static vector<Pipeline*> allPipelines;
+    /// max number of chunks to execute at once; 0 means one per core
+    static int maxChunkThreads;
+    /// how many time steps past the current one the GUI reads ahead;
+    /// see TimePrefetcher
+    static int prefetchSteps;
+    /// results shared by all pipelines
+    static ResultCache resultCache;
+    /// every file opened as a source
+    static ImporterPool importers;
+    /// how the GUI runs a pipeline on its background thread; NULL
+    /// (e.g. in batch mode) means StartExecution executes right here
+    static void (*backgroundExecutor)(Pipeline*);
 
   public:
-    Pipeline() : source(new Source)
+    Pipeline() : source(new Source), generation(0), sourceGeneration(0),
+                 executing(false), cancelRequested(0), progressChunks(0)
+    {
+    }
+    ~Pipeline()
+    {
+        for (size_t i=0; i<ops.size(); i++)
+            DeleteOperation(ops[i]);
+        delete source;
+        ReleaseResults(0);
+    }
+
+    /// For a time series source, move to another time step.  The
+    /// results for it may well be in the result cache already (see
+    /// TimePrefetcher).  Returns true if that cleared the results.
+    bool SetTimeIndex(int t)
+    {
+        if (source->sourcetype != Source::File || !source->SetTimeIndex(t))
+            return false;
+        ClearResults();
+        return true;
+    }
+
+    /// Set by the GUI thread around a background Execute().  While
+    /// it's set, nothing else may touch the operations or results.
+    /// Executing also brings the pipeline we read from (if any) up
+    /// to date, so it's set on that one too.
+    void SetExecuting(bool e)
+    {
+        executing = e;
+        if (e)
+            cancelRequested = 0;
+        if (GetSourcePipeline())
+            GetSourcePipeline()->SetExecuting(e);
+    }
+
+    /// True if this pipeline, or one it reads from, is executing.
+    bool IsExecuting()
+    {
+        return executing ||
+               (GetSourcePipeline() && GetSourcePipeline()->IsExecuting());
+    }
+
+    /// Ask a running Execute() to stop at the next chunk or operation.
+    /// Stages which every chunk finished are kept.
+    void RequestCancel()
+    {
+        cancelRequested = 1;
+        if (GetSourcePipeline())
+            GetSourcePipeline()->RequestCancel();
+    }
+
+    bool IsCancelRequested()
+    {
+        return cancelRequested != 0;
+    }
+
+    /// Get the number of chunks which have finished each stage of
+    /// the current (or last) execution.  Safe to call while executing.
+    std::vector<int> GetStageProgress(int &nchunks)
     {
+        QMutexLocker lock(&progressMutex);
+        nchunks = progressChunks;
+        return stageProgress;
+    }
+
+    /// The pipeline this one reads from, or NULL if it has another
+    /// kind of source.
+    Pipeline *GetSourcePipeline()
+    {
+        return (source->sourcetype == Source::Pipe) ? source->source_pipe : NULL;
+    }
+
+    /// True if this pipeline reads from p, directly or not.
+    bool DependsOn(Pipeline *p)
+    {
+        // the count guards against a cycle, which would otherwise
+        // have us looping forever
+        int n = 0;
+        for (Pipeline *up = GetSourcePipeline();
+             up && n <= (int)allPipelines.size();
+             up = up->GetSourcePipeline(), n++)
+        {
+            if (up == p)
+                return true;
+        }
+        return false;
     }
 
     string GetName()
@@ -112,9 +305,102 @@ struct Pipeline
         return result;
     }
 
+    bool HasResults()
+    {
+        return results.size() > 0;
+    }
+
+    /// The number of chunks in the latest result; there's only one
+    /// after an operation which combines them.
+    int GetNumChunks()
+    {
+        return results.size() > 0 ? results.back().size() : 0;
+    }
+
+    /// Get the latest result for a chunk.
+    eavlDataSet *GetResult(int chunk)
+    {
+        return results.back()[chunk];
+    }
+
+    /// Get info for a field in the first chunk, with the ranges
+    /// merged across all the chunks.  The ranges are cached, since
+    /// this gets called every time the GUI updates, and a field that's
+    /// still as it was read from a file has its range saved with the
+    /// file's metadata, so it's only ever scanned once.
+    FieldInfo GetFieldInfo(eavlField *f)
+    {
+        FieldInfo finfo;
+        finfo.name = f->GetArray()->GetName();
+        finfo.ncomp = f->GetArray()->GetNumberOfComponents();
+
+        bool fromFile = IsUnchangedFileField(f);
+        FieldRange r;
+        if (fromFile && importers.GetFieldRange(source->file, source->mesh,
+                                                finfo.name, r))
+        {
+            finfo.minval = r.minval;
+            finfo.maxval = r.maxval;
+            finfo.minmag = r.minmag;
+            finfo.maxmag = r.maxmag;
+            return finfo;
+        }
+
+        r = Operation::fieldRanges.GetRange(f->GetArray());
+        finfo.minval = r.minval;
+        finfo.maxval = r.maxval;
+        finfo.minmag = r.minmag;
+        finfo.maxmag = r.maxmag;
+        for (size_t c=1; c<results.back().size(); ++c)
+        {
+            eavlDataSet *ds = results.back()[c];
+            for (int j=0; j<ds->GetNumFields(); ++j)
+            {
+                eavlArray *a = ds->GetField(j)->GetArray();
+                if (a->GetName() != finfo.name)
+                    continue;
+                r = Operation::fieldRanges.GetRange(a);
+                finfo.minval = std::min(finfo.minval, r.minval);
+                finfo.maxval = std::max(finfo.maxval, r.maxval);
+                finfo.minmag = std::min(finfo.minmag, r.minmag);
+                finfo.maxmag = std::max(finfo.maxmag, r.maxmag);
+                break;
+            }
+        }
+
+        if (fromFile)
+        {
+            r.minval = finfo.minval;
+            r.maxval = finfo.maxval;
+            r.minmag = finfo.minmag;
+            r.maxmag = finfo.maxmag;
+            importers.SetFieldRange(source->file, source->mesh, finfo.name, r);
+        }
+        return finfo;
+    }
+
+    /// True if a field in the latest results is the same array we
+    /// read from our source file.  Operations share the arrays they
+    /// don't change, and treat every chunk alike, so checking the
+    /// first chunk is enough.
+    bool IsUnchangedFileField(eavlField *f)
+    {
+        if (source->sourcetype != Source::File || results.empty())
+            return false;
+        eavlDataSet *ds = results[0][0];
+        for (int j=0; j<ds->GetNumFields(); ++j)
+        {
+            if (ds->GetField(j)->GetArray() == f->GetArray())
+                return true;
+        }
+        return false;
+    }
+
     DSInfo GetVariables(int index)
     {
         DSInfo dsinfo;
+        if (executing)
+            return dsinfo;
         try
         {
             Execute();
@@ -128,23 +414,17 @@ struct Pipeline
         if (results.size() == 0)
             return dsinfo;
 
-        eavlDataSet *ds = results.back();
+        // chunks should all have the same structure; use the first
+        eavlDataSet *ds = GetResult(0);
         for (int j=0; j<ds->GetNumFields(); ++j)
         {
             eavlField *f = ds->GetField(j);
             if (f->GetAssociation() == eavlField::ASSOC_POINTS)
-            {
-                FieldInfo finfo;
-                finfo.name = f->GetArray()->GetName();
-                finfo.ncomp = f->GetArray()->GetNumberOfComponents();
-                finfo.minval = f->GetArray()->GetComponentWiseMin();
-                finfo.maxval = f->GetArray()->GetComponentWiseMax();
-                finfo.minmag = f->GetArray()->GetMagnitudeMin();
-                finfo.maxmag = f->GetArray()->GetMagnitudeMax();
-                dsinfo.nodalfields.push_back(finfo);
-            }
+                dsinfo.nodalfields.push_back(GetFieldInfo(f));
         }
 
+        // let the caller know what else it could ask for
+        dsinfo.unloadedfields = GetUnloadedSourceVariables();
 
         for (int i=0; i<ds->GetNumCellSets(); ++i)
         {
@@ -159,14 +439,7 @@ struct Pipeline
                 if (f->GetAssociation() == eavlField::ASSOC_CELL_SET &&
                     f->GetAssocCellSet() == i)
                 {
-                    FieldInfo finfo;
-                    finfo.name = f->GetArray()->GetName();
-                    finfo.ncomp = f->GetArray()->GetNumberOfComponents();
-                    finfo.minval = f->GetArray()->GetComponentWiseMin();
-                    finfo.maxval = f->GetArray()->GetComponentWiseMax();
-                    finfo.minmag = f->GetArray()->GetMagnitudeMin();
-                    finfo.maxmag = f->GetArray()->GetMagnitudeMax();
-                    dsinfo.cellsetfields[cs->GetName()].push_back(finfo);
+                    dsinfo.cellsetfields[cs->GetName()].push_back(GetFieldInfo(f));
                 }
             }
         }
@@ -175,72 +448,329 @@ struct Pipeline
         return dsinfo;
     }
 
-    void ClearResults()
+    /// Get the profile of a stage (0 being the source), combined
+    /// across all chunks.  The wall time is from the first chunk
+    /// starting to the last one finishing, and the rest are sums.
+    StageProfile GetStageProfile(int stage)
     {
-        results.clear();
+        StageProfile sum;
+        if (stage >= (int)results.size() || stage >= (int)profile.size())
+            return sum;
+
+        double end = 0;
+        for (size_t c=0; c<profile[stage].size(); c++)
+        {
+            const StageProfile &p = profile[stage][c];
+            if (c == 0 || p.start < sum.start)
+                sum.start = p.start;
+            end = std::max(end, p.start + p.wallTime);
+            sum.cpuTime   += p.cpuTime;
+            sum.inCells   += p.inCells;
+            sum.inPoints  += p.inPoints;
+            sum.outCells  += p.outCells;
+            sum.outPoints += p.outPoints;
+            sum.bytes     += p.bytes;
+            sum.ncached   += p.ncached;
+        }
+        sum.wallTime = end - sum.start;
+        return sum;
     }
 
-    void Execute()
+    /// Create a serializable description of the source and operations.
+    /// The caller owns the result.
+    PipelineAttributes *CreateAttributes();
+    /// Replace the source and operations with the ones described,
+    /// throwing away any results.
+    void SetFromAttributes(PipelineAttributes *atts);
+
+    /// Write the profiles of every pipeline as Chrome trace event
+    /// JSON, viewable in chrome://tracing.
+    static void WriteChromeTrace(ostream &out);
+
+    void ClearResults()
     {
-        //cerr << "\n\n>>>>EXECUTE\n\n\n";
+        ReleaseResults(0);
+        loadedVariables.clear();
+        generation++;
+    }
 
-        if (results.size() == 0)
+    /// Throw away only the results which depend on ops[opindex], i.e.
+    /// results[opindex+1] and later, so re-executing only has to
+    /// recompute the tail of the pipeline.
+    void InvalidateFrom(int opindex)
+    {
+        if (opindex < 0)
         {
-            if (source->sourcetype != Source::File)
-                throw eavlException("can only execute from source file");
+            ClearResults();
+            return;
+        }
+        if ((int)results.size() > opindex+1)
+        {
+            ReleaseResults(opindex+1);
+            generation++;
+        }
+    }
+
+    /// Delete ops[opindex] and its chunks' copies.  The results
+    /// upstream of it are still good, so they're kept.
+    void RemoveOperation(int opindex)
+    {
+        InvalidateFrom(opindex);
+        DeleteOperation(ops[opindex]);
+        ops.erase(ops.begin() + opindex);
+    }
 
-            if (!source->source_file)
-                throw eavlException("no source file selected");
+    /// Replace results[stage][chunk], holding on to the new one and
+    /// letting go of the old one.  Chunks may do this concurrently.
+    void SetResult(int stage, int chunk, eavlDataSet *ds)
+    {
+        Operation::dataSetRefs.Retain(ds);
+        if (results[stage][chunk])
+            Operation::dataSetRefs.Release(results[stage][chunk]);
+        results[stage][chunk] = ds;
+    }
 
-#if 0
-            // find the variables needed for each operation
-            std::vector<std::string> vars;
-            for (int i=ops.size()-1; i>=0; --i)
+    /// Keep only the first nstages stages of the results, letting go
+    /// of the rest; whatever nothing else holds is freed.
+    void ReleaseResults(int nstages)
+    {
+        for (size_t s=nstages; s<results.size(); s++)
+        {
+            for (size_t c=0; c<results[s].size(); c++)
             {
-                std::vector<std::string> newvars;
-                newvars = ops[i]->GetNeededVariables();
-                vars.insert(vars.end(), newvars.begin(), newvars.end());
+                if (results[s][c])
+                    Operation::dataSetRefs.Release(results[s][c]);
             }
-#else
-            ///\todo: big hack: always read everything from the file;
-            /// we eventually should change this so it only reads what's
-            /// asked of it
-            std::vector<std::string> vars = source->source_file->GetFieldList(source->mesh);
-#endif
+        }
+        if ((int)results.size() > nstages)
+            results.resize(nstages);
+    }
 
+    /// Walk backwards over the operations, starting with the fields
+    /// requested from downstream, to find the minimal set of fields
+    /// we need from the source.  A field created by some operation
+    /// isn't needed for anything downstream of it.
+    std::set<std::string> GetNeededVariables()
+    {
+        std::set<std::string> needed(requestedVariables);
+        for (int i=ops.size()-1; i>=0; --i)
+        {
+            std::vector<std::string> outvars = ops[i]->GetOutputVariables();
+            for (size_t j=0; j<outvars.size(); j++)
+                needed.erase(outvars[j]);
 
-            // read the mesh and vars
-            ///\todo: only reading chunk 0 for now
-            eavlDataSet *ds = source->source_file->GetMesh(source->mesh, 0);
+            std::vector<std::string> newvars = ops[i]->GetNeededVariables();
+            needed.insert(newvars.begin(), newvars.end());
+        }
+        return needed;
+    }
 
-            ds = ds->CreateShallowCopy();
-            for (size_t i=0; i<vars.size(); i++)
-            {
-                eavlField *f = source->source_file->GetField(vars[i], source->mesh, 0);
-                ds->AddField(f);
-            }
-            results.push_back(ds);
+    /// The needed variables (see GetNeededVariables) which the source
+    /// can provide, i.e. the ones to read from it.
+    std::vector<std::string> GetNeededSourceVariables()
+    {
+        std::set<std::string> needed = GetNeededVariables();
+
+        // only ask for the ones the source actually has; this also
+        // drops placeholders like "(default)"
+        std::vector<std::string> vars;
+        std::vector<std::string> sourcevars = source->GetFieldList();
+        for (size_t i=0; i<sourcevars.size(); i++)
+        {
+            if (needed.count(sourcevars[i]))
+                vars.push_back(sourcevars[i]);
+        }
+        return vars;
+    }
+
+    /// The fields the source could provide but hasn't been asked for.
+    /// For a pipeline source, it's the ones its own source hasn't.
+    std::vector<std::string> GetUnloadedSourceVariables()
+    {
+        if (GetSourcePipeline())
+            return GetSourcePipeline()->GetUnloadedSourceVariables();
+
+        std::vector<std::string> vars;
+        std::vector<std::string> sourcevars = source->GetFieldList();
+        for (size_t j=0; j<sourcevars.size(); ++j)
+        {
+            if (!loadedVariables.count(sourcevars[j]))
+                vars.push_back(sourcevars[j]);
         }
+        return vars;
+    }
+
+    /// Ask for a field to be available in the results (e.g. because a
+    /// plot wants to color by it).  If it comes from the source and we
+    /// haven't read it yet, read it into results[0] now and throw away
+    /// everything downstream so the next Execute picks it up.
+    /// Returns true if the existing results were invalidated.
+    bool RequestVariable(const std::string &name)
+    {
+        if (name == "" || requestedVariables.count(name))
+            return false;
+        requestedVariables.insert(name);
+
+        // a pipeline source reads it for us; if that changes its
+        // results, the next Execute will see ours are stale
+        if (GetSourcePipeline())
+            return GetSourcePipeline()->RequestVariable(name);
+
+        // nothing read yet; the next Execute will pick it up
+        if (results.size() == 0)
+            return false;
 
-        while (results.size() <= ops.size())
+        if (loadedVariables.count(name))
+            return false;
+
+        std::vector<std::string> sourcevars = source->GetFieldList();
+        if (std::find(sourcevars.begin(), sourcevars.end(), name) == sourcevars.end())
+            return false; // must be created by an operation
+
+        loadedVariables.insert(name);
+        std::string key = GetSourceCacheKey(loadedVariables);
+        ImporterHandle importer(importers, (source->sourcetype == Source::File)
+                                           ? source->file : "");
+        for (size_t c=0; c<results[0].size(); c++)
         {
-            eavlDataSet *ds = results.back();
+            // the old data set may be cached (or in use by another
+            // pipeline) without this field, so add it to a copy
+            eavlField *f;
+            if (source->sourcetype == Source::Geometry)
+                f = GeometrySource(source->geometry, c).CreateField(name);
+            else
+                f = importer.GetField(name, source->mesh, c);
+            eavlDataSet *ds = results[0][c]->CreateShallowCopy();
+            ds->AddField(f);
+            SetResult(0, c, ds);
+            resultCache.Insert(GetChunkCacheKey(key, c), ds);
+        }
+        ReleaseResults(1);
+        generation++;
+        return true;
+    }
 
-            // \todo: hack: create a new data set structure so our mutators
-            // don't quite so easily mess with the one in the importer.
-            ds = ds->CreateShallowCopy();
+    /// The cache key for the data read from the source with the
+    /// given fields, without the chunk.
+    std::string GetSourceCacheKey(const std::set<std::string> &vars)
+    {
+        // a pipeline source's results are keyed by how it made them
+        if (GetSourcePipeline())
+        {
+            std::vector<std::string> &keys = GetSourcePipeline()->stageKeys;
+            return keys.empty() ? "" : keys.back();
+        }
 
-            // execute each operation
-            Operation *op = ops[results.size()-1];
-            op->SetInput(ds);
-            op->Execute();
-            results.push_back(op->GetOutput());
+        // include the modification time so we don't use stale
+        // results for a file that was rewritten
+        std::ostringstream key;
+        if (source->sourcetype == Source::Geometry)
+            key << "geometry:" << std::hex << source->geometry->ComputeHash()
+                << std::dec << "(";
+        else
+            key << source->file << "@"
+                << QFileInfo(source->file.c_str()).lastModified().toTime_t()
+                << ":" << source->mesh << "(";
+        for (std::set<std::string>::const_iterator it = vars.begin();
+             it != vars.end(); ++it)
+        {
+            key << (it == vars.begin() ? "" : ",") << *it;
+        }
+        key << ")";
+        return key.str();
+    }
 
-            //cerr << "Executed op to generate result["<<results.size()<<", summary = \n";
-            //op->GetOutput()->PrintSummary(cerr);
+    static std::string GetChunkCacheKey(const std::string &key, int chunk)
+    {
+        std::ostringstream out;
+        out << key << "#" << chunk;
+        return out.str();
+    }
+
+    void Execute();
+
+    /// Bring the results up to date, in the background if there's a
+    /// backgroundExecutor.  If IsExecuting() is true afterwards, wait
+    /// for the pipeline to be updated before using them.
+    void StartExecution()
+    {
+        if (backgroundExecutor)
+            backgroundExecutor(this);
+        else
+            Execute();
+    }
+
+  protected:
+    /// cache keys (without the chunk) for each stage being executed
+    std::vector<std::string> stageKeys;
+
+    friend class ChunkTask;
+    /// Delete an operation and its chunks' copies of it.
+    void DeleteOperation(Operation *op)
+    {
+        std::map<Operation*, std::vector<Operation*> >::iterator it =
+            chunkOps.find(op);
+        if (it != chunkOps.end())
+        {
+            for (size_t j=0; j<it->second.size(); j++)
+                delete it->second[j];
+            chunkOps.erase(it);
         }
+        delete op;
+    }
+    void ExecuteSourcePipeline();
+    void PrepareCacheKeys(const std::set<std::string> &sourcevars);
+    void PrepareChunkOperations(int firstStage,
+                                const std::vector<int> &stageChunks);
+    void PrepareMergedRange(int stage);
+    void ExecuteStages(int firstStage, int endStage, int nchunks,
+                       const std::vector<std::string> &vars,
+                       ImporterHandle *importer);
+    void ExecuteChunk(int chunk, int firstStage, int endStage,
+                      const std::vector<std::string> &vars,
+                      ImporterHandle *importer);
+    void StageFinished(int stage)
+    {
+        // a stage with one chunk for all of them counts for all of them
+        QMutexLocker lock(&progressMutex);
+        stageProgress[stage] += progressChunks / results[stage].size();
     }
 };
 
+inline string
+Source::GetSourceInfo()
+{
+    if (sourcetype == File && (file=="" || mesh==""))
+        return "";
+    else if (sourcetype == File)
+    {
+        std::ostringstream out;
+        out << QFileInfo(file.c_str()).fileName().toStdString() << ":" << mesh;
+        if (!timeFiles.empty())
+            out << " (" << timeIndex+1 << " of " << timeFiles.size() << ")";
+        return out.str();
+    }
+    else if (sourcetype == Geometry)
+    {
+        std::ostringstream out;
+        out << geometry->meshType << " " << geometry->cells[0] << "x"
+            << geometry->cells[1] << "x" << geometry->cells[2];
+        return out.str();
+    }
+    else // sourcetype == Pipe
+    {
+        return source_pipe ? source_pipe->GetName() : "";
+    }
+}
+
+inline std::vector<std::string>
+Source::GetFieldList()
+{
+    if (sourcetype == File)
+        return Pipeline::importers.GetFieldList(file, mesh);
+    else if (sourcetype == Geometry)
+        return GeometrySource::GetFieldList();
+    return std::vector<std::string>();
+}
 
 #endif
@@ -0,0 +1,108 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef PIPELINE_ATTRIBUTES_H
+#define PIPELINE_ATTRIBUTES_H
+
+#include "Attribute.h"
+#include "GeometrySource.h"
+#include "Operation.h"
+
+// ****************************************************************************
+// Class:  OperationAttributes
+//
+// Purpose:
+///   A serializable description of one operation in a pipeline: its
+///   name (as in Operation::GetOperationName) and a copy of its
+///   settings, which may be NULL for operations without settings.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class OperationAttributes : public Attribute
+{
+  public:
+    string     name;
+    Attribute *settings;
+  public:
+    virtual const char *GetType() {return "OperationAttributes";}
+    static Attribute *Create() { return new OperationAttributes; }
+    OperationAttributes() : Attribute()
+    {
+        name = "";
+        settings = NULL;
+        // so the settings can be unserialized
+        Operation::RegisterSettingsTypes();
+    }
+    virtual ~OperationAttributes()
+    {
+        delete settings;
+    }
+    virtual void AddFields()
+    {
+        Add("name", name);
+        Add("settings", settings);
+    }
+};
+
+// ****************************************************************************
+// Class:  PipelineAttributes
+//
+// Purpose:
+///   A serializable description of a pipeline: the file and mesh it
+///   reads (or, if geometry isn't NULL, the data set it generates, or
+///   if sourcePipeline isn't -1, the index of the pipeline it reads
+///   from in a session), and its chain of operations.  This is the
+///   format used by batch mode (see Batch.h).
+///
+///   For a time series, timeFiles lists its files and file is the one
+///   at timeIndex.  Instead of a list, a hand-written description can
+///   give a timePattern such as "run_*.silo" (see
+///   Source::ExpandFilePattern).
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class PipelineAttributes : public Attribute
+{
+  public:
+    string file;
+    string mesh;
+    GeometryAttributes *geometry;
+    int    sourcePipeline;
+    vector<string> timeFiles;
+    string timePattern;
+    int    timeIndex;
+    vector<OperationAttributes*> ops;
+  public:
+    virtual const char *GetType() {return "PipelineAttributes";}
+    static Attribute *Create() { return new PipelineAttributes; }
+    PipelineAttributes() : Attribute()
+    {
+        file = "";
+        mesh = "";
+        geometry = NULL;
+        sourcePipeline = -1;
+        timePattern = "";
+        timeIndex = 0;
+    }
+    virtual ~PipelineAttributes()
+    {
+        delete geometry;
+        for (size_t i=0; i<ops.size(); i++)
+            delete ops[i];
+    }
+    virtual void AddFields()
+    {
+        Add("file", file);
+        Add("mesh", mesh);
+        Add("geometry", geometry);
+        Add("sourcePipeline", sourcePipeline);
+        Add("timeFiles", timeFiles);
+        Add("timePattern", timePattern);
+        Add("timeIndex", timeIndex);
+        Add("ops", ops);
+    }
+};
+
+#endif
@@ -0,0 +1,54 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef PIPELINE_EXECUTOR_H
+#define PIPELINE_EXECUTOR_H
+
+#include <QThread>
+#include "Pipeline.h"
+
+// ****************************************************************************
+// Class:  PipelineExecutor
+//
+// Purpose:
+///   Runs Pipeline::Execute on its own thread so the GUI stays
+///   responsive.  Connect to finished() (queued) to find out when it's
+///   done, then check the error text.  The pipeline must be marked as
+///   executing for the duration so nothing else touches it.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class PipelineExecutor : public QThread
+{
+  public:
+    Pipeline    *pipe;
+    std::string  error;
+
+  public:
+    PipelineExecutor(Pipeline *p, QObject *parent)
+        : QThread(parent), pipe(p)
+    {
+    }
+  protected:
+    virtual void run()
+    {
+        try
+        {
+            pipe->Execute();
+        }
+        catch (const eavlException &e)
+        {
+            error = e.GetErrorText();
+        }
+        catch (const Exception &e)
+        {
+            error = e.message;
+        }
+        catch (...)
+        {
+            error = "unknown error executing pipeline";
+        }
+    }
+};
+
+#endif
@@ -15,8 +15,20 @@ struct Plot
     string field;
     eavlColor color;
     bool wireframe;
-    eavlRenderer *renderer;
+    /// one renderer per chunk of the pipeline's results
+    vector<eavlRenderer*> renderers;
+    /// for the coarsest level of detail, if there is one; drawn by the
+    /// 3D window while the camera moves
+    vector<eavlRenderer*> coarseRenderers;
+    /// the results the renderers draw; we hold on to them, since the
+    /// pipeline may let go of them (e.g. to re-execute) while they're
+    /// still on the screen
+    vector<eavlDataSet*> datasets;
     bool valid;
+    /// the field's range across all the chunks, so every chunk's
+    /// renderer maps the same value to the same color
+    bool hasRange;
+    double minval, maxval;
 
     // these two are hacks; need a better way to get this info
     // to create the right renderers for plots....
@@ -29,74 +41,167 @@ struct Plot
              field(""),
              color(eavlColor::grey50),
              wireframe(false),
-             renderer(NULL),
-             valid(true)
+             valid(true),
+             hasRange(false),
+             minval(0),
+             maxval(0)
     {
         oneDimensional = false;
         barsFor1D = false;
     }
-    void UpdateDataSet(eavlDataSet *ds)
+    void DeleteRenderers()
     {
-        delete renderer;
-        renderer = NULL;
+        for (size_t i=0; i<renderers.size(); i++)
+            delete renderers[i];
+        renderers.clear();
+        DeleteCoarseRenderers();
+        for (size_t i=0; i<datasets.size(); i++)
+            Operation::dataSetRefs.Release(datasets[i]);
+        datasets.clear();
+    }
+    void UpdateDataSet()
+    {
+        DeleteRenderers();
     }
     void CreateRenderer(void (*xform)(double,double,double,double&,double&,double&) = NULL)
     {
-        if (renderer)
+        if (!renderers.empty())
             return;
 
         try
         {
-            if (oneDimensional)
+            // read our field lazily if the pipeline didn't have it yet;
+            // if that happens in the background, we'll be asked again
+            // once the pipeline is updated
+            if (field != "" && pipe->RequestVariable(field))
             {
-                if (barsFor1D)
-                {
-                    if (field != "")
-                        renderer = new eavlBarRenderer(pipe->results.back(),
-                                                       xform,
-                                                       color,
-                                                       0.10,
-                                                       cellset,
-                                                       field);
-                }
-                else
-                {
-                    if (field != "")
-                        renderer = new eavlCurveRenderer(pipe->results.back(),
-                                                         xform,
-                                                         color,
-                                                         cellset,
-                                                         field);
-                }
+                pipe->StartExecution();
+                if (pipe->IsExecuting())
+                    return;
             }
-            else
+
+            GetFieldRange();
+            for (int c=0; c<pipe->GetNumChunks(); c++)
             {
-                if (field != "")
+                datasets.push_back(pipe->GetResult(c));
+                Operation::dataSetRefs.Retain(datasets.back());
+                eavlRenderer *renderer = NewRenderer(pipe->GetResult(c),
+                                                     cellset, field, xform);
+                if (renderer)
+                    renderers.push_back(renderer);
+            }
+            valid = true;
+        }
+        catch (...)
+        {
+            DeleteRenderers();
+            valid = false;
+        }
+    }
+    /// Create renderers for the coarsest level of detail made by the
+    /// decimate operation, if the plotted cell set is a finer one.
+    /// Every chunk gets one or none does, so a moving camera never
+    /// shows part of the plot.  Call CreateRenderer first.
+    void CreateCoarseRenderer(void (*xform)(double,double,double,double&,double&,double&) = NULL)
+    {
+        if (!coarseRenderers.empty() || renderers.empty() || oneDimensional)
+            return;
+
+        try
+        {
+            for (int c=0; c<pipe->GetNumChunks(); c++)
+            {
+                eavlDataSet *ds = pipe->GetResult(c);
+                string coarsest = GetCoarsestLOD(ds);
+                eavlRenderer *renderer = NULL;
+                if (coarsest != "")
                 {
-                    renderer = new eavlPseudocolorRenderer(pipe->results.back(), 
-                                                           xform,
-                                                           colortable,
-                                                           wireframe,
-                                                           cellset,
-                                                           field);
-                    return;
+                    // a cell field's copy on a coarser level is named
+                    // for its cell set
+                    string f = field;
+                    if (f != "" && ds->GetFieldIndex(f + "_" + coarsest) >= 0)
+                        f += "_" + coarsest;
+                    renderer = NewRenderer(ds, coarsest, f, xform);
                 }
-                else
+                if (!renderer)
                 {
-                    renderer = new eavlSingleColorRenderer(pipe->results.back(), 
-                                                           xform,
-                                                           color,
-                                                           wireframe,
-                                                           cellset);
+                    DeleteCoarseRenderers();
+                    return;
                 }
+                coarseRenderers.push_back(renderer);
             }
-            valid = true;
         }
         catch (...)
         {
-            renderer = NULL;
-            valid = false;
+            DeleteCoarseRenderers();
+        }
+    }
+
+  protected:
+    void DeleteCoarseRenderers()
+    {
+        for (size_t i=0; i<coarseRenderers.size(); i++)
+            delete coarseRenderers[i];
+        coarseRenderers.clear();
+    }
+    /// Look up our field's range, merged across the chunks.
+    void GetFieldRange()
+    {
+        hasRange = false;
+        if (field == "" || pipe->GetNumChunks() == 0)
+            return;
+        eavlDataSet *ds = pipe->GetResult(0);
+        for (int j=0; j<ds->GetNumFields(); ++j)
+        {
+            eavlField *f = ds->GetField(j);
+            if (f->GetArray()->GetName() != field)
+                continue;
+            FieldInfo finfo = pipe->GetFieldInfo(f);
+            hasRange = true;
+            minval = finfo.minval;
+            maxval = finfo.maxval;
+            return;
+        }
+    }
+    /// The last "lod" cell set in the data set (the decimate operation
+    /// makes them finest first), or "" if it's what we're plotting or
+    /// we aren't plotting a level of detail at all.
+    string GetCoarsestLOD(eavlDataSet *ds)
+    {
+        string current = (cellset != "") ? cellset
+                                         : ds->GetCellSet(0)->GetName();
+        if (current.compare(0, 3, "lod") != 0)
+            return "";
+        string coarsest = current;
+        for (int i=0; i<ds->GetNumCellSets(); i++)
+        {
+            string name = ds->GetCellSet(i)->GetName();
+            if (name.compare(0, 3, "lod") == 0)
+                coarsest = name;
+        }
+        return (coarsest == current) ? "" : coarsest;
+    }
+    eavlRenderer *NewRenderer(eavlDataSet *ds, const string &cs, const string &f,
+                              void (*xform)(double,double,double,double&,double&,double&))
+    {
+        if (oneDimensional)
+        {
+            if (f == "")
+                return NULL;
+            if (barsFor1D)
+                return new eavlBarRenderer(ds, xform, color, 0.10, cs, f);
+            return new eavlCurveRenderer(ds, xform, color, cs, f);
+        }
+        if (f != "")
+        {
+            eavlPseudocolorRenderer *r =
+                new eavlPseudocolorRenderer(ds, xform, colortable,
+                                            wireframe, cs, f);
+            if (hasRange)
+                r->SetDataExtents(minval, maxval);
+            return r;
         }
+        return new eavlSingleColorRenderer(ds, xform, color, wireframe, cs);
     }
 };
 
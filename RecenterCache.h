@@ -0,0 +1,173 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef RECENTER_CACHE_H
+#define RECENTER_CACHE_H
+
+#include "STL.h"
+#include <list>
+#include <QMutex>
+#include <QMutexLocker>
+#include "eavlDataSet.h"
+#include "eavlCellToNodeRecenterMutator.h"
+#include "FilterLock.h"
+#include "DataSetRefs.h"
+
+// ****************************************************************************
+// Class:  RecenterCache
+//
+// Purpose:
+///   Node-centered versions of cell-centered fields, for operations
+///   that need nodal values (like isosurface).  They're keyed by the
+///   cell field's array and cell set, which stay the same from one
+///   execution of a pipeline to the next, so e.g. changing an
+///   isovalue doesn't recenter the field again.  Only the most
+///   recent few are kept.  The cache holds a reference to each
+///   field it keeps, so evicting one frees it if nothing else holds
+///   it.
+///
+///   All methods are safe to call from the chunk threads.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Run the recentering mutator under a FilterLock.
+//
+//   Added Forget, since the keys are raw pointers.
+//
+//   Hold references to the cached fields.
+//
+// ****************************************************************************
+class RecenterCache
+{
+  protected:
+    typedef std::pair<eavlArray*, eavlCellSet*> Key;
+    std::map<Key, eavlField*> entries;
+    /// most recently added at the front
+    std::list<Key>            order;
+    size_t                    maxEntries;
+    /// holds on to the cached fields
+    DataSetRefs              *refs;
+    QMutex                    mutex;
+
+  public:
+    RecenterCache(DataSetRefs *r, size_t maxentries = 32)
+        : maxEntries(maxentries), refs(r)
+    {
+    }
+
+    /// Get the named field of ds as a nodal field.  If it's cell
+    /// centered, the recentered version is added to ds (if it isn't
+    /// already there) and returned; use its name from then on.
+    /// If ds is retained, it holds on to the field from then on.
+    eavlField *GetNodalField(eavlDataSet *ds, const std::string &name)
+    {
+        eavlField *f = ds->GetField(name);
+        if (f->GetAssociation() != eavlField::ASSOC_CELL_SET)
+            return f;
+
+        eavlCellSet *cs = ds->GetCellSet(f->GetAssocCellSet());
+        Key key(f->GetArray(), cs);
+        {
+            QMutexLocker lock(&mutex);
+            std::map<Key, eavlField*>::iterator it = entries.find(key);
+            if (it != entries.end())
+                return AddField(ds, it->second);
+        }
+
+        // the mutator adds the new field to the data set it's given,
+        // so give it a scratch one; don't hold the lock while it runs
+        // so other chunks can use the cache
+        eavlDataSet *tmp = ds->CreateShallowCopy();
+        eavlCellToNodeRecenterMutator recenter;
+        recenter.SetDataSet(tmp);
+        recenter.SetField(name);
+        recenter.SetCellSet(cs->GetName());
+        {
+            FilterLock lock;
+            recenter.Execute();
+        }
+        eavlField *nodal = tmp->GetField(tmp->GetNumFields()-1);
+        // it shares everything, so only the copy itself goes
+        delete tmp;
+
+        std::vector<eavlField*> evicted;
+        {
+            QMutexLocker lock(&mutex);
+            if (!entries.count(key))
+            {
+                entries[key] = nodal;
+                refs->Retain(nodal);
+                order.push_front(key);
+                while (order.size() > maxEntries)
+                {
+                    evicted.push_back(entries[order.back()]);
+                    entries.erase(order.back());
+                    order.pop_back();
+                }
+            }
+            AddField(ds, nodal);
+        }
+        Release(evicted);
+        return nodal;
+    }
+
+    /// Drop the entries for a cell field's array, or made from it,
+    /// e.g. because a filter handed it back with new contents.
+    void Forget(eavlArray *a)
+    {
+        std::vector<eavlField*> forgotten;
+        {
+            QMutexLocker lock(&mutex);
+            std::list<Key>::iterator it = order.begin();
+            while (it != order.end())
+            {
+                if (it->first != a && entries[*it]->GetArray() != a)
+                {
+                    ++it;
+                    continue;
+                }
+                forgotten.push_back(entries[*it]);
+                entries.erase(*it);
+                it = order.erase(it);
+            }
+        }
+        Release(forgotten);
+    }
+
+    void Clear()
+    {
+        std::vector<eavlField*> all;
+        {
+            QMutexLocker lock(&mutex);
+            for (std::map<Key, eavlField*>::iterator it = entries.begin();
+                 it != entries.end(); ++it)
+                all.push_back(it->second);
+            entries.clear();
+            order.clear();
+        }
+        Release(all);
+    }
+
+  protected:
+    /// Add a nodal field to ds, which holds on to it if it's retained.
+    /// The mutex must be locked, so the field can't be released
+    /// before then.
+    eavlField *AddField(eavlDataSet *ds, eavlField *nodal)
+    {
+        if (ds->GetFieldIndex(nodal->GetArray()->GetName()) < 0)
+        {
+            ds->AddField(nodal);
+            refs->Update(ds);
+        }
+        return nodal;
+    }
+
+    /// Let go of fields dropped from the cache.  The mutex must not be
+    /// locked, since this can delete arrays, which calls Forget.
+    void Release(const std::vector<eavlField*> &dropped)
+    {
+        for (size_t i=0; i<dropped.size(); i++)
+            refs->Release(dropped[i]);
+    }
+};
+
+#endif
@@ -0,0 +1,147 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "STL.h"
+#include <list>
+#include <QMutex>
+#include <QMutexLocker>
+#include "eavlDataSet.h"
+#include "DataSetRefs.h"
+
+// ****************************************************************************
+// Class:  ResultCache
+//
+// Purpose:
+///   A least-recently-used cache of pipeline results, keyed by a string
+///   describing everything that went into them (source file, mesh,
+///   chunk, fields read, and the name and settings hash of every
+///   operation applied).  Identical keys mean identical results, so
+///   e.g. flipping an isovalue back to an earlier value, or two
+///   pipelines sharing the same leading operations, reuse results
+///   rather than recomputing them.
+///
+///   The cache holds a reference to each data set in it, so evicting
+///   one deletes it, and whatever arrays and such it doesn't share,
+///   unless a pipeline or plot still holds it.  The size of a data
+///   set is an estimate, and arrays shared between entries get
+///   counted more than once, so the budget is on the high side.
+///
+///   All methods are safe to call from the chunk threads.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   Hold references to the cached data sets, so eviction frees them.
+//
+// ****************************************************************************
+class ResultCache
+{
+  protected:
+    struct Entry
+    {
+        eavlDataSet *ds;
+        long long    bytes;
+        std::list<std::string>::iterator lru;
+    };
+    std::map<std::string, Entry> entries;
+    /// most recently used at the front
+    std::list<std::string>       lru;
+    long long                    maxBytes;
+    long long                    bytes;
+    long long                    nhits;
+    long long                    nmisses;
+    DataSetRefs                 *refs;
+    QMutex                       mutex;
+
+  public:
+    ResultCache(DataSetRefs *r, long long maxbytes = 1024LL*1024LL*1024LL)
+        : maxBytes(maxbytes), bytes(0), nhits(0), nmisses(0), refs(r)
+    {
+    }
+
+    /// Returns NULL (and counts a miss) if the key isn't cached.
+    eavlDataSet *Find(const std::string &key)
+    {
+        QMutexLocker lock(&mutex);
+        std::map<std::string, Entry>::iterator it = entries.find(key);
+        if (it == entries.end())
+        {
+            nmisses++;
+            return NULL;
+        }
+        nhits++;
+        lru.splice(lru.begin(), lru, it->second.lru);
+        return it->second.ds;
+    }
+
+    void Insert(const std::string &key, eavlDataSet *ds)
+    {
+        QMutexLocker lock(&mutex);
+        refs->Retain(ds);
+        RemoveEntry(key);
+        Entry e;
+        e.ds = ds;
+        e.bytes = ds->GetMemoryUsage();
+        lru.push_front(key);
+        e.lru = lru.begin();
+        entries[key] = e;
+        bytes += e.bytes;
+        Shrink();
+    }
+
+    void Remove(const std::string &key)
+    {
+        QMutexLocker lock(&mutex);
+        RemoveEntry(key);
+    }
+
+    void Clear()
+    {
+        QMutexLocker lock(&mutex);
+        for (std::map<std::string, Entry>::iterator it = entries.begin();
+             it != entries.end(); ++it)
+            refs->Release(it->second.ds);
+        entries.clear();
+        lru.clear();
+        bytes = 0;
+    }
+
+    void SetMaxBytes(long long n)
+    {
+        QMutexLocker lock(&mutex);
+        maxBytes = n;
+        Shrink();
+    }
+
+    long long GetMaxBytes()   { QMutexLocker lock(&mutex); return maxBytes; }
+    long long GetBytes()      { QMutexLocker lock(&mutex); return bytes; }
+    int       GetNumEntries() { QMutexLocker lock(&mutex); return entries.size(); }
+    long long GetNumHits()    { QMutexLocker lock(&mutex); return nhits; }
+    long long GetNumMisses()  { QMutexLocker lock(&mutex); return nmisses; }
+
+  protected:
+    // these assume the mutex is already locked
+    void RemoveEntry(const std::string &key)
+    {
+        std::map<std::string, Entry>::iterator it = entries.find(key);
+        if (it == entries.end())
+            return;
+        bytes -= it->second.bytes;
+        lru.erase(it->second.lru);
+        refs->Release(it->second.ds);
+        entries.erase(it);
+    }
+
+    void Shrink()
+    {
+        // always keep the newest entry, even if it's over budget
+        while (bytes > maxBytes && entries.size() > 1)
+        {
+            std::string oldest = lru.back();
+            RemoveEntry(oldest);
+        }
+    }
+};
+
+#endif
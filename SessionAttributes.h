@@ -0,0 +1,279 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef SESSION_ATTRIBUTES_H
+#define SESSION_ATTRIBUTES_H
+
+#include "Attribute.h"
+#include "Pipeline.h"
+#include "PipelineAttributes.h"
+#include "Plot.h"
+
+// ****************************************************************************
+// Class:  PlotAttributes
+//
+// Purpose:
+///   A serializable description of one plot in a window.  The pipeline
+///   is stored as its index in Pipeline::allPipelines (-1 for none).
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class PlotAttributes : public Attribute
+{
+  public:
+    int    pipeline;
+    string colortable;
+    string cellset;
+    string field;
+    float  color[4];
+    bool   wireframe;
+    bool   barsFor1D;
+  public:
+    virtual const char *GetType() {return "PlotAttributes";}
+    static Attribute *Create() { return new PlotAttributes; }
+    PlotAttributes() : Attribute()
+    {
+        pipeline = -1;
+        colortable = "default";
+        cellset = "";
+        field = "";
+        color[0] = color[1] = color[2] = .5;
+        color[3] = 1.;
+        wireframe = false;
+        barsFor1D = false;
+    }
+    virtual void AddFields()
+    {
+        Add("pipeline", pipeline);
+        Add("colortable", colortable);
+        Add("cellset", cellset);
+        Add("field", field);
+        Add("color", color, 4);
+        Add("wireframe", wireframe);
+        Add("barsFor1D", barsFor1D);
+    }
+    void SetFromPlot(const Plot &p)
+    {
+        pipeline = -1;
+        for (size_t i=0; i<Pipeline::allPipelines.size(); i++)
+        {
+            if (Pipeline::allPipelines[i] == p.pipe)
+                pipeline = i;
+        }
+        colortable = p.colortable;
+        cellset = p.cellset;
+        field = p.field;
+        for (int i=0; i<4; i++)
+            color[i] = p.color.c[i];
+        wireframe = p.wireframe;
+        barsFor1D = p.barsFor1D;
+    }
+    void ApplyToPlot(Plot &p)
+    {
+        p.pipe = NULL;
+        if (pipeline >= 0 && pipeline < (int)Pipeline::allPipelines.size())
+            p.pipe = Pipeline::allPipelines[pipeline];
+        p.colortable = colortable;
+        p.cellset = cellset;
+        p.field = field;
+        p.color = eavlColor(color[0], color[1], color[2], color[3]);
+        p.wireframe = wireframe;
+        p.barsFor1D = barsFor1D;
+        p.DeleteRenderers();
+    }
+};
+
+// ****************************************************************************
+// Class:  ViewAttributes
+//
+// Purpose:
+///   The camera of a window: the 3D view parameters for 3D windows,
+///   and the 2D extents for the others.  Both are saved for every
+///   window since it's simpler than knowing which one it uses.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class ViewAttributes : public Attribute
+{
+  public:
+    float from[3];
+    float at[3];
+    float up[3];
+    float nearplane;
+    float farplane;
+    bool  perspective;
+    float fov;
+    float zoom;
+    float xpan;
+    float ypan;
+    float l, r, t, b;
+  public:
+    virtual const char *GetType() {return "ViewAttributes";}
+    static Attribute *Create() { return new ViewAttributes; }
+    ViewAttributes() : Attribute()
+    {
+        from[0] = from[1] = 0.;  from[2] = 1.;
+        at[0] = at[1] = at[2] = 0.;
+        up[0] = up[2] = 0.;      up[1] = 1.;
+        nearplane = .1;
+        farplane = 100.;
+        perspective = true;
+        fov = .5;
+        zoom = 1.;
+        xpan = ypan = 0.;
+        l = b = -1.;
+        r = t = 1.;
+    }
+    virtual void AddFields()
+    {
+        Add("from", from, 3);
+        Add("at", at, 3);
+        Add("up", up, 3);
+        Add("nearplane", nearplane);
+        Add("farplane", farplane);
+        Add("perspective", perspective);
+        Add("fov", fov);
+        Add("zoom", zoom);
+        Add("xpan", xpan);
+        Add("ypan", ypan);
+        Add("l", l);
+        Add("r", r);
+        Add("t", t);
+        Add("b", b);
+    }
+    void SetFromView(const eavlView &v)
+    {
+        from[0] = v.view3d.from.x;
+        from[1] = v.view3d.from.y;
+        from[2] = v.view3d.from.z;
+        at[0] = v.view3d.at.x;
+        at[1] = v.view3d.at.y;
+        at[2] = v.view3d.at.z;
+        up[0] = v.view3d.up.x;
+        up[1] = v.view3d.up.y;
+        up[2] = v.view3d.up.z;
+        nearplane = v.view3d.nearplane;
+        farplane = v.view3d.farplane;
+        perspective = v.view3d.perspective;
+        fov = v.view3d.fov;
+        zoom = v.view3d.zoom;
+        xpan = v.view3d.xpan;
+        ypan = v.view3d.ypan;
+        l = v.view2d.l;
+        r = v.view2d.r;
+        t = v.view2d.t;
+        b = v.view2d.b;
+    }
+    /// only the camera is changed, not e.g. the window size or extents
+    void ApplyToView(eavlView &v)
+    {
+        v.view3d.from.x = from[0];
+        v.view3d.from.y = from[1];
+        v.view3d.from.z = from[2];
+        v.view3d.at.x = at[0];
+        v.view3d.at.y = at[1];
+        v.view3d.at.z = at[2];
+        v.view3d.up.x = up[0];
+        v.view3d.up.y = up[1];
+        v.view3d.up.z = up[2];
+        v.view3d.nearplane = nearplane;
+        v.view3d.farplane = farplane;
+        v.view3d.perspective = perspective;
+        v.view3d.fov = fov;
+        v.view3d.zoom = zoom;
+        v.view3d.xpan = xpan;
+        v.view3d.ypan = ypan;
+        v.view2d.l = l;
+        v.view2d.r = r;
+        v.view2d.t = t;
+        v.view2d.b = b;
+    }
+};
+
+// ****************************************************************************
+// Class:  WindowAttributes
+//
+// Purpose:
+///   A serializable description of one window: its type (as in the
+///   window frame's type chooser, e.g. "3D View"), its plots and
+///   camera, and for text summaries, the pipeline being shown.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class WindowAttributes : public Attribute
+{
+  public:
+    string                  type;
+    vector<PlotAttributes*> plots;
+    ViewAttributes          view;
+    int                     pipeline;
+  public:
+    virtual const char *GetType() {return "WindowAttributes";}
+    static Attribute *Create() { return new WindowAttributes; }
+    WindowAttributes() : Attribute()
+    {
+        type = "";
+        pipeline = -1;
+    }
+    virtual ~WindowAttributes()
+    {
+        for (size_t i=0; i<plots.size(); i++)
+            delete plots[i];
+    }
+    virtual void AddFields()
+    {
+        Add("type", type);
+        Add("plots", plots);
+        Add("view", view);
+        Add("pipeline", pipeline);
+    }
+};
+
+// ****************************************************************************
+// Class:  SessionAttributes
+//
+// Purpose:
+///   Everything needed to bring back a session: all the pipelines, in
+///   the order of Pipeline::allPipelines, the window arrangement (like
+///   "2h"), and the windows in that arrangement.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class SessionAttributes : public Attribute
+{
+  public:
+    vector<PipelineAttributes*> pipelines;
+    int                         currentPipeline;
+    string                      arrangement;
+    vector<WindowAttributes*>   windows;
+  public:
+    virtual const char *GetType() {return "SessionAttributes";}
+    static Attribute *Create() { return new SessionAttributes; }
+    SessionAttributes() : Attribute()
+    {
+        currentPipeline = 0;
+        arrangement = "1";
+    }
+    virtual ~SessionAttributes()
+    {
+        for (size_t i=0; i<pipelines.size(); i++)
+            delete pipelines[i];
+        for (size_t i=0; i<windows.size(); i++)
+            delete windows[i];
+    }
+    virtual void AddFields()
+    {
+        Add("pipelines", pipelines);
+        Add("currentPipeline", currentPipeline);
+        Add("arrangement", arrangement);
+        Add("windows", windows);
+    }
+};
+
+#endif
@@ -0,0 +1,325 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef OP_SLICE_H
+#define OP_SLICE_H
+
+#include "Operation.h"
+
+#include "MultiLevelContour.h"
+#include <eavlCellSetAllStructured.h>
+#include <eavlCoordinates.h>
+#include <eavlException.h>
+#include <eavlLogicalStructureRegular.h>
+
+// ****************************************************************************
+// Class:  SliceAttributes
+//
+// Purpose:
+///   Attributes for the slice operation: a point on the plane, the
+///   plane's normal, and the cell set to slice ("" for the first one).
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class SliceAttributes : public Attribute
+{
+  public:
+    float  origin[3];
+    float  normal[3];
+    string cellset;
+  public:
+    virtual const char *GetType() {return "SliceAttributes";}
+    static Attribute *Create() { return new SliceAttributes; }
+    SliceAttributes() : Attribute()
+    {
+        origin[0] = origin[1] = origin[2] = 0.;
+        normal[0] = normal[1] = 0.;
+        normal[2] = 1.;
+        cellset = "";
+    }
+    virtual ~SliceAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("origin", origin, 3);
+        Add("normal", normal, 3);
+        Add("cellset", cellset);
+    }
+};
+
+// ****************************************************************************
+// Class:  PlaneContour
+//
+// Purpose:
+///   Contours the signed distance to a plane at zero.  The distance is
+///   computed from the coordinates as each cell is visited, so no
+///   distance field is ever stored for the whole input.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class PlaneContour : public MultiLevelContour
+{
+    eavlDataSet *input;
+    double       origin[3];
+    double       normal[3];
+  public:
+    PlaneContour(const float *o, const float *n)
+        : MultiLevelContour(std::vector<float>(1, 0.f), "slice"), input(NULL)
+    {
+        for (int d=0; d<3; d++)
+        {
+            origin[d] = o[d];
+            normal[d] = n[d];
+        }
+    }
+    eavlDataSet *Execute(eavlDataSet *in, eavlCellSet *cs)
+    {
+        input = in;
+        return Contour(in, cs);
+    }
+    /// The result of a slice that misses everything.
+    eavlDataSet *CreateEmpty(eavlDataSet *in, eavlCellSet *cs)
+    {
+        return CreateOutput(in, 0, cs->GetDimensionality() - 1);
+    }
+  protected:
+    virtual float Value(int node)
+    {
+        double dist = 0;
+        for (int d=0; d<3; d++)
+            dist += (input->GetPoint(node, d) - origin[d]) * normal[d];
+        return dist;
+    }
+};
+
+// ****************************************************************************
+// Class:  SliceOperation
+//
+// Purpose:
+///   Operation that cuts a plane through a cell set.  In general the
+///   slice is the zero contour of the distance to the plane, giving
+///   triangles (or lines for 2D cells).  When the input is a
+///   rectilinear grid and the plane is normal to one of its axes, the
+///   slice is instead a plane of the grid's nodes interpolated between
+///   the two index planes around it, and the output is a 2D
+///   rectilinear grid with the same cells as that layer of the input.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class SliceOperation : public Operation
+{
+    SliceAttributes *atts;
+  public:
+    SliceOperation()
+        : Operation()
+    {
+        atts = new SliceAttributes;
+    }
+    virtual ~SliceOperation()
+    {
+        delete atts;
+    }
+    virtual std::string GetOperationName()
+    {
+        return "Slice";
+    }
+    virtual std::string GetOperationShortName()
+    {
+        return "slice";
+    }
+    virtual std::string GetOperationInfo()
+    {
+        ostringstream os;
+        os << "(" << atts->origin[0] << "," << atts->origin[1] << ","
+           << atts->origin[2] << ") n=(" << atts->normal[0] << ","
+           << atts->normal[1] << "," << atts->normal[2] << ")";
+        if (atts->cellset != "")
+            os << " on " << atts->cellset;
+        return os.str();
+    }
+    virtual Attribute *GetSettings()
+    {
+        return atts;
+    }
+    virtual void Execute()
+    {
+        if (atts->normal[0] == 0 && atts->normal[1] == 0 &&
+            atts->normal[2] == 0)
+            throw eavlException("Slice: the normal must not be zero");
+
+        eavlCellSet *cs = (atts->cellset == "") ? input->GetCellSet(0)
+                                                : input->GetCellSet(atts->cellset);
+        output = ExtractGridPlane(cs);
+        if (!output)
+        {
+            PlaneContour contour(atts->origin, atts->normal);
+            output = contour.Execute(input, cs);
+        }
+    }
+
+  protected:
+    /// If the input is a 3D rectilinear grid and the plane is normal
+    /// to one of its axes, return the slice as a 2D grid; otherwise
+    /// return NULL.
+    eavlDataSet *ExtractGridPlane(eavlCellSet *cs)
+    {
+        eavlLogicalStructureRegular *log =
+            dynamic_cast<eavlLogicalStructureRegular*>(input->GetLogicalStructure());
+        if (!log || !dynamic_cast<eavlCellSetAllStructured*>(cs) ||
+            input->GetNumCoordinateSystems() < 1)
+            return NULL;
+        eavlRegularStructure reg = log->GetRegularStructure();
+        eavlCoordinatesCartesian *coords =
+            dynamic_cast<eavlCoordinatesCartesian*>(input->GetCoordinateSystem(0));
+        if (reg.dimension != 3 || !coords || coords->GetDimension() != 3)
+            return NULL;
+
+        int axis = -1;
+        for (int d=0; d<3; d++)
+        {
+            if (atts->normal[d] == 0)
+                continue;
+            if (axis >= 0)
+                return NULL;
+            axis = d;
+        }
+
+        // the axis's values must be a field along one logical dimension
+        eavlCoordinateAxisField *af =
+            dynamic_cast<eavlCoordinateAxisField*>(coords->GetAxis(axis));
+        if (!af || input->GetFieldIndex(af->GetFieldName()) < 0)
+            return NULL;
+        eavlField *f = input->GetField(af->GetFieldName());
+        if (f->GetAssociation() != eavlField::ASSOC_LOGICALDIM)
+            return NULL;
+        int ldim = f->GetAssocLogicalDim();
+        eavlArray *values = f->GetArray();
+        int comp = af->GetComponent();
+
+        // find the layer of cells holding the plane
+        int n = reg.nodeDims[ldim];
+        double p = atts->origin[axis];
+        int layer = -1;
+        double alpha = 0;
+        for (int i=0; i+1<n && layer<0; i++)
+        {
+            double a = values->GetComponentAsDouble(i, comp);
+            double b = values->GetComponentAsDouble(i+1, comp);
+            if ((a <= p && p <= b) || (b <= p && p <= a))
+            {
+                layer = i;
+                alpha = (a == b) ? 0 : (p - a) / (b - a);
+            }
+        }
+
+        if (layer < 0)
+        {
+            // the plane misses the grid, so the slice is empty
+            PlaneContour contour(atts->origin, atts->normal);
+            return contour.CreateEmpty(input, cs);
+        }
+
+        int u = (ldim == 0) ? 1 : 0;
+        int w = (ldim == 2) ? 1 : 2;
+        int nu = reg.nodeDims[u], nw = reg.nodeDims[w];
+        eavlRegularStructure outreg;
+        outreg.SetNodeDimension2D(nu, nw);
+        eavlLogicalStructureRegular *outlog =
+            new eavlLogicalStructureRegular(outreg.dimension, outreg);
+
+        eavlDataSet *out = new eavlDataSet;
+        out->SetLogicalStructure(outlog);
+        int npts = nu * nw;
+        int ncells = (nu-1) * (nw-1);
+        out->SetNumPoints(npts);
+
+        // the input nodes on either side of each output node, and the
+        // input cell under each output cell
+        std::vector<int> nodeA(npts), nodeB(npts), cells(ncells);
+        int stride[3] = {1, reg.nodeDims[0], reg.nodeDims[0]*reg.nodeDims[1]};
+        int cstride[3] = {1, reg.cellDims[0], reg.cellDims[0]*reg.cellDims[1]};
+        int clayer = std::min(layer, reg.cellDims[ldim]-1);
+        for (int j=0; j<nw; j++)
+        {
+            for (int i=0; i<nu; i++)
+            {
+                int base = i*stride[u] + j*stride[w];
+                nodeA[j*nu+i] = base + layer*stride[ldim];
+                nodeB[j*nu+i] = base + (layer+1)*stride[ldim];
+                if (i < nu-1 && j < nw-1)
+                    cells[j*(nu-1)+i] = i*cstride[u] + j*cstride[w] +
+                                        clayer*cstride[ldim];
+            }
+        }
+
+        eavlFloatArray *pts = new eavlFloatArray("coords", 3, npts);
+        for (int i=0; i<npts; i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double pa = input->GetPoint(nodeA[i], d);
+                double pb = input->GetPoint(nodeB[i], d);
+                pts->SetComponentFromDouble(i, d, pa + alpha*(pb-pa));
+            }
+        }
+        eavlCoordinatesCartesian *cc =
+            new eavlCoordinatesCartesian(outlog,
+                                         eavlCoordinatesCartesian::X,
+                                         eavlCoordinatesCartesian::Y,
+                                         eavlCoordinatesCartesian::Z);
+        cc->SetAxis(0, new eavlCoordinateAxisField("coords", 0));
+        cc->SetAxis(1, new eavlCoordinateAxisField("coords", 1));
+        cc->SetAxis(2, new eavlCoordinateAxisField("coords", 2));
+        out->AddCoordinateSystem(cc);
+        out->AddField(new eavlField(1, pts, eavlField::ASSOC_POINTS));
+        out->AddCellSet(new eavlCellSetAllStructured("slice", outreg));
+
+        int csindex = 0;
+        for (int i=0; i<input->GetNumCellSets(); i++)
+        {
+            if (input->GetCellSet(i) == cs)
+                csindex = i;
+        }
+        for (int fi=0; fi<input->GetNumFields(); fi++)
+        {
+            eavlField *inf = input->GetField(fi);
+            eavlArray *ina = inf->GetArray();
+            if (ina->GetName() == "coords")
+                continue;
+            int nc = ina->GetNumberOfComponents();
+            if (inf->GetAssociation() == eavlField::ASSOC_POINTS)
+            {
+                eavlFloatArray *a = new eavlFloatArray(ina->GetName(), nc, npts);
+                for (int i=0; i<npts; i++)
+                {
+                    for (int c=0; c<nc; c++)
+                    {
+                        double va = ina->GetComponentAsDouble(nodeA[i], c);
+                        double vb = ina->GetComponentAsDouble(nodeB[i], c);
+                        a->SetComponentFromDouble(i, c, va + alpha*(vb-va));
+                    }
+                }
+                out->AddField(new eavlField(1, a, eavlField::ASSOC_POINTS));
+            }
+            else if (inf->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                     inf->GetAssocCellSet() == csindex)
+            {
+                eavlFloatArray *a = new eavlFloatArray(ina->GetName(), nc, ncells);
+                for (int i=0; i<ncells; i++)
+                    for (int c=0; c<nc; c++)
+                        a->SetComponentFromDouble(i, c,
+                               ina->GetComponentAsDouble(cells[i], c));
+                out->AddField(new eavlField(0, a,
+                                            eavlField::ASSOC_CELL_SET, 0));
+            }
+        }
+        return out;
+    }
+};
+
+#endif
@@ -0,0 +1,473 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef OP_STREAMLINE_H
+#define OP_STREAMLINE_H
+
+#include "Operation.h"
+
+#include "CellLocator.h"
+#include <QAtomicInt>
+#include <QRunnable>
+#include <QSemaphore>
+#include <QThread>
+#include <QThreadPool>
+#include <eavlCellSetExplicit.h>
+#include <eavlException.h>
+
+// ****************************************************************************
+// Class:  StreamlineAttributes
+//
+// Purpose:
+///   Attributes for the streamline operation: a nodal (or cell) vector
+///   field, how to seed ("line" from point1 to point2, "plane" for a
+///   grid over the rectangle between them, or "random" within their
+///   box; if they're the same, the mesh bounds are used), the number
+///   of seeds (a plane's last row has whatever doesn't make a full
+///   one), and the RK4 step size (0 for automatic) and step limit.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class StreamlineAttributes : public Attribute
+{
+  public:
+    string field;
+    string seedType;
+    float  point1[3];
+    float  point2[3];
+    int    nseeds;
+    float  stepSize;
+    int    maxSteps;
+    string cellset;
+  public:
+    virtual const char *GetType() {return "StreamlineAttributes";}
+    static Attribute *Create() { return new StreamlineAttributes; }
+    StreamlineAttributes() : Attribute()
+    {
+        field = "(default)";
+        seedType = "line";
+        point1[0] = point1[1] = point1[2] = 0.;
+        point2[0] = point2[1] = point2[2] = 0.;
+        nseeds = 10;
+        stepSize = 0.;
+        maxSteps = 1000;
+        cellset = "";
+    }
+    virtual ~StreamlineAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("field", field);
+        Add("seedType", seedType);
+        Add("point1", point1, 3);
+        Add("point2", point2, 3);
+        Add("nseeds", nseeds);
+        Add("stepSize", stepSize);
+        Add("maxSteps", maxSteps);
+        Add("cellset", cellset);
+    }
+};
+
+// ****************************************************************************
+// Class:  StreamlineTracer
+//
+// Purpose:
+///   Integrates streamlines of a nodal vector field with fixed-step
+///   RK4, from each seed until it leaves the mesh, stops moving, or
+///   runs out of steps.  The seeds are shared out to threads from the
+///   global pool (and the calling thread) as with HistogramEngine;
+///   they all use the same cell locator.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class StreamlineTracer
+{
+  public:
+    struct Line
+    {
+        std::vector<double> points;   ///< 3 per point
+        std::vector<double> times;
+        std::vector<double> speeds;
+    };
+
+  protected:
+    class Task : public QRunnable
+    {
+      public:
+        StreamlineTracer *tracer;
+        QSemaphore       *done;
+        virtual void run()
+        {
+            tracer->Work();
+            done->release();
+        }
+    };
+
+    CellLocator          *locator;
+    eavlArray            *vectors;
+    const float          *host;      ///< non-NULL for float arrays
+    double                step;
+    int                   maxSteps;
+    std::vector<double>   seeds;
+    std::vector<Line>     lines;
+    QAtomicInt            nextSeed;
+
+  public:
+    StreamlineTracer(CellLocator *loc, eavlArray *v, double h, int maxsteps)
+        : locator(loc), vectors(v), host(NULL), step(h), maxSteps(maxsteps)
+    {
+        eavlFloatArray *fa = dynamic_cast<eavlFloatArray*>(v);
+        if (fa)
+            host = fa->GetHostArray();
+    }
+    void AddSeed(const double *p)
+    {
+        seeds.insert(seeds.end(), p, p+3);
+    }
+    void Execute()
+    {
+        int nseeds = seeds.size() / 3;
+        lines.assign(nseeds, Line());
+        nextSeed = 0;
+
+        int nthreads = std::min(QThread::idealThreadCount(), nseeds);
+        QSemaphore done;
+        int started = 0;
+        for (int t=1; t<nthreads; t++)
+        {
+            Task *task = new Task;
+            task->tracer = this;
+            task->done = &done;
+            if (!QThreadPool::globalInstance()->tryStart(task))
+            {
+                delete task;
+                break;
+            }
+            started++;
+        }
+        Work();
+        done.acquire(started);
+    }
+    const std::vector<Line> &GetLines() { return lines; }
+
+  protected:
+    bool Velocity(const double *p, int &hint, double *v)
+    {
+        int nodes[CellLocator::MaxNodes];
+        double w[CellLocator::MaxNodes];
+        int n = locator->Locate(p, hint, nodes, w);
+        if (n == 0)
+            return false;
+        v[0] = v[1] = v[2] = 0;
+        for (int i=0; i<n; i++)
+        {
+            for (int d=0; d<3; d++)
+            {
+                double x = host ? host[nodes[i]*3+d]
+                                : vectors->GetComponentAsDouble(nodes[i], d);
+                v[d] += w[i] * x;
+            }
+        }
+        return true;
+    }
+
+    void Work()
+    {
+        int nseeds = seeds.size() / 3;
+        while (true)
+        {
+            int s = nextSeed.fetchAndAddOrdered(1);
+            if (s >= nseeds)
+                break;
+            Trace(&seeds[s*3], lines[s]);
+        }
+    }
+
+    void Trace(const double *seed, Line &line)
+    {
+        int hint = -1;
+        double p[3] = {seed[0], seed[1], seed[2]};
+        double v[3];
+        if (!Velocity(p, hint, v))
+            return;
+        double t = 0;
+        for (int i=0; ; i++)
+        {
+            double speed = sqrt(v[0]*v[0] + v[1]*v[1] + v[2]*v[2]);
+            line.points.insert(line.points.end(), p, p+3);
+            line.times.push_back(t);
+            line.speeds.push_back(speed);
+            if (i >= maxSteps || speed == 0)
+                break;
+
+            double k[4][3], q[3];
+            for (int d=0; d<3; d++)
+            {
+                k[0][d] = v[d];
+                q[d] = p[d] + .5*step*k[0][d];
+            }
+            if (!Velocity(q, hint, k[1]))
+                break;
+            for (int d=0; d<3; d++)
+                q[d] = p[d] + .5*step*k[1][d];
+            if (!Velocity(q, hint, k[2]))
+                break;
+            for (int d=0; d<3; d++)
+                q[d] = p[d] + step*k[2][d];
+            if (!Velocity(q, hint, k[3]))
+                break;
+            for (int d=0; d<3; d++)
+                p[d] += step/6. * (k[0][d] + 2*k[1][d] + 2*k[2][d] + k[3][d]);
+            t += step;
+            if (!Velocity(p, hint, v))
+                break;
+        }
+    }
+};
+
+// ****************************************************************************
+// Class:  StreamlineOperation
+//
+// Purpose:
+///   Operation that traces streamlines of a vector field through a 3D
+///   cell set, structured or not.  The output is a "streamlines" cell
+///   set of line segments, with nodal "time" and "speed" fields and a
+///   "seed" cell field numbering the lines.
+///
+///   A streamline can't cross from one chunk into the next, so the
+///   input must be a single chunk.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class StreamlineOperation : public Operation
+{
+    StreamlineAttributes *atts;
+  public:
+    StreamlineOperation()
+        : Operation()
+    {
+        atts = new StreamlineAttributes;
+    }
+    virtual ~StreamlineOperation()
+    {
+        delete atts;
+    }
+    virtual std::string GetOperationName()
+    {
+        return "Streamline";
+    }
+    virtual std::string GetOperationShortName()
+    {
+        return "stream";
+    }
+    virtual std::string GetOperationInfo()
+    {
+        ostringstream os;
+        os << atts->field << ": " << atts->nseeds << " " << atts->seedType;
+        if (atts->cellset != "")
+            os << " on " << atts->cellset;
+        return os.str();
+    }
+    virtual Attribute *GetSettings()
+    {
+        return atts;
+    }
+    virtual std::vector<std::string> GetNeededVariables()
+    {
+        std::vector<std::string> vars;
+        if (atts->field != "(default)")
+            vars.push_back(atts->field);
+        return vars;
+    }
+    virtual std::vector<std::string> GetOutputVariables()
+    {
+        std::vector<std::string> vars;
+        vars.push_back("time");
+        vars.push_back("speed");
+        vars.push_back("seed");
+        return vars;
+    }
+    virtual void Execute()
+    {
+        if (nchunks > 1)
+            throw eavlException("Streamline: the data set must be a single "
+                                "chunk");
+        eavlCellSet *cs = (atts->cellset == "") ? input->GetCellSet(0)
+                                                : input->GetCellSet(atts->cellset);
+        if (cs->GetDimensionality() != 3)
+            throw eavlException("Streamline: the cell set must be 3D");
+        eavlField *f = recenterCache.GetNodalField(input, atts->field);
+        if (f->GetArray()->GetNumberOfComponents() != 3)
+            throw eavlException("Streamline: the field must be a 3D vector");
+        if (atts->nseeds < 1 || atts->maxSteps < 1)
+            throw eavlException("Streamline: need at least one seed and step");
+        if (atts->seedType != "line" && atts->seedType != "plane" &&
+            atts->seedType != "random")
+            throw eavlException("Streamline: seedType must be line, "
+                                "plane or random");
+
+        CellLocator *locator = CellLocator::Create(input, cs);
+        double lo[3], hi[3];
+        locator->GetBounds(lo, hi);
+        double diag = sqrt((hi[0]-lo[0])*(hi[0]-lo[0]) +
+                           (hi[1]-lo[1])*(hi[1]-lo[1]) +
+                           (hi[2]-lo[2])*(hi[2]-lo[2]));
+
+        double step = atts->stepSize;
+        if (step <= 0)
+        {
+            // about a thousandth of the mesh, in time units of the
+            // field's largest speed
+            FieldRange r = fieldRanges.GetRange(f->GetArray());
+            step = (r.maxmag > 0) ? diag / 1000. / r.maxmag : 1.;
+        }
+
+        StreamlineTracer tracer(locator, f->GetArray(), step, atts->maxSteps);
+        AddSeeds(tracer, lo, hi);
+        tracer.Execute();
+        delete locator;
+
+        CreateOutput(tracer.GetLines());
+    }
+
+  protected:
+    void AddSeeds(StreamlineTracer &tracer, const double *lo, const double *hi)
+    {
+        double p1[3], p2[3];
+        bool same = true;
+        for (int d=0; d<3; d++)
+        {
+            p1[d] = atts->point1[d];
+            p2[d] = atts->point2[d];
+            same = same && (p1[d] == p2[d]);
+        }
+        if (same)
+        {
+            for (int d=0; d<3; d++)
+            {
+                p1[d] = lo[d];
+                p2[d] = hi[d];
+            }
+        }
+
+        int n = atts->nseeds;
+        double p[3];
+        if (atts->seedType == "line")
+        {
+            for (int i=0; i<n; i++)
+            {
+                double t = (n == 1) ? .5 : double(i) / (n-1);
+                for (int d=0; d<3; d++)
+                    p[d] = p1[d] + t*(p2[d]-p1[d]);
+                tracer.AddSeed(p);
+            }
+        }
+        else if (atts->seedType == "plane")
+        {
+            // a grid over the two longest sides of the box, halfway
+            // through the third
+            int order[3] = {0, 1, 2};
+            for (int i=0; i<3; i++)
+                for (int j=i+1; j<3; j++)
+                    if (fabs(p2[order[j]]-p1[order[j]]) >
+                        fabs(p2[order[i]]-p1[order[i]]))
+                        std::swap(order[i], order[j]);
+            int nu = std::max(1, (int)sqrt(double(n)));
+            int nv = (n + nu - 1) / nu;
+            for (int j=0; j<nv; j++)
+            {
+                // the last row spreads out whatever seeds are left
+                int nrow = std::min(nu, n - j*nu);
+                for (int i=0; i<nrow; i++)
+                {
+                    double tu = (nrow == 1) ? .5 : double(i) / (nrow-1);
+                    double tv = (nv == 1) ? .5 : double(j) / (nv-1);
+                    int u = order[0], v = order[1], w = order[2];
+                    p[u] = p1[u] + tu*(p2[u]-p1[u]);
+                    p[v] = p1[v] + tv*(p2[v]-p1[v]);
+                    p[w] = .5*(p1[w] + p2[w]);
+                    tracer.AddSeed(p);
+                }
+            }
+        }
+        else
+        {
+            // a fixed sequence, so re-executing gives the same lines
+            unsigned int state = 12345;
+            for (int i=0; i<n; i++)
+            {
+                for (int d=0; d<3; d++)
+                {
+                    state = state * 1103515245u + 12345u;
+                    double t = (state >> 8) / double(1 << 24);
+                    p[d] = p1[d] + t*(p2[d]-p1[d]);
+                }
+                tracer.AddSeed(p);
+            }
+        }
+    }
+
+    void CreateOutput(const std::vector<StreamlineTracer::Line> &lines)
+    {
+        int npts = 0;
+        for (size_t i=0; i<lines.size(); i++)
+            npts += lines[i].times.size();
+
+        output = new eavlDataSet;
+        output->SetNumPoints(npts);
+        eavlFloatArray *coords = new eavlFloatArray("coords", 3, npts);
+        eavlFloatArray *time = new eavlFloatArray("time", 1, npts);
+        eavlFloatArray *speed = new eavlFloatArray("speed", 1, npts);
+        eavlExplicitConnectivity conn;
+        std::vector<int> seedOfSegment;
+        int p = 0;
+        for (size_t i=0; i<lines.size(); i++)
+        {
+            const StreamlineTracer::Line &line = lines[i];
+            int n = line.times.size();
+            for (int j=0; j<n; j++, p++)
+            {
+                for (int d=0; d<3; d++)
+                    coords->SetComponentFromDouble(p, d, line.points[j*3+d]);
+                time->SetComponentFromDouble(p, 0, line.times[j]);
+                speed->SetComponentFromDouble(p, 0, line.speeds[j]);
+                if (j > 0)
+                {
+                    int seg[2] = {p-1, p};
+                    conn.AddElement(EAVL_BEAM, 2, seg);
+                    seedOfSegment.push_back(i);
+                }
+            }
+        }
+
+        eavlCoordinatesCartesian *cc =
+            new eavlCoordinatesCartesian(NULL,
+                                         eavlCoordinatesCartesian::X,
+                                         eavlCoordinatesCartesian::Y,
+                                         eavlCoordinatesCartesian::Z);
+        cc->SetAxis(0, new eavlCoordinateAxisField("coords", 0));
+        cc->SetAxis(1, new eavlCoordinateAxisField("coords", 1));
+        cc->SetAxis(2, new eavlCoordinateAxisField("coords", 2));
+        output->AddCoordinateSystem(cc);
+        output->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+        output->AddField(new eavlField(1, time, eavlField::ASSOC_POINTS));
+        output->AddField(new eavlField(1, speed, eavlField::ASSOC_POINTS));
+
+        eavlCellSetExplicit *cells = new eavlCellSetExplicit("streamlines", 1);
+        cells->SetCellNodeConnectivity(conn);
+        output->AddCellSet(cells);
+
+        int nsegs = seedOfSegment.size();
+        eavlFloatArray *seed = new eavlFloatArray("seed", 1, nsegs);
+        for (int i=0; i<nsegs; i++)
+            seed->SetComponentFromDouble(i, 0, seedOfSegment[i]);
+        output->AddField(new eavlField(0, seed, eavlField::ASSOC_CELL_SET, 0));
+    }
+};
+
+#endif
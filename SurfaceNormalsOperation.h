@@ -26,6 +26,7 @@ class SurfaceNormalsAttributes : public Attribute
     bool nodal;
   public:
     virtual const char *GetType() {return "SurfaceNormalsAttributes";}
+    static Attribute *Create() { return new SurfaceNormalsAttributes; }
     SurfaceNormalsAttributes() : Attribute()
     {
         nodal = true;
@@ -55,6 +56,10 @@ class SurfaceNormalsAttributes : public Attribute
 //   Jeremy Meredith, Thu Nov 29 12:20:34 EST 2012
 //   Optionally recenter to a nodal variable.
 //
+//   Run the EAVL mutators under a FilterLock.
+//
+//   Delete the settings and mutators in the destructor.
+//
 // ****************************************************************************
 class SurfaceNormalsOperation : public Operation
 {
@@ -69,6 +74,12 @@ class SurfaceNormalsOperation : public Operation
         mutator = new eavlSurfaceNormalMutator;
         recenter = new eavlCellToNodeRecenterMutator;
     }
+    virtual ~SurfaceNormalsOperation()
+    {
+        delete atts;
+        delete mutator;
+        delete recenter;
+    }
     virtual std::string GetOperationName()
     {
         return "SurfaceNormals";
@@ -88,8 +99,15 @@ class SurfaceNormalsOperation : public Operation
     {
         return atts;
     }
+    virtual std::vector<std::string> GetOutputVariables()
+    {
+        std::vector<std::string> vars;
+        vars.push_back("surface_normals");
+        return vars;
+    }
     virtual void Execute()
     {
+        FilterLock lock;
         mutator->SetDataSet(input);
         ///\todo: assuming last cell set
         string cellset = input->GetCellSet(input->GetNumCellSets()-1)->GetName();
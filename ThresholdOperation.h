@@ -0,0 +1,168 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef OP_THRESHOLD_H
+#define OP_THRESHOLD_H
+
+#include "Operation.h"
+
+#include "CellSelection.h"
+#include <eavlCellSetExplicit.h>
+#include <eavlException.h>
+
+// ****************************************************************************
+// Class:  ThresholdAttributes
+//
+// Purpose:
+///   Attributes for the threshold operation: a scalar field, the range
+///   of values to keep, and the cell set to take cells from ("" for
+///   the first one).
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class ThresholdAttributes : public Attribute
+{
+  public:
+    string field;
+    float  lower;
+    float  upper;
+    string cellset;
+  public:
+    virtual const char *GetType() {return "ThresholdAttributes";}
+    static Attribute *Create() { return new ThresholdAttributes; }
+    ThresholdAttributes() : Attribute()
+    {
+        field = "(default)";
+        lower = 0.;
+        upper = 1.;
+        cellset = "";
+    }
+    virtual ~ThresholdAttributes()
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("field", field);
+        Add("lower", lower);
+        Add("upper", upper);
+        Add("cellset", cellset);
+    }
+};
+
+// ****************************************************************************
+// Class:  ThresholdOperation
+//
+// Purpose:
+///   Operation that keeps the cells whose field is between a lower and
+///   upper value (for a nodal field, all of a cell's nodes must be).
+///   The output has one cell set, "threshold", whose cells refer to
+///   the input's points by index: the points, coordinates and nodal
+///   fields are shared with the input, not copied, and only the cell
+///   fields of the thresholded cell set are gathered for the kept
+///   cells, so the new memory is proportional to the selection.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class ThresholdOperation : public Operation
+{
+    ThresholdAttributes *atts;
+  public:
+    ThresholdOperation()
+        : Operation()
+    {
+        atts = new ThresholdAttributes;
+    }
+    virtual ~ThresholdOperation()
+    {
+        delete atts;
+    }
+    virtual std::string GetOperationName()
+    {
+        return "Threshold";
+    }
+    virtual std::string GetOperationShortName()
+    {
+        return "thresh";
+    }
+    virtual std::string GetOperationInfo()
+    {
+        ostringstream os;
+        os << atts->lower << "<=" << atts->field << "<=" << atts->upper;
+        if (atts->cellset != "")
+            os << " on " << atts->cellset;
+        return os.str();
+    }
+    virtual Attribute *GetSettings()
+    {
+        return atts;
+    }
+    virtual std::vector<std::string> GetNeededVariables()
+    {
+        std::vector<std::string> vars;
+        if (atts->field != "(default)")
+            vars.push_back(atts->field);
+        return vars;
+    }
+    virtual void Execute()
+    {
+        int csindex = 0;
+        if (atts->cellset != "")
+            csindex = input->GetCellSetIndex(atts->cellset);
+        eavlCellSet *cs = input->GetCellSet(csindex);
+        eavlField *f = input->GetField(atts->field);
+        if (f->GetArray()->GetNumberOfComponents() != 1)
+            throw eavlException("Threshold: field must be a scalar");
+        if (f->GetAssociation() != eavlField::ASSOC_POINTS &&
+            (f->GetAssociation() != eavlField::ASSOC_CELL_SET ||
+             f->GetAssocCellSet() != csindex))
+            throw eavlException("Threshold: field must be nodal or on "
+                                "the cell set being thresholded");
+
+        CellSelection selection(cs, f, atts->lower, atts->upper);
+        selection.Execute();
+        const std::vector<int> &cells = selection.GetSelected();
+        int n = cells.size();
+
+        eavlExplicitConnectivity conn;
+        for (int i=0; i<n; i++)
+        {
+            eavlCell cell = cs->GetCellNodes(cells[i]);
+            conn.AddElement(cell.type, cell.numIndices, cell.indices);
+        }
+        eavlCellSetExplicit *subset =
+            new eavlCellSetExplicit("threshold", cs->GetDimensionality());
+        subset->SetCellNodeConnectivity(conn);
+
+        output = new eavlDataSet;
+        output->SetNumPoints(input->GetNumPoints());
+        output->SetLogicalStructure(input->GetLogicalStructure());
+        for (int i=0; i<input->GetNumCoordinateSystems(); i++)
+            output->AddCoordinateSystem(input->GetCoordinateSystem(i));
+        output->AddCellSet(subset);
+
+        for (int i=0; i<input->GetNumFields(); i++)
+        {
+            eavlField *inf = input->GetField(i);
+            if (inf->GetAssociation() != eavlField::ASSOC_CELL_SET)
+            {
+                output->AddField(inf);
+            }
+            else if (inf->GetAssocCellSet() == csindex)
+            {
+                eavlArray *ina = inf->GetArray();
+                int nc = ina->GetNumberOfComponents();
+                eavlFloatArray *a = new eavlFloatArray(ina->GetName(), nc, n);
+                for (int j=0; j<n; j++)
+                    for (int c=0; c<nc; c++)
+                        a->SetComponentFromDouble(j, c,
+                               ina->GetComponentAsDouble(cells[j], c));
+                output->AddField(new eavlField(0, a,
+                                               eavlField::ASSOC_CELL_SET, 0));
+            }
+        }
+    }
+};
+
+#endif
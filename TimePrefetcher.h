@@ -0,0 +1,230 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef TIME_PREFETCHER_H
+#define TIME_PREFETCHER_H
+
+#include <QThread>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <list>
+#include "Pipeline.h"
+#include "PipelineAttributes.h"
+
+// ****************************************************************************
+// Class:  TimePrefetcher
+//
+// Purpose:
+///   Reads the next few time steps of time series pipelines on its
+///   own thread while the current one is being looked at.  Each step
+///   is executed by a throwaway copy of the pipeline, so the results
+///   land in Pipeline::resultCache under the same keys the pipeline
+///   itself will use, and moving it to that step just finds them
+///   there.  With runOps off, only the source data is read.
+///
+///   At most maxSteps steps are queued per pipeline; prefetching a
+///   pipeline again (e.g. after it moved to another step) replaces
+///   what was queued for it and cancels a step it no longer wants.
+///   Errors are ignored, since the pipeline will report them itself
+///   if it gets to that step.
+///
+///   The pipelines are only used by the GUI thread; the prefetch
+///   thread only ever touches its own copies.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+//   runOps is set under the mutex, and nprefetched is atomic, since
+//   the prefetch thread uses both.
+//
+// ****************************************************************************
+class TimePrefetcher : public QThread
+{
+  protected:
+    struct Request
+    {
+        Pipeline              *owner;
+        int                    step;
+        PipelineAttributes    *atts;
+        std::set<std::string>  vars;
+    };
+    std::list<Request> queue;
+    QMutex             mutex;
+    QWaitCondition     wake;
+    bool               quit;
+    /// the request being executed, if any
+    Pipeline          *busyOwner;
+    int                busyStep;
+    Pipeline          *busyCopy;
+    bool               busyCancelled;
+    /// whether to run the operations too, or just read the data
+    bool               runOps;
+
+  public:
+    /// how many steps past the current one to read; 0 disables it
+    int                maxSteps;
+    /// number of steps prefetched so far
+    QAtomicInt         nprefetched;
+
+  public:
+    TimePrefetcher(QObject *parent)
+        : QThread(parent), quit(false), busyOwner(NULL), busyStep(-1),
+          busyCopy(NULL), busyCancelled(false), runOps(true),
+          maxSteps(Pipeline::prefetchSteps), nprefetched(0)
+    {
+    }
+    virtual ~TimePrefetcher()
+    {
+        {
+            QMutexLocker lock(&mutex);
+            quit = true;
+            ClearQueue(NULL);
+            CancelBusy();
+            wake.wakeAll();
+        }
+        wait();
+    }
+
+    /// Queue the steps after the current one of a time series
+    /// pipeline, replacing any still queued for it.  Call this from
+    /// the GUI thread, while the pipeline isn't executing.
+    void Prefetch(Pipeline *pipe)
+    {
+        Source *src = pipe->source;
+        if (src->sourcetype != Source::File || src->timeFiles.size() < 2)
+            return;
+
+        QMutexLocker lock(&mutex);
+        ClearQueue(pipe);
+        int first = src->timeIndex + 1;
+        int last = std::min(src->timeIndex + maxSteps,
+                            (int)src->timeFiles.size() - 1);
+        if (busyOwner == pipe && (busyStep < first || busyStep > last))
+            CancelBusy();
+        for (int step = first; step <= last; step++)
+        {
+            if (busyOwner == pipe && busyStep == step && !busyCancelled)
+                continue;
+            Request r;
+            r.owner = pipe;
+            r.step = step;
+            r.atts = pipe->CreateAttributes();
+            r.atts->timeIndex = step;
+            // everything it reads, so the source's cache key matches
+            // even without the operations
+            r.vars = pipe->GetNeededVariables();
+            queue.push_back(r);
+        }
+        if (!queue.empty())
+        {
+            if (!isRunning())
+                start(QThread::LowPriority);
+            wake.wakeAll();
+        }
+    }
+
+    /// Choose whether to run the operations too, or just read the
+    /// data.  This applies to the steps started after it's called.
+    void SetRunOperations(bool ops)
+    {
+        QMutexLocker lock(&mutex);
+        runOps = ops;
+    }
+
+    /// Drop everything for a pipeline, e.g. because it changed.
+    void Forget(Pipeline *pipe)
+    {
+        QMutexLocker lock(&mutex);
+        ClearQueue(pipe);
+        if (busyOwner == pipe)
+            CancelBusy();
+    }
+
+  protected:
+    /// Remove the queued requests for a pipeline, or all of them
+    /// for NULL.  The mutex must be locked.
+    void ClearQueue(Pipeline *pipe)
+    {
+        std::list<Request>::iterator it = queue.begin();
+        while (it != queue.end())
+        {
+            if (pipe && it->owner != pipe)
+            {
+                ++it;
+                continue;
+            }
+            delete it->atts;
+            it = queue.erase(it);
+        }
+    }
+
+    /// The mutex must be locked.
+    void CancelBusy()
+    {
+        busyCancelled = true;
+        if (busyCopy)
+            busyCopy->RequestCancel();
+    }
+
+    virtual void run()
+    {
+        for (;;)
+        {
+            Request r;
+            bool ops;
+            {
+                QMutexLocker lock(&mutex);
+                while (!quit && queue.empty())
+                    wake.wait(&mutex);
+                if (quit)
+                    return;
+                r = queue.front();
+                queue.pop_front();
+                busyOwner = r.owner;
+                busyStep = r.step;
+                busyCancelled = false;
+                ops = runOps;
+            }
+
+            Pipeline *copy = new Pipeline;
+            try
+            {
+                copy->SetFromAttributes(r.atts);
+                if (!ops)
+                {
+                    for (size_t i=0; i<copy->ops.size(); i++)
+                        delete copy->ops[i];
+                    copy->ops.clear();
+                }
+                copy->requestedVariables = r.vars;
+
+                // don't start if it was cancelled while we set up
+                bool cancelled;
+                {
+                    QMutexLocker lock(&mutex);
+                    cancelled = busyCancelled;
+                    busyCopy = copy;
+                }
+                if (!cancelled)
+                {
+                    copy->Execute();
+                    nprefetched.ref();
+                }
+            }
+            catch (...)
+            {
+            }
+
+            {
+                QMutexLocker lock(&mutex);
+                busyOwner = NULL;
+                busyStep = -1;
+                busyCopy = NULL;
+            }
+            delete copy;
+            delete r.atts;
+        }
+    }
+};
+
+#endif
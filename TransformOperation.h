@@ -16,6 +16,7 @@ class TransformAttributes : public Attribute
     float tx, ty, tz;
   public:
     virtual const char *GetType() {return "TransformAttributes";}
+    static Attribute *Create() { return new TransformAttributes; }
     TransformAttributes() : Attribute()
     {
         transformCoordinates = false;
@@ -56,6 +57,10 @@ class TransformAttributes : public Attribute
 // Creation:    September 19, 2012
 //
 // Modifications:
+//   Run the EAVL mutator under a FilterLock.
+//
+//   Delete the settings and mutator in the destructor.
+//
 // ****************************************************************************
 class TransformOperation : public Operation
 {
@@ -68,6 +73,11 @@ class TransformOperation : public Operation
         atts = new TransformAttributes;
         mutator = new eavlTransformMutator;
     }
+    virtual ~TransformOperation()
+    {
+        delete atts;
+        delete mutator;
+    }
     virtual std::string GetOperationName()
     {
         return "Transform";
@@ -167,6 +177,10 @@ class TransformOperation : public Operation
     {
         return atts;
     }
+    virtual bool ModifiesCoordinates()
+    {
+        return true;
+    }
 
     virtual void Execute()
     {
@@ -192,6 +206,7 @@ class TransformOperation : public Operation
         M = rx * ry * rz * M;
         mutator->SetTransform(M);
 
+        FilterLock lock;
         mutator->Execute();
         output = input;
     }
@@ -0,0 +1,402 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#ifndef VERTEX_CLUSTERING_H
+#define VERTEX_CLUSTERING_H
+
+#include "STL.h"
+#include <algorithm>
+#include <cmath>
+#include <eavlCellSetExplicit.h>
+#include <eavlCoordinates.h>
+#include <eavlDataSet.h>
+#include <eavlException.h>
+#include <eavlFloatArray.h>
+
+// ****************************************************************************
+// Class:  VertexClustering
+//
+// Purpose:
+///   Simplifies a surface by vertex clustering.  Space is divided into
+///   a uniform grid of cubes, all the vertices in a cube are merged
+///   into one at their average position, and triangles which lose a
+///   vertex (or duplicate another triangle) are dropped.  Several
+///   levels of detail can be built in the same pass over the
+///   triangles, each with cubes twice the size of the one before.
+///
+///   Only the occupied cubes are stored, in hash tables, so fine grids
+///   don't cost memory for empty space.
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class VertexClustering
+{
+  protected:
+    /// Open-addressing hash map from a key to a dense index.
+    template <class K>
+    class IndexTable
+    {
+        std::vector<K>   keys;
+        std::vector<int> values;
+        int              count;
+      public:
+        IndexTable() : keys(1024), values(1024, -1), count(0)
+        {
+        }
+        /// Get the index of a key, adding it as the next index if new.
+        int Insert(const K &key, bool &isnew)
+        {
+            if (2*(count+1) > (int)values.size())
+                Grow();
+            size_t mask = values.size() - 1;
+            size_t h = key.Hash() & mask;
+            while (values[h] >= 0)
+            {
+                if (keys[h] == key)
+                {
+                    isnew = false;
+                    return values[h];
+                }
+                h = (h + 1) & mask;
+            }
+            keys[h] = key;
+            values[h] = count;
+            isnew = true;
+            return count++;
+        }
+        int size() const { return count; }
+      private:
+        void Grow()
+        {
+            std::vector<K> oldkeys;
+            std::vector<int> oldvalues;
+            oldkeys.swap(keys);
+            oldvalues.swap(values);
+            keys.resize(oldkeys.size()*2);
+            values.assign(oldvalues.size()*2, -1);
+            size_t mask = values.size() - 1;
+            for (size_t i=0; i<oldvalues.size(); i++)
+            {
+                if (oldvalues[i] < 0)
+                    continue;
+                size_t h = oldkeys[i].Hash() & mask;
+                while (values[h] >= 0)
+                    h = (h + 1) & mask;
+                keys[h] = oldkeys[i];
+                values[h] = oldvalues[i];
+            }
+        }
+    };
+
+    struct CubeKey
+    {
+        long long k;
+        size_t Hash() const
+        {
+            unsigned long long x = k * 0x9E3779B97F4A7C15ULL;
+            return (size_t)(x ^ (x >> 29));
+        }
+        bool operator==(const CubeKey &o) const { return k == o.k; }
+    };
+
+    struct TriangleKey
+    {
+        int a, b, c;    ///< sorted
+        size_t Hash() const
+        {
+            unsigned long long x = (unsigned long long)a * 0x9E3779B97F4A7C15ULL;
+            x = (x ^ (unsigned)b) * 0xC2B2AE3D27D4EB4FULL;
+            x = (x ^ (unsigned)c) * 0x165667B19E3779F9ULL;
+            return (size_t)(x ^ (x >> 31));
+        }
+        bool operator==(const TriangleKey &o) const
+        {
+            return a == o.a && b == o.b && c == o.c;
+        }
+    };
+
+    struct Level
+    {
+        double                   size;        ///< cube edge length
+        std::vector<int>         vertexCluster;
+        IndexTable<CubeKey>      clusters;
+        IndexTable<TriangleKey>  triangles;
+        std::vector<int>         connectivity;
+        std::vector<int>         sourceCells;
+    };
+
+    eavlDataSet        *input;
+    eavlCellSet        *cellset;
+    double              lo[3];
+    std::vector<Level*> levels;
+
+  public:
+    /// Set up nlevels levels whose cubes are cubeSize, 2*cubeSize, ...
+    /// along a side, with a corner at origin (the low end of the
+    /// bounds, as from GetBounds).
+    VertexClustering(eavlDataSet *ds, eavlCellSet *cs, const double *origin,
+                     double cubeSize, int nlevels)
+        : input(ds), cellset(cs)
+    {
+        for (int d=0; d<3; d++)
+            lo[d] = origin[d];
+        for (int l=0; l<nlevels; l++)
+        {
+            Level *level = new Level;
+            level->size = cubeSize * (1 << l);
+            level->vertexCluster.assign(ds->GetNumPoints(), -1);
+            levels.push_back(level);
+        }
+    }
+    virtual ~VertexClustering()
+    {
+        for (size_t l=0; l<levels.size(); l++)
+            delete levels[l];
+    }
+
+    /// Get the bounds of the nodes used by a cell set, and optionally
+    /// its total area.
+    static void GetBounds(eavlDataSet *ds, eavlCellSet *cs,
+                          double *minval, double *maxval, double *area = NULL)
+    {
+        for (int d=0; d<3; d++)
+        {
+            minval[d] = +HUGE_VAL;
+            if (maxval)
+                maxval[d] = -HUGE_VAL;
+        }
+        if (area)
+            *area = 0;
+        int ncells = cs->GetNumCells();
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cs->GetCellNodes(c);
+            double p[12][3];
+            for (int j=0; j<cell.numIndices; j++)
+            {
+                for (int d=0; d<3; d++)
+                {
+                    p[j][d] = ds->GetPoint(cell.indices[j], d);
+                    minval[d] = std::min(minval[d], p[j][d]);
+                    if (maxval)
+                        maxval[d] = std::max(maxval[d], p[j][d]);
+                }
+            }
+            if (!area)
+                continue;
+            for (int j=1; j+1<cell.numIndices; j++)
+            {
+                double u[3], v[3];
+                for (int d=0; d<3; d++)
+                {
+                    u[d] = p[j][d] - p[0][d];
+                    v[d] = p[j+1][d] - p[0][d];
+                }
+                double x = u[1]*v[2] - u[2]*v[1];
+                double y = u[2]*v[0] - u[0]*v[2];
+                double z = u[0]*v[1] - u[1]*v[0];
+                *area += .5 * sqrt(x*x + y*y + z*z);
+            }
+        }
+    }
+
+    /// Cluster every level in one pass over the cells.  Triangles,
+    /// quads and polygons are used; other cells are skipped.
+    void Execute()
+    {
+        int nlevels = levels.size();
+        int ncells = cellset->GetNumCells();
+        for (int c=0; c<ncells; c++)
+        {
+            eavlCell cell = cellset->GetCellNodes(c);
+            if (cell.type != EAVL_TRI && cell.type != EAVL_QUAD &&
+                cell.type != EAVL_PIXEL && cell.type != EAVL_POLYGON)
+                continue;
+            int ids[12];
+            for (int j=0; j<cell.numIndices; j++)
+                ids[j] = cell.indices[j];
+            if (cell.type == EAVL_PIXEL)
+                std::swap(ids[2], ids[3]);
+
+            for (int l=0; l<nlevels; l++)
+            {
+                Level &level = *levels[l];
+                int cl[12];
+                for (int j=0; j<cell.numIndices; j++)
+                    cl[j] = GetCluster(level, ids[j]);
+                for (int j=1; j+1<cell.numIndices; j++)
+                    AddTriangle(level, cl[0], cl[j], cl[j+1], c);
+            }
+        }
+    }
+
+    int GetNumLevels() { return levels.size(); }
+
+    /// The output: one point set shared by the levels, with each
+    /// level's clusters in turn, and a cell set of triangles per level
+    /// with the given name plus the level number.  The nodal fields
+    /// are averaged over each cluster and the cell set's cell fields
+    /// are taken from the cell each triangle came from; a cell field
+    /// keeps its name on the first level and is suffixed with the cell
+    /// set's name (e.g. "pressure_lod1") on the others.
+    eavlDataSet *CreateOutput(const std::string &prefix)
+    {
+        int nlevels = levels.size();
+        std::vector<int> first(nlevels+1, 0);
+        for (int l=0; l<nlevels; l++)
+            first[l+1] = first[l] + levels[l]->clusters.size();
+        int npts = first[nlevels];
+
+        eavlDataSet *out = new eavlDataSet;
+        out->SetNumPoints(npts);
+
+        // the coordinates are averaged like any other nodal field
+        std::vector<int> counts(npts, 0);
+        std::vector<double> sum(npts*3, 0.);
+        int ninpts = input->GetNumPoints();
+        for (int l=0; l<nlevels; l++)
+        {
+            const std::vector<int> &vc = levels[l]->vertexCluster;
+            for (int i=0; i<ninpts; i++)
+            {
+                if (vc[i] < 0)
+                    continue;
+                int o = first[l] + vc[i];
+                counts[o]++;
+                for (int d=0; d<3; d++)
+                    sum[3*o+d] += input->GetPoint(i, d);
+            }
+        }
+        eavlFloatArray *coords = new eavlFloatArray("coords", 3, npts);
+        for (int i=0; i<npts; i++)
+            for (int d=0; d<3; d++)
+                coords->SetComponentFromDouble(i, d, sum[3*i+d] / counts[i]);
+
+        eavlCoordinatesCartesian *cc =
+            new eavlCoordinatesCartesian(NULL,
+                                         eavlCoordinatesCartesian::X,
+                                         eavlCoordinatesCartesian::Y,
+                                         eavlCoordinatesCartesian::Z);
+        cc->SetAxis(0, new eavlCoordinateAxisField("coords", 0));
+        cc->SetAxis(1, new eavlCoordinateAxisField("coords", 1));
+        cc->SetAxis(2, new eavlCoordinateAxisField("coords", 2));
+        out->AddCoordinateSystem(cc);
+        out->AddField(new eavlField(1, coords, eavlField::ASSOC_POINTS));
+
+        for (int l=0; l<nlevels; l++)
+        {
+            eavlExplicitConnectivity conn;
+            std::vector<int> &c = levels[l]->connectivity;
+            for (size_t t=0; t<c.size(); t+=3)
+            {
+                int tri[3] = {first[l]+c[t], first[l]+c[t+1], first[l]+c[t+2]};
+                conn.AddElement(EAVL_TRI, 3, tri);
+            }
+            ostringstream name;
+            name << prefix << l;
+            eavlCellSetExplicit *cells = new eavlCellSetExplicit(name.str(), 2);
+            cells->SetCellNodeConnectivity(conn);
+            out->AddCellSet(cells);
+        }
+
+        int csindex = 0;
+        for (int i=0; i<input->GetNumCellSets(); i++)
+        {
+            if (input->GetCellSet(i) == cellset)
+                csindex = i;
+        }
+        for (int f=0; f<input->GetNumFields(); f++)
+        {
+            eavlField *inf = input->GetField(f);
+            eavlArray *ina = inf->GetArray();
+            if (ina->GetName() == "coords")
+                continue;
+            int nc = ina->GetNumberOfComponents();
+            if (inf->GetAssociation() == eavlField::ASSOC_POINTS)
+            {
+                sum.assign(npts*nc, 0.);
+                for (int l=0; l<nlevels; l++)
+                {
+                    const std::vector<int> &vc = levels[l]->vertexCluster;
+                    for (int i=0; i<ninpts; i++)
+                    {
+                        if (vc[i] < 0)
+                            continue;
+                        int o = first[l] + vc[i];
+                        for (int j=0; j<nc; j++)
+                            sum[o*nc+j] += ina->GetComponentAsDouble(i, j);
+                    }
+                }
+                eavlFloatArray *a = new eavlFloatArray(ina->GetName(), nc, npts);
+                for (int i=0; i<npts; i++)
+                    for (int j=0; j<nc; j++)
+                        a->SetComponentFromDouble(i, j, sum[i*nc+j] / counts[i]);
+                out->AddField(new eavlField(1, a, eavlField::ASSOC_POINTS));
+            }
+            else if (inf->GetAssociation() == eavlField::ASSOC_CELL_SET &&
+                     inf->GetAssocCellSet() == csindex)
+            {
+                for (int l=0; l<nlevels; l++)
+                {
+                    // each level's cell set gets its own copy of the
+                    // field; field names must be unique, so all but the
+                    // first are named for their cell set
+                    const std::vector<int> &src = levels[l]->sourceCells;
+                    int n = src.size();
+                    ostringstream name;
+                    name << ina->GetName();
+                    if (l > 0)
+                        name << "_" << prefix << l;
+                    eavlFloatArray *a = new eavlFloatArray(name.str(), nc, n);
+                    for (int i=0; i<n; i++)
+                        for (int j=0; j<nc; j++)
+                            a->SetComponentFromDouble(i, j,
+                                   ina->GetComponentAsDouble(src[i], j));
+                    out->AddField(new eavlField(0, a,
+                                                eavlField::ASSOC_CELL_SET, l));
+                }
+            }
+        }
+        return out;
+    }
+
+  protected:
+    int GetCluster(Level &level, int node)
+    {
+        int &cluster = level.vertexCluster[node];
+        if (cluster >= 0)
+            return cluster;
+        long long key = 0;
+        for (int d=0; d<3; d++)
+        {
+            long long i = (long long)((input->GetPoint(node, d) - lo[d]) /
+                                      level.size);
+            key |= std::min(i, (1LL<<21) - 1) << (21*d);
+        }
+        CubeKey k;
+        k.k = key;
+        bool isnew;
+        cluster = level.clusters.Insert(k, isnew);
+        return cluster;
+    }
+
+    void AddTriangle(Level &level, int a, int b, int c, int source)
+    {
+        if (a == b || b == c || a == c)
+            return;
+        TriangleKey k;
+        k.a = std::min(a, std::min(b, c));
+        k.c = std::max(a, std::max(b, c));
+        k.b = a + b + c - k.a - k.c;
+        bool isnew;
+        level.triangles.Insert(k, isnew);
+        if (!isnew)
+            return;
+        level.connectivity.push_back(a);
+        level.connectivity.push_back(b);
+        level.connectivity.push_back(c);
+        level.sourceCells.push_back(source);
+    }
+};
+
+#endif
@@ -1,6 +1,14 @@
 // Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
 #include "XMLTools.h"
 
+#include <fstream>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 const bool ErrorOnMismatchedTags = false;
 
 static string XMLTokenTypeToString(XMLToken t)
@@ -23,80 +31,201 @@ static string XMLTokenTypeToString(XMLToken t)
 }
 
 
-XMLScanner::XMLScanner(istream &input)
-    : in(input),
-      c('\0'),
-      havePeek(false),
-      currentLine(1)
+XMLInputBuffer::XMLInputBuffer()
+    : data(""), size(0), mapped(NULL), mappedSize(0)
 {
 }
 
-XMLToken XMLScanner::GetNextToken(char *outbuff)
+XMLInputBuffer::~XMLInputBuffer()
 {
-    char *buff = outbuff;
-    *buff = '\0';
+    Clear();
+}
 
-    if (!havePeek)
+void XMLInputBuffer::Clear()
+{
+#ifndef _WIN32
+    if (mapped)
+        munmap(mapped, mappedSize);
+#endif
+    mapped = NULL;
+    mappedSize = 0;
+    storage = "";
+    data = "";
+    size = 0;
+}
+
+void XMLInputBuffer::SetFromStream(istream &input)
+{
+    Clear();
+    char chunk[65536];
+    while (input.read(chunk, sizeof(chunk)) || input.gcount() > 0)
+        storage.append(chunk, input.gcount());
+    data = storage.data();
+    size = storage.size();
+}
+
+void XMLInputBuffer::SetFromString(const string &s)
+{
+    Clear();
+    storage = s;
+    data = storage.data();
+    size = storage.size();
+}
+
+void XMLInputBuffer::SetFromFile(const string &filename)
+{
+    Clear();
+#ifndef _WIN32
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw Exception("Couldn't open %s", filename.c_str());
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
     {
-        c=in.get();
+        void *p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED)
+        {
+            mapped = p;
+            mappedSize = st.st_size;
+            data = (const char*)p;
+            size = st.st_size;
+        }
     }
-    havePeek = false;
+    close(fd);
+    if (mapped)
+        return;
+#endif
+    // no mmap (or it failed, e.g. for a pipe); just read it
+    ifstream in(filename.c_str(), ios::in | ios::binary);
+    if (!in)
+        throw Exception("Couldn't open %s", filename.c_str());
+    SetFromStream(in);
+}
+
+
+XMLScanner::XMLScanner(const char *data, size_t size)
+    : pos(data),
+      end(data + size),
+      currentLine(1)
+{
+}
+
+static inline bool IsXMLWhitespace(char c)
+{
+    return (c==' ' || c=='\n' || c=='\t' || c=='\r');
+}
+
+static int HexDigitValue(char c)
+{
+    if (c>='0' && c<='9')
+        return c-'0';
+    else if (c>='a' && c<='f')
+        return 10 + c-'a';
+    else if (c>='A' && c<='F')
+        return 10 + c-'A';
+    // Error: non-hex digit in string.
+    return -1;
+}
+
+XMLToken XMLScanner::GetNextToken(XMLTokenText &text)
+{
+    text.begin = "";
+    text.length = 0;
 
     // strip leading whitespace
-    while (!in.eof() && (c==' ' || c=='\n' || c=='\t'))
+    while (pos < end && IsXMLWhitespace(*pos))
     {
-        if (c == '\n')
+        if (*pos == '\n')
             currentLine++;
-        c=in.get();
+        pos++;
     }
 
     // Check for EOF
-    if (in.eof())
+    if (pos >= end)
     {
         return TokEOF;
     }
 
     // default case for simple token text; longer ones will override this.
-    buff[0] = c;
-    buff[1] = 0;
+    char c = *pos;
+    text.begin = pos;
+    text.length = 1;
 
     // figure out what we've got
     if (c=='<')
+    {
+        pos++;
         return TokOpen;
+    }
     else if (c=='>')
+    {
+        pos++;
         return TokClose;
+    }
     else if (c=='=')
+    {
+        pos++;
         return TokEqual;
+    }
     else if (c=='/')
+    {
+        pos++;
         return TokSlash;
+    }
     else if (c=='!')
+    {
+        pos++;
         return TokBang;
+    }
     else if (c=='?')
+    {
+        pos++;
         return TokQuestion;
+    }
     else if (c=='\"')
     {
-        c=in.get();
-        while (c!='\"')
+        pos++;
+        const char *start = pos;
+
+        // the common case: no escape codes, so the text can be
+        // used in place
+        while (pos < end && *pos != '\"' && *pos != '&' && *pos != '\\')
+        {
+            if (*pos == '\n')
+                currentLine++;
+            pos++;
+        }
+        if (pos < end && *pos == '\"')
         {
+            text.begin = start;
+            text.length = pos - start;
+            pos++;
+            return TokString;
+        }
+
+        // otherwise, copy it while decoding the escapes
+        string &buff = text.unescaped;
+        buff.assign(start, pos - start);
+        while (pos < end && *pos != '\"')
+        {
+            c = *pos++;
 #define ACCEPT_AMPERSAND_CODES
 #ifdef ACCEPT_AMPERSAND_CODES
             if (c=='&')
             {
-                string tmp;
-                c=in.get();
-                while (c != ';' && !in.eof())
-                {
-                    tmp += c;
-                    c=in.get();
-                }
+                const char *semi = pos;
+                while (semi < end && *semi != ';')
+                    semi++;
+                string tmp(pos, semi - pos);
+                pos = (semi < end) ? semi+1 : end;
                 if (tmp == "quot")
-                    *buff++ = '"';
+                    buff += '"';
                 else if (tmp == "amp")
-                    *buff++ = '&';
+                    buff += '&';
                 else if (tmp == "lt")
-                    *buff++ = '<';
+                    buff += '<';
                 else if (tmp == "gt")
-                    *buff++ = '>';
+                    buff += '>';
                 else
                     cerr << "UNEXPECTED AMPERSAND CODE: "<<tmp<<endl;
             }
@@ -105,82 +234,56 @@ XMLToken XMLScanner::GetNextToken(char *outbuff)
 #ifdef ACCEPT_BACKSLASH_CODES
             else if (c=='\\')
             {
-                c=in.get();
-                if      (c=='n')  *buff++ = '\n';
-                else if (c=='t')  *buff++ = '\t';
-                else if (c=='\\') *buff++ = '\\';
+                if (pos >= end)
+                    break;
+                c = *pos++;
+                if      (c=='n')  buff += '\n';
+                else if (c=='t')  buff += '\t';
+                else if (c=='\\') buff += '\\';
                 else if (c=='x')
                 {
-                    char c1 = in.get();
-                    char c2 = in.get();
-                    int v1;
-                    if (c1>='0' && c1<='9')
-                        v1 = c1-'0';
-                    else if (c1>='a' && c1<='f')
-                        v1 = 10 + c1-'a';
-                    else if (c1>='A' && c1<='F')
-                        v1 = 10 + c1-'A';
-                    else
-                    {
-                        // Error: non-hex digit in string.
-                        v1 = -1;
-                    }
-                    int v2;
-                    if (c2>='0' && c2<='9')
-                        v2 = c2-'0';
-                    else if (c2>='a' && c2<='f')
-                        v2 = 10 + c2-'a';
-                    else if (c2>='A' && c2<='F')
-                        v2 = 10 + c2-'A';
-                    else
-                    {
-                        // Error: non-hex digit in string.
-                        v2 = -1;
-                    }
+                    int v1 = (pos < end) ? HexDigitValue(*pos++) : -1;
+                    int v2 = (pos < end) ? HexDigitValue(*pos++) : -1;
                     if (v1 < 0 || v2 < 0)
                     {
                         // could handle this error better
-                        //*buff++ = '\\';
-                        //*buff++ = 'x';
-                        //*buff++ = c1;
-                        //*buff++ = c2;
                     }
                     else
                     {
                         // good hex-character representation
-                        *buff++ = char(v1*16 + v2);
+                        buff += char(v1*16 + v2);
                     }
                 }
                 else
-                    *buff++ = c;
+                    buff += c;
             }
 #endif
             else
             {
                 if (c == '\n')
                     currentLine++;
-                *buff++ = c;
+                buff += c;
             }
-            c=in.get();
         }
-        *buff++ = '\0';
+        if (pos < end)
+            pos++; // the closing quote
+        text.begin = buff.data();
+        text.length = buff.length();
         return TokString;
     }
     else
     {
-        havePeek = true;
-        while (!in.eof() &&
-               c!=' ' &&
-               c!='\n' &&
-               c!='\t' &&
-               c!='=' &&
-               c!='>' &&
-               c!='<')
+        const char *start = pos;
+        while (pos < end &&
+               !IsXMLWhitespace(*pos) &&
+               *pos!='=' &&
+               *pos!='>' &&
+               *pos!='<')
         {
-            *buff++ = c;
-            c=in.get();
+            pos++;
         }
-        *buff++ = '\0';
+        text.begin = start;
+        text.length = pos - start;
 
         return TokLiteral;
     }
@@ -188,7 +291,7 @@ XMLToken XMLScanner::GetNextToken(char *outbuff)
 
 int XMLScanner::GetCurrentLine()
 {
-    return currentLine++;
+    return currentLine;
 }
 
 XMLParser::XMLParser()
@@ -198,9 +301,9 @@ XMLParser::XMLParser()
 
 void XMLParser::GetNextToken()
 {
-    char *newText = acceptedText;
+    XMLTokenText *newText = acceptedText;
     acceptedText = currentText;
-    token = scanner->GetNextToken(newText);
+    token = scanner->GetNextToken(*newText);
     currentText = newText;
 }
 
@@ -210,7 +313,7 @@ bool XMLParser::Accept(XMLToken t)
     {
         GetNextToken();
         //cerr << "Accepted token type="<<XMLTokenTypeToString(t)
-        //     << ", text=\""<<acceptedText<<"\"\n";
+        //     << ", text=\""<<acceptedText->str()<<"\"\n";
         return true;
     }
     else
@@ -233,7 +336,7 @@ void XMLParser::Expect(XMLToken t)
                 XMLTokenTypeToString(t).c_str(),
                 scanner->GetCurrentLine(),
                 XMLTokenTypeToString(token).c_str(),
-                acceptedText);
+                acceptedText->str().c_str());
     }
 }
 
@@ -244,7 +347,7 @@ bool XMLParser::ParseXMLNestingAfterOpenBracket()
     {
         while (!Accept(TokClose))
         {
-            handleComment(currentText);
+            handleComment(currentText->str());
             GetNextToken();
         }
         return false;
@@ -263,17 +366,17 @@ bool XMLParser::ParseXMLNestingAfterOpenBracket()
 
     // Not a comment; we expect a literal for the element name
     Expect(TokLiteral);
-    string elementName = acceptedText;
+    string elementName = acceptedText->str();
 
     // Read the attributes, if there are any
     XMLAttributes attributes;
     while (Accept(TokLiteral))
     {
         XMLAttribute a;
-        a.type = acceptedText;
+        a.type = acceptedText->str();
         Expect(TokEqual);
         Expect(TokString);
-        a.value = acceptedText;
+        a.value = acceptedText->str();
         attributes.push_back(a);
     }
     if (Accept(TokSlash))
@@ -301,7 +404,7 @@ bool XMLParser::ParseXMLNestingAfterOpenBracket()
             }
             else
             {
-                handleText(currentText);
+                handleText(currentText->str());
                 GetNextToken();
             }
         }
@@ -309,13 +412,13 @@ bool XMLParser::ParseXMLNestingAfterOpenBracket()
         // Can only get here once we get to a open-bracket and slash, so
         // it had better be the matching close tag
         Expect(TokLiteral);
-        if (acceptedText != elementName and
+        if (acceptedText->str() != elementName and
             ErrorOnMismatchedTags)
         {
             throw Exception("Mismatched open/close tags at line %d: "
                             "expected '%s' but got '%s'",
                             scanner->GetCurrentLine(), elementName.c_str(),
-                            acceptedText);
+                            acceptedText->str().c_str());
         }
         Expect(TokClose);
         endElement(elementName);
@@ -324,19 +427,34 @@ bool XMLParser::ParseXMLNestingAfterOpenBracket()
     return true;
 }
 
-void XMLParser::Initialize(istream &input)
+void XMLParser::Initialize(istream &in)
+{
+    input.SetFromStream(in);
+    StartScanning();
+}
+
+void XMLParser::InitializeFromString(const string &s)
+{
+    input.SetFromString(s);
+    StartScanning();
+}
+
+void XMLParser::InitializeFromFile(const string &filename)
+{
+    input.SetFromFile(filename);
+    StartScanning();
+}
+
+void XMLParser::StartScanning()
 {
     if (scanner)
         delete scanner;
 
     // init
-    savedInput = &input;
     token = TokNone;
-    buff1[0] = 0;
-    buff2[0] = 0;
-    currentText  = buff1;
-    acceptedText = buff2;
-    scanner = new XMLScanner(input);
+    currentText  = &text1;
+    acceptedText = &text2;
+    scanner = new XMLScanner(input.GetData(), input.GetSize());
     GetNextToken();
 }
 
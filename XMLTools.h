@@ -32,17 +32,69 @@ enum XMLToken {
     TokNone
 };
 
+// ****************************************************************************
+//  Class:  XMLInputBuffer
+//
+//  Purpose:
+//    The whole input of an XMLParser as one contiguous block, so the
+//    scanner can work directly on memory.  Files are memory-mapped
+//    where supported; streams and strings are copied.
+//
+//  Creation:    October 17, 2026
+//
+// ****************************************************************************
+class XMLInputBuffer
+{
+  public:
+    XMLInputBuffer();
+    ~XMLInputBuffer();
+    void        SetFromStream(istream &input);
+    void        SetFromString(const string &s);
+    void        SetFromFile(const string &filename);
+    const char *GetData() const { return data; }
+    size_t      GetSize() const { return size; }
+  private:
+    XMLInputBuffer(const XMLInputBuffer&);
+    void operator=(const XMLInputBuffer&);
+    void        Clear();
+
+    string      storage;
+    const char *data;
+    size_t      size;
+    void       *mapped;
+    size_t      mappedSize;
+};
+
+// ****************************************************************************
+//  Struct:  XMLTokenText
+//
+//  Purpose:
+//    The text of a token.  Usually this points into the input buffer;
+//    only strings with escape codes are copied (into "unescaped").
+//
+//  Creation:    October 17, 2026
+//
+// ****************************************************************************
+struct XMLTokenText
+{
+    const char *begin;
+    size_t      length;
+    string      unescaped;
+
+    XMLTokenText() : begin(""), length(0) { }
+    string str() const { return string(begin, length); }
+};
+
 class XMLScanner
 {
   public:
-    XMLScanner(istream &input);
-    XMLToken GetNextToken(char *outbuff);
+    XMLScanner(const char *data, size_t size);
+    XMLToken GetNextToken(XMLTokenText &text);
     int      GetCurrentLine();
   private:
-    istream  &in;
-    char      c;
-    bool      havePeek;
-    int       currentLine;
+    const char *pos;
+    const char *end;
+    int         currentLine;
 };
 
 
@@ -84,6 +136,8 @@ class XMLParser
     XMLParser();
     virtual ~XMLParser();
     void Initialize(istream &input);
+    void InitializeFromString(const string &s);
+    void InitializeFromFile(const string &filename);
     void ParseSingleEntity();
     void ParseAllEntities();
 
@@ -92,15 +146,16 @@ class XMLParser
     virtual void handleText(const string &text) = 0;
     virtual void handleComment(const string &) {}; // no-op default is good
     virtual void endElement(const string &name) = 0;
-    istream *savedInput;
 
   private:
+    XMLInputBuffer input;
     XMLScanner *scanner;
     XMLToken token;
-    char *currentText;
-    char *acceptedText;
-    char buff1[4096];
-    char buff2[4096];
+    XMLTokenText *currentText;
+    XMLTokenText *acceptedText;
+    XMLTokenText text1;
+    XMLTokenText text2;
+    void StartScanning();
     void GetNextToken();
     bool Accept(XMLToken t);
     void Expect(XMLToken t);
@@ -0,0 +1,129 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "Attribute.h"
+#include <cstdlib>
+#include <cstdio>
+#include <ctime>
+#include <sstream>
+
+// ****************************************************************************
+// Program:  AttributeBench
+//
+// Purpose:
+///   Times Attribute's binary serialization against the XML one, on
+///   an attribute holding a few settings and a large float and int
+///   vector (like an operation's control points or a saved colormap),
+///   and checks that both read back what was written.
+///
+///   It isn't part of eavlab.pro; build it from this directory with
+///   EAVL's common directory (for STL.h) on the include path, e.g.
+///     g++ -O2 -I.. -I$EAVL/src/common AttributeBench.cpp ../Attribute.cpp
+///         ../XMLTools.cpp -o AttributeBench
+///
+///   Usage:  AttributeBench [nvalues [repeats]]
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+
+class BenchAttributes : public Attribute
+{
+  public:
+    string          name;
+    double          scale;
+    int             ncomps;
+    vector<float>   values;
+    vector<int32>   ids;
+  public:
+    virtual const char *GetType() { return "BenchAttributes"; }
+    static Attribute *Create() { return new BenchAttributes; }
+    BenchAttributes() : Attribute(), name("bench"), scale(1.), ncomps(1)
+    {
+    }
+    virtual void AddFields()
+    {
+        Add("name", name);
+        Add("scale", scale);
+        Add("ncomps", ncomps);
+        Add("values", values);
+        Add("ids", ids);
+    }
+};
+
+static double
+Seconds(clock_t start)
+{
+    return double(clock() - start) / CLOCKS_PER_SEC;
+}
+
+static bool
+Same(BenchAttributes &a, BenchAttributes &b)
+{
+    return a.name == b.name && a.scale == b.scale && a.ncomps == b.ncomps &&
+           a.values == b.values && a.ids == b.ids;
+}
+
+int
+main(int argc, char *argv[])
+{
+    int n = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int repeats = (argc > 2) ? atoi(argv[2]) : 3;
+    if (n < 0 || repeats < 1)
+    {
+        cerr << "Usage: " << argv[0] << " [nvalues [repeats]]\n";
+        return 1;
+    }
+
+    BenchAttributes src;
+    src.name = "a \"quoted\" name with a \\ backslash";
+    src.scale = 1. / 3.;
+    src.ncomps = 3;
+    src.values.resize(n);
+    src.ids.resize(n);
+    srand(1);
+    for (int i=0; i<n; i++)
+    {
+        src.values[i] = float(rand()) / float(RAND_MAX) * 1000.f - 500.f;
+        src.ids[i] = rand();
+    }
+
+    double xmlWrite = 0, xmlRead = 0, binWrite = 0, binRead = 0;
+    size_t xmlSize = 0, binSize = 0;
+    bool xmlSame = true, binSame = true;
+    for (int r=0; r<repeats; r++)
+    {
+        clock_t start = clock();
+        string xml = src.XMLSerialize();
+        xmlWrite += Seconds(start);
+        xmlSize = xml.size();
+
+        BenchAttributes fromXML;
+        start = clock();
+        fromXML.XMLUnserialize(xml);
+        xmlRead += Seconds(start);
+        // XML writes floats as decimal text, so don't expect them exact
+        xmlSame = xmlSame && (fromXML.values.size() == src.values.size()) &&
+                  (fromXML.ids == src.ids) && (fromXML.name == src.name);
+
+        start = clock();
+        string bin = src.BinarySerialize();
+        binWrite += Seconds(start);
+        binSize = bin.size();
+
+        BenchAttributes fromBin;
+        start = clock();
+        fromBin.BinaryUnserialize(bin);
+        binRead += Seconds(start);
+        binSame = binSame && Same(fromBin, src);
+    }
+
+    printf("%d floats and ints, averaged over %d runs:\n", n, repeats);
+    printf("  %-8s %12s %12s %12s\n", "format", "bytes", "write (s)", "read (s)");
+    printf("  %-8s %12lu %12.4f %12.4f  %s\n", "XML",
+           (unsigned long)xmlSize, xmlWrite / repeats, xmlRead / repeats,
+           xmlSame ? "ok" : "MISMATCH");
+    printf("  %-8s %12lu %12.4f %12.4f  %s\n", "binary",
+           (unsigned long)binSize, binWrite / repeats, binRead / repeats,
+           binSame ? "ok" : "MISMATCH");
+    return (xmlSame && binSame) ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "HistogramEngine.h"
+#include <QElapsedTimer>
+#include <cstdio>
+#include <cstdlib>
+
+// ****************************************************************************
+// Program:  HistogramBench
+//
+// Purpose:
+///   Times HistogramEngine binning a large float array (100M values by
+///   default) with different numbers of threads, with log bins, and
+///   against the simple loop it replaced, which asked the array for
+///   each value through a virtual call.  Every run must count the same
+///   values.
+///
+///   It isn't part of eavlab.pro; build it from this directory against
+///   QtCore and EAVL, e.g.:
+///     g++ -O2 -I.. -I$EAVL/src/common -I$QTDIR/include/QtCore
+///         HistogramBench.cpp -L$EAVL/lib -leavl -lQtCore -o HistogramBench
+///
+///   Usage:  HistogramBench [nvalues [nbins]]
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+
+static long long
+Total(const std::vector<long long> &counts)
+{
+    long long total = 0;
+    for (size_t b=0; b<counts.size(); b++)
+        total += counts[b];
+    return total;
+}
+
+static void
+Report(const char *label, double seconds, long long n)
+{
+    printf("  %-20s %8.3f s  %8.0f M values/s\n", label, seconds,
+           n / seconds / 1e6);
+}
+
+int
+main(int argc, char *argv[])
+{
+    long long n = (argc > 1) ? atoll(argv[1]) : 100000000LL;
+    int nbins = (argc > 2) ? atoi(argv[2]) : 256;
+    if (n < 1 || nbins < 1)
+    {
+        cerr << "Usage: " << argv[0] << " [nvalues [nbins]]\n";
+        return 1;
+    }
+
+    // uniform values in [0,1), from a simple LCG so runs are repeatable
+    eavlFloatArray *a = new eavlFloatArray("values", 1, n);
+    unsigned int seed = 1;
+    for (long long i=0; i<n; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        a->SetComponentFromDouble(i, 0, (seed >> 8) * (1. / 16777216.));
+    }
+    printf("%lld values, %d bins\n", n, nbins);
+
+    QElapsedTimer timer;
+    bool ok = true;
+    int threads[] = {1, 2, 4, 8, 0};
+    for (int k=0; k<5; k++)
+    {
+        HistogramEngine engine(nbins, 0, 1, false);
+        engine.AddArray(a);
+        timer.start();
+        engine.Execute(threads[k]);
+        double t = timer.elapsed() / 1000.;
+        long long total = Total(engine.GetCounts(0));
+        ok = ok && (total == n);
+        char label[64];
+        if (threads[k] > 0)
+            sprintf(label, "engine, %d thread(s)", threads[k]);
+        else
+            sprintf(label, "engine, all threads");
+        Report(label, t, n);
+    }
+
+    {
+        HistogramEngine engine(nbins, 1e-3, 1, true);
+        engine.AddArray(a);
+        timer.start();
+        engine.Execute();
+        double t = timer.elapsed() / 1000.;
+        Report("engine, log bins", t, n);
+    }
+
+    {
+        std::vector<long long> counts(nbins, 0);
+        timer.start();
+        for (long long i=0; i<n; i++)
+        {
+            double v = a->GetComponentAsDouble(i, 0);
+            int b = int(v * nbins);
+            if (b >= nbins)
+                b = nbins-1;
+            if (b >= 0)
+                counts[b]++;
+        }
+        double t = timer.elapsed() / 1000.;
+        ok = ok && (Total(counts) == n);
+        Report("per-value loop", t, n);
+    }
+
+    printf("  counts %s\n", ok ? "match" : "DIFFER");
+    delete a;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+// Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
+#include "XMLTools.h"
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+
+// ****************************************************************************
+// Program:  XMLScanBench
+//
+// Purpose:
+///   Times the XML scanner, which works on the whole input as one
+///   buffer, against the scanner it replaced, which read the input a
+///   character at a time with istream::get() (copied here as
+///   StreamXMLScanner).  Both scan the same file and must produce the
+///   same tokens.  Without a file, it writes a session-like one of the
+///   given size (in MB) and scans that.
+///
+///   It isn't part of eavlab.pro; build it from this directory with
+///   EAVL's common directory (for STL.h) on the include path, e.g.:
+///     g++ -O2 -I.. -I$EAVL/src/common XMLScanBench.cpp ../XMLTools.cpp
+///         -o XMLScanBench
+///
+///   Usage:  XMLScanBench [file.xml | -size MB]
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+
+// ****************************************************************************
+// Class:  StreamXMLScanner
+//
+// Purpose:
+///   The old XMLScanner, unchanged except that the caller's token
+///   buffer must be big enough for the longest token (the parser used
+///   to give it 4096 bytes, so long tokens overflowed).
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+class StreamXMLScanner
+{
+  public:
+    StreamXMLScanner(istream &input)
+        : in(input), c('\0'), havePeek(false), currentLine(1)
+    {
+    }
+    XMLToken GetNextToken(char *outbuff);
+  private:
+    istream  &in;
+    char      c;
+    bool      havePeek;
+    int       currentLine;
+};
+
+static int
+HexValue(char c)
+{
+    if (c>='0' && c<='9')
+        return c-'0';
+    else if (c>='a' && c<='f')
+        return 10 + c-'a';
+    else if (c>='A' && c<='F')
+        return 10 + c-'A';
+    return -1;
+}
+
+XMLToken
+StreamXMLScanner::GetNextToken(char *outbuff)
+{
+    char *buff = outbuff;
+    *buff = '\0';
+
+    if (!havePeek)
+        c=in.get();
+    havePeek = false;
+
+    // strip leading whitespace
+    while (!in.eof() && (c==' ' || c=='\n' || c=='\t'))
+    {
+        if (c == '\n')
+            currentLine++;
+        c=in.get();
+    }
+
+    if (in.eof())
+        return TokEOF;
+
+    buff[0] = c;
+    buff[1] = 0;
+
+    if (c=='<')
+        return TokOpen;
+    else if (c=='>')
+        return TokClose;
+    else if (c=='=')
+        return TokEqual;
+    else if (c=='/')
+        return TokSlash;
+    else if (c=='!')
+        return TokBang;
+    else if (c=='?')
+        return TokQuestion;
+    else if (c=='\"')
+    {
+        c=in.get();
+        while (c!='\"')
+        {
+            if (c=='&')
+            {
+                string tmp;
+                c=in.get();
+                while (c != ';' && !in.eof())
+                {
+                    tmp += c;
+                    c=in.get();
+                }
+                if (tmp == "quot")
+                    *buff++ = '"';
+                else if (tmp == "amp")
+                    *buff++ = '&';
+                else if (tmp == "lt")
+                    *buff++ = '<';
+                else if (tmp == "gt")
+                    *buff++ = '>';
+            }
+            else if (c=='\\')
+            {
+                c=in.get();
+                if      (c=='n')  *buff++ = '\n';
+                else if (c=='t')  *buff++ = '\t';
+                else if (c=='\\') *buff++ = '\\';
+                else if (c=='x')
+                {
+                    int v1 = HexValue(in.get());
+                    int v2 = HexValue(in.get());
+                    if (v1 >= 0 && v2 >= 0)
+                        *buff++ = char(v1*16 + v2);
+                }
+                else
+                    *buff++ = c;
+            }
+            else
+            {
+                if (c == '\n')
+                    currentLine++;
+                *buff++ = c;
+            }
+            c=in.get();
+        }
+        *buff++ = '\0';
+        return TokString;
+    }
+    else
+    {
+        havePeek = true;
+        while (!in.eof() &&
+               c!=' ' &&
+               c!='\n' &&
+               c!='\t' &&
+               c!='=' &&
+               c!='>' &&
+               c!='<')
+        {
+            *buff++ = c;
+            c=in.get();
+        }
+        *buff++ = '\0';
+        return TokLiteral;
+    }
+}
+
+// ****************************************************************************
+// Function:  WriteTestFile
+//
+// Purpose:
+///   Write roughly mb megabytes of XML shaped like a saved session:
+///   nested elements with attributes, long runs of numbers, and
+///   strings with escape codes.
+//
+// Arguments:
+//   filename   the file to write
+//   mb         its approximate size
+//
+// Creation:    October 17, 2026
+//
+// Modifications:
+// ****************************************************************************
+static void
+WriteTestFile(const string &filename, int mb)
+{
+    ofstream out(filename.c_str());
+    out << "<?xml version=\"1.0\"?>\n<Object type=\"SessionAttributes\">\n";
+    srand(1);
+    long long target = (long long)mb * 1024 * 1024;
+    for (int op = 0; out.tellp() < target; op++)
+    {
+        out << "  <Object type=\"PipelineAttributes\" name=\"pipe" << op << "\">\n";
+        out << "    <Field name=\"name\" type=\"String\">"
+            << "\"pipe &quot;" << op << "&quot; &lt;a&amp;b&gt; \\t\\x41\"</Field>\n";
+        out << "    <Field name=\"values\" type=\"FloatVector\" length=\"1000\">";
+        for (int i=0; i<1000; i++)
+            out << float(rand()) / float(RAND_MAX) * 1000.f - 500.f << " ";
+        out << "</Field>\n  </Object>\n";
+    }
+    out << "</Object>\n";
+}
+
+// a cheap hash of the token types and text, so the two scanners'
+// outputs can be compared without keeping them
+static void
+AddToken(unsigned long &hash, XMLToken t, const char *s, size_t n)
+{
+    hash = hash * 31 + t;
+    for (size_t i=0; i<n; i++)
+        hash = hash * 31 + (unsigned char)s[i];
+}
+
+int
+main(int argc, char *argv[])
+{
+    string filename = "XMLScanBench.xml";
+    bool generated = true;
+    int mb = 16;
+    if (argc == 3 && string(argv[1]) == "-size")
+        mb = atoi(argv[2]);
+    else if (argc == 2)
+    {
+        filename = argv[1];
+        generated = false;
+    }
+    else if (argc != 1)
+    {
+        cerr << "Usage: " << argv[0] << " [file.xml | -size MB]\n";
+        return 1;
+    }
+    if (generated)
+        WriteTestFile(filename, mb);
+
+    ifstream sizer(filename.c_str(), ios::binary | ios::ate);
+    if (!sizer)
+    {
+        cerr << "Can't open " << filename << endl;
+        return 1;
+    }
+    size_t size = sizer.tellg();
+    sizer.close();
+
+    // the old scanner, reading from a stream
+    clock_t start = clock();
+    unsigned long oldHash = 0;
+    long long oldTokens = 0;
+    {
+        ifstream in(filename.c_str());
+        StreamXMLScanner scanner(in);
+        vector<char> buff(size + 2);
+        XMLToken t;
+        do
+        {
+            t = scanner.GetNextToken(&buff[0]);
+            if (t != TokEOF)
+                AddToken(oldHash, t, &buff[0], strlen(&buff[0]));
+            oldTokens++;
+        }
+        while (t != TokEOF);
+    }
+    double oldTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+    // the new one, from a (mapped) buffer
+    start = clock();
+    unsigned long newHash = 0;
+    long long newTokens = 0;
+    {
+        XMLInputBuffer input;
+        input.SetFromFile(filename);
+        XMLScanner scanner(input.GetData(), input.GetSize());
+        XMLTokenText text;
+        XMLToken t;
+        do
+        {
+            t = scanner.GetNextToken(text);
+            if (t != TokEOF)
+                AddToken(newHash, t, text.begin, text.length);
+            newTokens++;
+        }
+        while (t != TokEOF);
+    }
+    double newTime = double(clock() - start) / CLOCKS_PER_SEC;
+
+    if (generated)
+        remove(filename.c_str());
+
+    bool same = (oldTokens == newTokens && oldHash == newHash);
+    printf("%s: %.1f MB, %lld tokens\n", filename.c_str(),
+           size / (1024. * 1024.), newTokens);
+    printf("  %-8s %10s %10s\n", "scanner", "time (s)", "MB/s");
+    printf("  %-8s %10.3f %10.1f\n", "stream", oldTime,
+           size / (1024. * 1024.) / oldTime);
+    printf("  %-8s %10.3f %10.1f\n", "buffer", newTime,
+           size / (1024. * 1024.) / newTime);
+    printf("  tokens %s\n", same ? "match" : "DIFFER");
+    return same ? 0 : 1;
+}
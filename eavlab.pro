@@ -22,6 +22,8 @@ SOURCES += main.cpp\
     ELPipelineBuilder.cpp \
     ELSources.cpp \
     Attribute.cpp \
+    Batch.cpp \
+    Operation.cpp \
     Pipeline.cpp \
     XMLTools.cpp
 
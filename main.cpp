@@ -1,6 +1,9 @@
 // Copyright 2012-2013 UT-Battelle, LLC.  See LICENSE.txt for more information.
 #include <QtGui/QApplication>
+#include <QDir>
 #include "ELMainWindow.h"
+#include "Pipeline.h"
+#include "Batch.h"
 
 #include <eavlDataSet.h>
 #include <eavlException.h>
@@ -12,6 +15,35 @@ int main(int argc, char *argv[])
     {
         eavlInitializeGPU();
 
+        // memory budget for cached pipeline results
+        if (getenv("EAVLAB_CACHE_MB"))
+        {
+            long long mb = atoi(getenv("EAVLAB_CACHE_MB"));
+            Pipeline::resultCache.SetMaxBytes(mb * 1024LL * 1024LL);
+        }
+
+        // how many files may have an importer open at once
+        if (getenv("EAVLAB_MAX_OPEN_FILES"))
+            Pipeline::importers.SetMaxOpenFiles(atoi(getenv("EAVLAB_MAX_OPEN_FILES")));
+
+        // how many time steps of a series to read ahead in the GUI
+        if (getenv("EAVLAB_PREFETCH_STEPS"))
+            Pipeline::prefetchSteps = atoi(getenv("EAVLAB_PREFETCH_STEPS"));
+
+        // file metadata from earlier runs, so files needn't be rescanned
+        string metadataFile = (QDir::homePath() + "/.eavlab_metadata").toStdString();
+        if (getenv("EAVLAB_METADATA_CACHE"))
+            metadataFile = getenv("EAVLAB_METADATA_CACHE");
+        Pipeline::importers.Load(metadataFile);
+
+        // no GUI; see Batch.h
+        if (argc >= 2 && string(argv[1]) == "-batch")
+        {
+            int result = RunBatch(argc, argv);
+            Pipeline::importers.Save(metadataFile);
+            return result;
+        }
+
         QApplication a(argc, argv);
 
         ELMainWindow w;
@@ -33,7 +65,9 @@ int main(int argc, char *argv[])
 
         w.show();
 
-        return a.exec();
+        int result = a.exec();
+        Pipeline::importers.Save(metadataFile);
+        return result;
     }
     catch (const eavlException &e)
     {